@@ -0,0 +1,42 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Размер блока арены по умолчанию
+#define ARENA_DEFAULT_BLOCK_SIZE 16384
+
+// Блок арены
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;  // Предыдущий заполненный блок
+    size_t size;              // Ёмкость блока
+    size_t used;              // Занято байт
+    max_align_t data[];       // Данные блока
+} ArenaBlock;
+
+// Арена: последовательное выделение, освобождение всего разом
+typedef struct {
+    ArenaBlock* head;         // Текущий блок
+    size_t block_size;        // Размер новых блоков
+} Arena;
+
+// Инициализация арены (block_size = 0 - размер по умолчанию)
+void arena_init(Arena* arena, size_t block_size);
+
+// Выделение памяти с выравниванием max_align_t (память не обнуляется)
+void* arena_alloc(Arena* arena, size_t size);
+
+// Копия строки заданной длины с завершающим нулём
+char* arena_strndup(Arena* arena, const char* text, size_t length);
+
+// Передача всех блоков source в arena (адреса выделенной памяти не меняются,
+// source становится пустой). Текущий блок arena остаётся текущим.
+void arena_adopt(Arena* arena, Arena* source);
+
+// Освобождение всех блоков
+void arena_free(Arena* arena);
+
+#endif // ARENA_H
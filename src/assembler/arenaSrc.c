@@ -0,0 +1,91 @@
+#include "arenaHeader.h"
+
+// Округление размера до выравнивания max_align_t
+static size_t arena_align(size_t size) {
+    size_t alignment = sizeof(max_align_t);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+void arena_init(Arena* arena, size_t block_size) {
+    if (!arena) {
+        return;
+    }
+
+    arena->head = NULL;
+    arena->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    if (!arena) {
+        return NULL;
+    }
+
+    size = arena_align(size ? size : 1);
+
+    ArenaBlock* block = arena->head;
+    if (!block || block->size - block->used < size) {
+        // Крупные запросы получают отдельный блок точного размера
+        size_t capacity = size > arena->block_size ? size : arena->block_size;
+
+        block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + capacity);
+        if (!block) {
+            return NULL;
+        }
+
+        block->size = capacity;
+        block->used = 0;
+        block->next = arena->head;
+        arena->head = block;
+    }
+
+    void* pointer = (unsigned char*)block->data + block->used;
+    block->used += size;
+
+    return pointer;
+}
+
+char* arena_strndup(Arena* arena, const char* text, size_t length) {
+    char* copy = (char*)arena_alloc(arena, length + 1);
+    if (!copy) {
+        return NULL;
+    }
+
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+void arena_adopt(Arena* arena, Arena* source) {
+    if (!arena || !source || !source->head) {
+        return;
+    }
+
+    if (!arena->head) {
+        arena->head = source->head;
+    } else {
+        ArenaBlock* tail = source->head;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        tail->next = arena->head->next;
+        arena->head->next = source->head;
+    }
+
+    source->head = NULL;
+}
+
+void arena_free(Arena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->head = NULL;
+}
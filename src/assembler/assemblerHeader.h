@@ -6,6 +6,10 @@
 #include <string.h>
 #include "parserHeader.h"
 
+// Версия ассемблера; входит в ключ кэша сборки (assemblyCacheHeader.h),
+// поэтому увеличивается при любом изменении генерируемого кода
+#define ASSEMBLER_VERSION "1.1"
+
 typedef enum {
     ASSEMBLER_SUCCESS = 0,              // Успешное выполнение
     ASSEMBLER_ERROR_INVALID_INPUT,      // Неверный входной файл
@@ -17,7 +21,38 @@ typedef enum {
 
 extern const char* AssemblerErrorMessages[ASSEMBLER_ERROR_COUNT];
 
+// Образ программы в памяти: машинный код в формате Big Endian,
+// побайтно совпадающий с содержимым .bin файла
+typedef struct {
+    uint8_t* code;              // Машинный код (владеет буфером)
+    size_t size;                // Размер кода в байтах
+    int instruction_count;      // Количество инструкций
+} ProgramImage;
+
+// Необязательные этапы сборки (нулевая структура - поведение assemble_file)
+typedef struct {
+    int optimize;               // Оптимизирующий проход (peepholeHeader.h)
+    const char* debug_map_filename; // Отладочная карта (debugMapHeader.h), NULL - не писать
+    const char* profile_filename;   // Профиль для раскладки кода (layoutHeader.h), NULL - без раскладки
+} AssemblerOptions;
+
 int assemble_file(const char* input_filename, const char* output_filename);
+int assemble_file_with_options(const char* input_filename, const char* output_filename,
+                               const AssemblerOptions* options);
+
+// Раздельная компиляция: перемещаемый объектный файл вместо .bin (см. objectHeader.h,
+// компоновка - linkerHeader.h)
+int assemble_file_to_object(const char* input_filename, const char* output_filename);
+
+// Ассемблирование исходного текста из памяти без временных файлов и вывода
+// в stdout; ошибки парсера выводятся в stderr. NULL - ошибка ассемблирования.
+ProgramImage* assemble_buffer(const char* source, size_t length);
+ProgramImage* assemble_buffer_with_options(const char* source, size_t length,
+                                           const AssemblerOptions* options);
+void program_image_free(ProgramImage* image);
+
+// Запись образа в .bin файл (ASSEMBLER_ERROR_INVALID_OUTPUT / ASSEMBLER_ERROR_WRITING_FAILED)
+int program_image_write(const ProgramImage* image, const char* filename);
 
 void print_assembler_error(int error_code, const char* custom_message);
 const char* get_file_extension(const char* filename);
@@ -1,5 +1,10 @@
 #include "assemblerHeader.h"
 #include "parserHeader.h"
+#include "parallelParserHeader.h"
+#include "objectHeader.h"
+#include "peepholeHeader.h"
+#include "layoutHeader.h"
+#include "debugMapHeader.h"
 
 const char* AssemblerErrorMessages[ASSEMBLER_ERROR_COUNT] = {
     "Success",                       // ASSEMBLER_SUCCESS
@@ -32,7 +37,92 @@ void print_assembler_error(int error_code, const char* custom_message) {
     }
 }
 
+// Сборка образа программы из результата парсинга (Big Endian, как в .bin файле)
+static ProgramImage* program_image_from_parse_result(const ParseResult* parse_result) {
+    ProgramImage* image = (ProgramImage*)calloc(1, sizeof(ProgramImage));
+    if (!image) {
+        return NULL;
+    }
+    
+    image->instruction_count = parse_result->instruction_count;
+    image->size = (size_t)parse_result->instruction_count * 4;
+    image->code = (uint8_t*)malloc(image->size ? image->size : 1);
+    if (!image->code) {
+        free(image);
+        return NULL;
+    }
+    
+    for (int i = 0; i < parse_result->instruction_count; i++) {
+        uint32_t machine_code = parse_result->instructions[i].machine_code;
+        uint8_t* bytes = &image->code[(size_t)i * 4];
+        
+        bytes[0] = (machine_code >> 24) & 0xFF;
+        bytes[1] = (machine_code >> 16) & 0xFF;
+        bytes[2] = (machine_code >> 8) & 0xFF;
+        bytes[3] = machine_code & 0xFF;
+    }
+    
+    return image;
+}
+
+// Раскладка по профилю (layoutHeader.h)
+static void apply_layout(ParseResult* parse_result, const char* profile_filename, int verbose) {
+    ExecutionProfile profile;
+    int status = profile_read(&profile, profile_filename);
+    
+    if (status != PROFILE_SUCCESS) {
+        fprintf(stderr, "Warning: layout skipped: %s: %s\n", profile_filename, ProfileErrorMessages[status]);
+        return;
+    }
+    
+    LayoutStats stats;
+    int before = parse_result->instruction_count;
+    status = layout_optimize(parse_result, &profile, &stats);
+    profile_free(&profile);
+    
+    if (status != LAYOUT_SUCCESS) {
+        fprintf(stderr, "Warning: layout skipped: %s\n", LayoutErrorMessages[status]);
+    } else if (verbose) {
+        printf("Layout: %d -> %d instructions, %s (blocks %d, chains %d, jumps removed %d, inserted %d), "
+               "profiled %llu -> %llu executed\n",
+               before, parse_result->instruction_count, stats.applied ? "applied" : "kept",
+               stats.blocks, stats.chains, stats.removed_jumps, stats.inserted_jumps,
+               (unsigned long long)stats.instructions_before, (unsigned long long)stats.instructions_after);
+    }
+}
+
+// Необязательные проходы над результатом парсинга; ошибка прохода не прерывает сборку
+static void apply_options(ParseResult* parse_result, const AssemblerOptions* options, int verbose) {
+    if (!options) {
+        return;
+    }
+    
+    if (options->optimize) {
+        PeepholeStats stats;
+        int before = parse_result->instruction_count;
+        int status = peephole_optimize(parse_result, &stats);
+        
+        if (status != PEEPHOLE_SUCCESS) {
+            fprintf(stderr, "Warning: optimization skipped: %s\n", PeepholeErrorMessages[status]);
+        } else if (verbose) {
+            printf("Optimized: %d -> %d instructions (nop %d, pairs %d, constants %d, dead %d, mul->lshft %d)\n",
+                   before, parse_result->instruction_count, stats.removed_nops, stats.removed_pairs,
+                   stats.removed_constants, stats.removed_dead, stats.strength_reduced);
+        }
+    }
+    
+    // После peephole: профиль относится к коду, собранному с тем же optimize
+    if (options->profile_filename) {
+        apply_layout(parse_result, options->profile_filename, verbose);
+    }
+}
+
 int assemble_file(const char* input_filename, const char* output_filename) {
+    return assemble_file_with_options(input_filename, output_filename, NULL);
+}
+
+int assemble_file_with_options(const char* input_filename, const char* output_filename,
+                               const AssemblerOptions* options) {
     // Проверка входных параметров
     if (!input_filename || !output_filename) {
         print_assembler_error(ASSEMBLER_ERROR_INVALID_INPUT, "Null filename provided");
@@ -46,43 +136,141 @@ int assemble_file(const char* input_filename, const char* output_filename) {
         // Это предупреждение, не ошибка
     }
     
-    ParseResult parse_result = parse_file(input_filename);
+    ParseResult* parse_result = parse_file(input_filename);
     
-    if (parse_result.instruction_count <= 0) {
+    if (!parse_result || parse_result->instruction_count <= 0) {
+        parse_result_free(parse_result);
         print_assembler_error(ASSEMBLER_ERROR_PARSER_FAILED, 
                              "Parser did not produce any instructions");
         return ASSEMBLER_ERROR_PARSER_FAILED;
     }
     
-    generate_machine_code_for_all(&parse_result);
-    
-    FILE* output_file = fopen(output_filename, "wb");
-    if (!output_file) {
-        print_assembler_error(ASSEMBLER_ERROR_INVALID_OUTPUT, 
-                             "Failed to open output file for writing");
-        return ASSEMBLER_ERROR_INVALID_OUTPUT;
-    }
+    apply_options(parse_result, options, 1);
     
-    for (int i = 0; i < parse_result.instruction_count; i++) {
-        uint32_t machine_code = parse_result.instructions[i].machine_code;
-        
-        uint8_t bytes[4];
-        bytes[0] = (machine_code >> 24) & 0xFF;
-        bytes[1] = (machine_code >> 16) & 0xFF;
-        bytes[2] = (machine_code >> 8) & 0xFF;
-        bytes[3] = machine_code & 0xFF;
+    // Отладочная карта строится по итоговым адресам (после оптимизации)
+    if (options && options->debug_map_filename) {
+        DebugMap* map = NULL;
+        int map_status = debug_map_from_parse_result(parse_result, input_filename, &map);
+        if (map_status == DEBUG_MAP_SUCCESS) {
+            map_status = debug_map_write(map, options->debug_map_filename);
+        }
+        debug_map_free(map);
         
-        if (fwrite(bytes, sizeof(uint8_t), 4, output_file) != 4) {
-            fclose(output_file);
-            print_assembler_error(ASSEMBLER_ERROR_WRITING_FAILED, 
-                                 "Failed to write machine code to output file");
+        if (map_status != DEBUG_MAP_SUCCESS) {
+            parse_result_free(parse_result);
+            fprintf(stderr, "Failed to write debug map %s: %s\n", options->debug_map_filename,
+                    DebugMapErrorMessages[map_status]);
             return ASSEMBLER_ERROR_WRITING_FAILED;
         }
     }
     
-    fclose(output_file);
+    ProgramImage* image = program_image_from_parse_result(parse_result);
+    int instruction_count = parse_result->instruction_count;
+    parse_result_free(parse_result);
+    
+    if (!image) {
+        print_assembler_error(ASSEMBLER_ERROR_WRITING_FAILED, 
+                             "Failed to allocate program image");
+        return ASSEMBLER_ERROR_WRITING_FAILED;
+    }
+    
+    int write_status = program_image_write(image, output_filename);
+    program_image_free(image);
+    
+    if (write_status == ASSEMBLER_ERROR_INVALID_OUTPUT) {
+        print_assembler_error(write_status, "Failed to open output file for writing");
+        return write_status;
+    }
+    if (write_status != ASSEMBLER_SUCCESS) {
+        print_assembler_error(write_status, "Failed to write machine code to output file");
+        return write_status;
+    }
+    
     printf("Successfully assembled %d instructions to %s\n", 
-           parse_result.instruction_count, output_filename);
+           instruction_count, output_filename);
     
     return ASSEMBLER_SUCCESS;
 }
+
+int assemble_file_to_object(const char* input_filename, const char* output_filename) {
+    if (!input_filename || !output_filename) {
+        print_assembler_error(ASSEMBLER_ERROR_INVALID_INPUT, "Null filename provided");
+        return ASSEMBLER_ERROR_INVALID_INPUT;
+    }
+    
+    SourceBuffer source;
+    if (source_buffer_open_file(&source, input_filename) != 0) {
+        print_assembler_error(ASSEMBLER_ERROR_INVALID_INPUT, "Failed to open input file");
+        return ASSEMBLER_ERROR_INVALID_INPUT;
+    }
+    
+    ObjectFile* object = NULL;
+    int object_status = object_from_source(source.data, source.size, &object);
+    source_buffer_close(&source);
+    
+    if (object_status != OBJECT_SUCCESS) {
+        print_object_error(object_status, "Failed to build object file");
+        return ASSEMBLER_ERROR_PARSER_FAILED;
+    }
+    
+    object_status = object_write(object, output_filename);
+    uint32_t instruction_count = object->instruction_count;
+    object_free(object);
+    
+    if (object_status != OBJECT_SUCCESS) {
+        print_assembler_error(ASSEMBLER_ERROR_WRITING_FAILED, 
+                             "Failed to write object file");
+        return ASSEMBLER_ERROR_WRITING_FAILED;
+    }
+    
+    printf("Successfully assembled %u instructions to object file %s\n", 
+           instruction_count, output_filename);
+    
+    return ASSEMBLER_SUCCESS;
+}
+
+ProgramImage* assemble_buffer(const char* source, size_t length) {
+    return assemble_buffer_with_options(source, length, NULL);
+}
+
+ProgramImage* assemble_buffer_with_options(const char* source, size_t length,
+                                           const AssemblerOptions* options) {
+    if (!source) {
+        return NULL;
+    }
+    
+    ParseResult* parse_result = parse_buffer_parallel(source, length, 0);
+    if (!parse_result) {
+        return NULL;
+    }
+    
+    apply_options(parse_result, options, 0);
+    
+    ProgramImage* image = program_image_from_parse_result(parse_result);
+    parse_result_free(parse_result);
+    
+    return image;
+}
+
+int program_image_write(const ProgramImage* image, const char* filename) {
+    FILE* output_file = fopen(filename, "wb");
+    if (!output_file) {
+        return ASSEMBLER_ERROR_INVALID_OUTPUT;
+    }
+    
+    size_t written = fwrite(image->code, 1, image->size, output_file);
+    if (fclose(output_file) != 0 || written != image->size) {
+        return ASSEMBLER_ERROR_WRITING_FAILED;
+    }
+    
+    return ASSEMBLER_SUCCESS;
+}
+
+void program_image_free(ProgramImage* image) {
+    if (!image) {
+        return;
+    }
+    
+    free(image->code);
+    free(image);
+}
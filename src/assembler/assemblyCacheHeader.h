@@ -0,0 +1,65 @@
+#ifndef ASSEMBLY_CACHE_H
+#define ASSEMBLY_CACHE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "assemblerHeader.h"
+
+// Кэш собранных образов на диске с адресацией по содержимому.
+//
+// Ключ - 128-битный хеш нормализованного потока токенов (без пробелов и
+// комментариев, с границами строк) и ASSEMBLER_VERSION. При попадании
+// парсинг и кодирование пропускаются. Каждый образ хранится в отдельном
+// файле <ключ>.img; при превышении max_bytes удаляются записи, к которым
+// дольше всего не обращались (время изменения обновляется при попадании).
+#define ASSEMBLY_CACHE_PATH_MAX 1024
+#define ASSEMBLY_CACHE_DEFAULT_MAX_BYTES (64u * 1024 * 1024)
+#define ASSEMBLY_CACHE_MAGIC "CPUC"
+#define ASSEMBLY_CACHE_FORMAT_VERSION 1
+#define ASSEMBLY_CACHE_EXTENSION ".img"
+
+// Коды результата операций с кэшем
+typedef enum {
+    ASSEMBLY_CACHE_SUCCESS = 0,
+    ASSEMBLY_CACHE_MISS,             // Записи нет или она повреждена
+    ASSEMBLY_CACHE_ERROR_IO,         // Ошибка работы с каталогом или файлом
+    ASSEMBLY_CACHE_ERROR_NO_MEMORY,  // Не удалось выделить память
+    ASSEMBLY_CACHE_ERROR_TOKENIZE,   // Исходный текст не токенизируется
+    ASSEMBLY_CACHE_ERROR_COUNT       // Количество кодов ошибок (всегда последний)
+} AssemblyCacheStatus;
+
+extern const char* AssemblyCacheMessages[ASSEMBLY_CACHE_ERROR_COUNT];
+
+typedef struct {
+    uint64_t hash[2];
+} AssemblyCacheKey;
+
+typedef struct {
+    char directory[ASSEMBLY_CACHE_PATH_MAX];
+    uint64_t max_bytes;              // Ограничение суммарного размера записей
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} AssemblyCache;
+
+// Открытие кэша (каталог создаётся при необходимости); max_bytes = 0 - по умолчанию
+int assembly_cache_open(AssemblyCache* cache, const char* directory, uint64_t max_bytes);
+
+// Ключ исходного текста
+int assembly_cache_key(const char* source, size_t size, AssemblyCacheKey* key);
+
+// Поиск образа (ASSEMBLY_CACHE_MISS - нет записи) и сохранение с вытеснением
+int assembly_cache_lookup(AssemblyCache* cache, const AssemblyCacheKey* key, ProgramImage** image);
+int assembly_cache_store(AssemblyCache* cache, const AssemblyCacheKey* key, const ProgramImage* image);
+
+// Удаление самых старых записей, пока суммарный размер превышает max_bytes
+int assembly_cache_evict(AssemblyCache* cache);
+
+// Ассемблирование через кэш. Ошибки кэша не прерывают сборку: образ
+// собирается заново, как assemble_buffer / assemble_file.
+ProgramImage* assemble_buffer_cached(AssemblyCache* cache, const char* source, size_t length);
+int assemble_file_cached(AssemblyCache* cache, const char* input_filename, const char* output_filename);
+
+#endif // ASSEMBLY_CACHE_H
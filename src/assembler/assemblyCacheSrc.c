@@ -0,0 +1,369 @@
+#include "assemblyCacheHeader.h"
+#include "parserHeader.h"
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+const char* AssemblyCacheMessages[ASSEMBLY_CACHE_ERROR_COUNT] = {
+    "Success",                       // ASSEMBLY_CACHE_SUCCESS
+    "Cache miss",                    // ASSEMBLY_CACHE_MISS
+    "Cache input/output error",      // ASSEMBLY_CACHE_ERROR_IO
+    "Out of memory",                 // ASSEMBLY_CACHE_ERROR_NO_MEMORY
+    "Source cannot be tokenized"     // ASSEMBLY_CACHE_ERROR_TOKENIZE
+};
+
+#define ENTRY_HEADER_SIZE 28         // Магия, версия формата, ключ, число инструкций
+#define KEY_HEX_LENGTH 32
+#define ENTRY_PATH_SIZE (ASSEMBLY_CACHE_PATH_MAX + 256 + 2)  // Каталог, '/', имя из readdir
+
+int assembly_cache_open(AssemblyCache* cache, const char* directory, uint64_t max_bytes) {
+    if (!cache || !directory || strlen(directory) >= ASSEMBLY_CACHE_PATH_MAX) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    memset(cache, 0, sizeof(AssemblyCache));
+    strcpy(cache->directory, directory);
+    cache->max_bytes = max_bytes ? max_bytes : ASSEMBLY_CACHE_DEFAULT_MAX_BYTES;
+
+    struct stat info;
+    if (mkdir(directory, 0777) != 0 && errno != EEXIST) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+    if (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    return ASSEMBLY_CACHE_SUCCESS;
+}
+
+// Две независимые 64-битные полосы: FNV-1a и мультипликативная с перемешиванием
+static void key_update(AssemblyCacheKey* key, const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t a = key->hash[0];
+    uint64_t b = key->hash[1];
+
+    for (size_t i = 0; i < length; i++) {
+        a = (a ^ bytes[i]) * 0x100000001B3ull;
+        b = (b + bytes[i] + 1) * 0x9E3779B97F4A7C15ull;
+        b ^= b >> 29;
+    }
+
+    key->hash[0] = a;
+    key->hash[1] = b;
+}
+
+static void key_update_u32(AssemblyCacheKey* key, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+    key_update(key, bytes, sizeof(bytes));
+}
+
+int assembly_cache_key(const char* source, size_t size, AssemblyCacheKey* key) {
+    if (!source || !key) {
+        return ASSEMBLY_CACHE_ERROR_TOKENIZE;
+    }
+
+    key->hash[0] = 0xCBF29CE484222325ull;
+    key->hash[1] = 0x243F6A8885A308D3ull;
+    key_update(key, ASSEMBLER_VERSION, sizeof(ASSEMBLER_VERSION));
+
+    // Токены записываются как (тип, длина, текст), непустые строки завершаются TOKEN_EOF:
+    // пробелы и комментарии на ключ не влияют, границы инструкций - влияют
+    Lexer lexer;
+    TokenizationResult tokens = {0};
+    const char* line;
+    size_t line_length;
+    size_t line_offset;
+    int status = ASSEMBLY_CACHE_SUCCESS;
+
+    lexer_init(&lexer, source, size);
+    while (lexer_next_line(&lexer, &line, &line_length, &line_offset)) {
+        if (tokenize_line(&tokens, line, line_length, lexer.line_number, (uint32_t)line_offset) != PARSER_SUCCESS) {
+            status = ASSEMBLY_CACHE_ERROR_TOKENIZE;
+            break;
+        }
+        if (tokens.token_count == 0) {
+            continue;
+        }
+
+        for (int i = 0; i < tokens.token_count; i++) {
+            const Token* token = &tokens.tokens[i];
+            key_update_u32(key, (uint32_t)token->type);
+            key_update_u32(key, token->length);
+            key_update(key, token->text, token->length);
+        }
+        key_update_u32(key, TOKEN_EOF);
+    }
+
+    tokenization_result_free(&tokens);
+    return status;
+}
+
+static void key_to_hex(const AssemblyCacheKey* key, char hex[KEY_HEX_LENGTH + 1]) {
+    snprintf(hex, KEY_HEX_LENGTH + 1, "%016llx%016llx",
+             (unsigned long long)key->hash[0], (unsigned long long)key->hash[1]);
+}
+
+static void entry_path(const AssemblyCache* cache, const AssemblyCacheKey* key, char* path) {
+    char hex[KEY_HEX_LENGTH + 1];
+    key_to_hex(key, hex);
+    snprintf(path, ENTRY_PATH_SIZE, "%s/%s%s", cache->directory, hex, ASSEMBLY_CACHE_EXTENSION);
+}
+
+// Заголовок записи: "CPUC", u32 версия формата, ключ, u32 число инструкций (Big Endian)
+static void entry_header(const AssemblyCacheKey* key, uint32_t instruction_count, uint8_t* header) {
+    uint32_t words[6] = {
+        ASSEMBLY_CACHE_FORMAT_VERSION,
+        (uint32_t)(key->hash[0] >> 32), (uint32_t)key->hash[0],
+        (uint32_t)(key->hash[1] >> 32), (uint32_t)key->hash[1],
+        instruction_count
+    };
+
+    memcpy(header, ASSEMBLY_CACHE_MAGIC, 4);
+    for (int i = 0; i < 6; i++) {
+        uint8_t* p = header + 4 + i * 4;
+        p[0] = (uint8_t)(words[i] >> 24);
+        p[1] = (uint8_t)(words[i] >> 16);
+        p[2] = (uint8_t)(words[i] >> 8);
+        p[3] = (uint8_t)words[i];
+    }
+}
+
+int assembly_cache_lookup(AssemblyCache* cache, const AssemblyCacheKey* key, ProgramImage** out_image) {
+    if (!cache || !key || !out_image) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+    *out_image = NULL;
+
+    char path[ENTRY_PATH_SIZE];
+    entry_path(cache, key, path);
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        cache->misses++;
+        return ASSEMBLY_CACHE_MISS;
+    }
+
+    uint8_t header[ENTRY_HEADER_SIZE];
+    uint8_t expected[ENTRY_HEADER_SIZE];
+    int status = ASSEMBLY_CACHE_MISS;
+    ProgramImage* image = NULL;
+
+    if (fread(header, 1, sizeof(header), file) == sizeof(header)) {
+        uint32_t instruction_count = ((uint32_t)header[24] << 24) | ((uint32_t)header[25] << 16) |
+                                     ((uint32_t)header[26] << 8) | header[27];
+        entry_header(key, instruction_count, expected);
+
+        // Повреждённая или чужая запись считается промахом
+        if (memcmp(header, expected, sizeof(header)) == 0 && instruction_count > 0 &&
+            instruction_count <= MAX_PROGRAM_INSTRUCTIONS) {
+            image = (ProgramImage*)calloc(1, sizeof(ProgramImage));
+            if (image) {
+                image->instruction_count = (int)instruction_count;
+                image->size = (size_t)instruction_count * 4;
+                image->code = (uint8_t*)malloc(image->size);
+            }
+
+            if (!image || !image->code) {
+                status = ASSEMBLY_CACHE_ERROR_NO_MEMORY;
+            } else if (fread(image->code, 1, image->size, file) == image->size && fgetc(file) == EOF) {
+                status = ASSEMBLY_CACHE_SUCCESS;
+            }
+        }
+    }
+    fclose(file);
+
+    if (status != ASSEMBLY_CACHE_SUCCESS) {
+        program_image_free(image);
+        cache->misses++;
+        return status;
+    }
+
+    utime(path, NULL);  // Отметка использования для вытеснения
+    cache->hits++;
+    *out_image = image;
+    return ASSEMBLY_CACHE_SUCCESS;
+}
+
+int assembly_cache_store(AssemblyCache* cache, const AssemblyCacheKey* key, const ProgramImage* image) {
+    if (!cache || !key || !image || image->instruction_count <= 0) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    char path[ENTRY_PATH_SIZE];
+    char temp_path[ENTRY_PATH_SIZE + 32];
+    entry_path(cache, key, path);
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp.%ld", path, (long)getpid());
+
+    uint8_t header[ENTRY_HEADER_SIZE];
+    entry_header(key, (uint32_t)image->instruction_count, header);
+
+    // Запись во временный файл и атомарная замена: параллельные сборки
+    // не видят недописанных записей
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    int written = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                  fwrite(image->code, 1, image->size, file) == image->size;
+    int close_result = fclose(file);
+
+    if (!written || close_result != 0 || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    return assembly_cache_evict(cache);
+}
+
+typedef struct {
+    char name[KEY_HEX_LENGTH + sizeof(ASSEMBLY_CACHE_EXTENSION)];
+    time_t mtime;
+    uint64_t size;
+} CacheEntry;
+
+static int compare_entries_by_age(const void* left, const void* right) {
+    const CacheEntry* a = (const CacheEntry*)left;
+    const CacheEntry* b = (const CacheEntry*)right;
+    return (a->mtime > b->mtime) - (a->mtime < b->mtime);
+}
+
+// Имя файла записи: 32 шестнадцатеричные цифры и расширение
+static int is_entry_name(const char* name) {
+    size_t extension_length = strlen(ASSEMBLY_CACHE_EXTENSION);
+    if (strlen(name) != KEY_HEX_LENGTH + extension_length ||
+        strcmp(name + KEY_HEX_LENGTH, ASSEMBLY_CACHE_EXTENSION) != 0) {
+        return 0;
+    }
+    for (int i = 0; i < KEY_HEX_LENGTH; i++) {
+        if (!isxdigit((unsigned char)name[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int assembly_cache_evict(AssemblyCache* cache) {
+    if (!cache) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    DIR* directory = opendir(cache->directory);
+    if (!directory) {
+        return ASSEMBLY_CACHE_ERROR_IO;
+    }
+
+    CacheEntry* entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    uint64_t total = 0;
+    int status = ASSEMBLY_CACHE_SUCCESS;
+    struct dirent* item;
+
+    while ((item = readdir(directory)) != NULL) {
+        char path[ENTRY_PATH_SIZE];
+        struct stat info;
+
+        if (!is_entry_name(item->d_name)) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", cache->directory, item->d_name);
+        if (stat(path, &info) != 0) {
+            continue;  // Запись удалена другим процессом
+        }
+
+        if (count == capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : 64;
+            CacheEntry* grown = (CacheEntry*)realloc(entries, new_capacity * sizeof(CacheEntry));
+            if (!grown) {
+                status = ASSEMBLY_CACHE_ERROR_NO_MEMORY;
+                break;
+            }
+            entries = grown;
+            capacity = new_capacity;
+        }
+
+        strcpy(entries[count].name, item->d_name);
+        entries[count].mtime = info.st_mtime;
+        entries[count].size = (uint64_t)info.st_size;
+        total += entries[count].size;
+        count++;
+    }
+    closedir(directory);
+
+    if (status == ASSEMBLY_CACHE_SUCCESS && total > cache->max_bytes) {
+        qsort(entries, count, sizeof(CacheEntry), compare_entries_by_age);
+
+        for (size_t i = 0; i < count && total > cache->max_bytes; i++) {
+            char path[ENTRY_PATH_SIZE];
+            snprintf(path, sizeof(path), "%s/%s", cache->directory, entries[i].name);
+            if (remove(path) == 0) {
+                total -= entries[i].size;
+                cache->evictions++;
+            }
+        }
+    }
+
+    free(entries);
+    return status;
+}
+
+ProgramImage* assemble_buffer_cached(AssemblyCache* cache, const char* source, size_t length) {
+    if (!cache) {
+        return assemble_buffer(source, length);
+    }
+
+    AssemblyCacheKey key;
+    int has_key = assembly_cache_key(source, length, &key) == ASSEMBLY_CACHE_SUCCESS;
+    ProgramImage* image = NULL;
+
+    if (has_key && assembly_cache_lookup(cache, &key, &image) == ASSEMBLY_CACHE_SUCCESS) {
+        return image;
+    }
+
+    image = assemble_buffer(source, length);
+    if (image && has_key && image->instruction_count > 0) {
+        assembly_cache_store(cache, &key, image);
+    }
+
+    return image;
+}
+
+int assemble_file_cached(AssemblyCache* cache, const char* input_filename, const char* output_filename) {
+    if (!input_filename || !output_filename) {
+        print_assembler_error(ASSEMBLER_ERROR_INVALID_INPUT, "Null filename provided");
+        return ASSEMBLER_ERROR_INVALID_INPUT;
+    }
+
+    SourceBuffer source;
+    if (source_buffer_open_file(&source, input_filename) != 0) {
+        print_assembler_error(ASSEMBLER_ERROR_INVALID_INPUT, "Failed to open input file");
+        return ASSEMBLER_ERROR_INVALID_INPUT;
+    }
+
+    uint64_t hits = cache ? cache->hits : 0;
+    ProgramImage* image = assemble_buffer_cached(cache, source.data, source.size);
+    source_buffer_close(&source);
+
+    if (!image || image->instruction_count <= 0) {
+        program_image_free(image);
+        print_assembler_error(ASSEMBLER_ERROR_PARSER_FAILED,
+                             "Parser did not produce any instructions");
+        return ASSEMBLER_ERROR_PARSER_FAILED;
+    }
+
+    int status = program_image_write(image, output_filename);
+    if (status != ASSEMBLER_SUCCESS) {
+        program_image_free(image);
+        print_assembler_error(status, "Failed to write machine code to output file");
+        return status;
+    }
+
+    printf("Successfully assembled %d instructions to %s%s\n", image->instruction_count, output_filename,
+           cache && cache->hits != hits ? " (cached)" : "");
+    program_image_free(image);
+
+    return ASSEMBLER_SUCCESS;
+}
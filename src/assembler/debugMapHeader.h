@@ -0,0 +1,77 @@
+#ifndef DEBUG_MAP_H
+#define DEBUG_MAP_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parserHeader.h"
+
+// Отладочная карта программы: адрес -> файл:строка и метка -> адрес.
+// Пишется ассемблером рядом с .bin и читается эмулятором и профилировщиками
+// без повторного парсинга исходного текста.
+//
+// Формат файла (все числа Big Endian):
+//   заголовок: "CPUD", u16 версия, u16 резерв, u32 число инструкций,
+//              u32 число меток, u32 число файлов, u32 размер таблицы строк
+//   файлы:     u32 смещение имени
+//   строки:    для инструкции i (адрес 4*i) - u32 строка, u16 файл, u16 резерв
+//   метки:     u32 смещение имени, u32 хеш имени, u16 адрес, u16 резерв;
+//              отсортированы по (хеш, имя) - поиск по имени двоичный
+//   индекс:    u32 номера меток в порядке адресов - поиск метки по адресу
+//   строки:    имена, завершённые нулём
+#define DEBUG_MAP_MAGIC "CPUD"
+#define DEBUG_MAP_VERSION 1
+#define DEBUG_MAP_HEADER_SIZE 24
+#define DEBUG_MAP_LINE_SIZE 8
+#define DEBUG_MAP_LABEL_SIZE 12
+
+// Коды ошибок отладочной карты
+typedef enum {
+    DEBUG_MAP_SUCCESS = 0,
+    DEBUG_MAP_ERROR_IO,              // Ошибка чтения или записи файла
+    DEBUG_MAP_ERROR_BAD_FORMAT,      // Файл не является отладочной картой
+    DEBUG_MAP_ERROR_NO_MEMORY,       // Не удалось выделить память
+    DEBUG_MAP_ERROR_NOT_FOUND,       // Адрес или метка отсутствуют в карте
+    DEBUG_MAP_ERROR_COUNT            // Количество кодов ошибок (всегда последний)
+} DebugMapErrorCode;
+
+extern const char* DebugMapErrorMessages[DEBUG_MAP_ERROR_COUNT];
+
+typedef struct {
+    const char* name;                // Указывает в таблицу строк карты
+    uint32_t hash;                   // symbol_hash(name)
+    uint16_t address;
+} DebugMapLabel;
+
+typedef struct DebugMap {
+    uint32_t instruction_count;
+    uint32_t* lines;                 // Строка инструкции i (0 - неизвестна)
+    uint16_t* files;                 // Файл инструкции i
+    uint32_t file_count;
+    const char** file_names;
+    uint32_t label_count;
+    DebugMapLabel* labels;           // По (хеш, имя)
+    uint32_t* labels_by_address;     // Номера меток по возрастанию адреса
+    char* strings;
+    uint32_t strings_size;
+} DebugMap;
+
+// Построение карты по результату парсинга (после оптимизации - по итоговым адресам)
+int debug_map_from_parse_result(const ParseResult* result, const char* source_name, DebugMap** map);
+
+int debug_map_write(const DebugMap* map, const char* filename);
+int debug_map_read(const char* filename, DebugMap** map);
+void debug_map_free(DebugMap* map);
+
+// Поиск строки по адресу и адреса по имени метки
+int debug_map_lookup_address(const DebugMap* map, uint16_t address, const char** file, uint32_t* line);
+int debug_map_find_label(const DebugMap* map, const char* name, uint16_t* address);
+
+// Ближайшая метка с адресом <= address (NULL - нет)
+const DebugMapLabel* debug_map_symbolize(const DebugMap* map, uint16_t address);
+
+// Текст "файл:строка (метка+смещение)" для сообщений и трасс; возвращает длину (как snprintf)
+int debug_map_format_location(const DebugMap* map, uint16_t address, char* buffer, size_t size);
+
+#endif // DEBUG_MAP_H
@@ -0,0 +1,420 @@
+#include "debugMapHeader.h"
+
+const char* DebugMapErrorMessages[DEBUG_MAP_ERROR_COUNT] = {
+    "Success",                       // DEBUG_MAP_SUCCESS
+    "Input/output error",            // DEBUG_MAP_ERROR_IO
+    "Invalid debug map format",      // DEBUG_MAP_ERROR_BAD_FORMAT
+    "Out of memory",                 // DEBUG_MAP_ERROR_NO_MEMORY
+    "Not found"                      // DEBUG_MAP_ERROR_NOT_FOUND
+};
+
+static DebugMap* debug_map_create(uint32_t instruction_count, uint32_t file_count, uint32_t label_count,
+                                  uint32_t strings_size) {
+    DebugMap* map = (DebugMap*)calloc(1, sizeof(DebugMap));
+    if (!map) {
+        return NULL;
+    }
+
+    map->lines = (uint32_t*)calloc(instruction_count + 1, sizeof(uint32_t));
+    map->files = (uint16_t*)calloc(instruction_count + 1, sizeof(uint16_t));
+    map->file_names = (const char**)calloc(file_count + 1, sizeof(const char*));
+    map->labels = (DebugMapLabel*)calloc(label_count + 1, sizeof(DebugMapLabel));
+    map->labels_by_address = (uint32_t*)calloc(label_count + 1, sizeof(uint32_t));
+    map->strings = (char*)malloc(strings_size + 1);
+    if (!map->lines || !map->files || !map->file_names || !map->labels ||
+        !map->labels_by_address || !map->strings) {
+        debug_map_free(map);
+        return NULL;
+    }
+
+    map->instruction_count = instruction_count;
+    map->file_count = file_count;
+    map->label_count = label_count;
+    map->strings_size = strings_size;
+    return map;
+}
+
+void debug_map_free(DebugMap* map) {
+    if (!map) {
+        return;
+    }
+
+    free(map->lines);
+    free(map->files);
+    free(map->file_names);
+    free(map->labels);
+    free(map->labels_by_address);
+    free(map->strings);
+    free(map);
+}
+
+static int compare_labels_by_name(const void* left, const void* right) {
+    const DebugMapLabel* a = (const DebugMapLabel*)left;
+    const DebugMapLabel* b = (const DebugMapLabel*)right;
+
+    if (a->hash != b->hash) {
+        return a->hash < b->hash ? -1 : 1;
+    }
+    return strcmp(a->name, b->name);
+}
+
+typedef struct {
+    uint16_t address;
+    uint32_t index;
+} AddressKey;
+
+static int compare_address_keys(const void* left, const void* right) {
+    const AddressKey* a = (const AddressKey*)left;
+    const AddressKey* b = (const AddressKey*)right;
+
+    if (a->address != b->address) {
+        return a->address < b->address ? -1 : 1;
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+// Индекс меток по адресу
+static int build_address_index(DebugMap* map) {
+    AddressKey* keys = (AddressKey*)malloc((map->label_count + 1) * sizeof(AddressKey));
+    if (!keys) {
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < map->label_count; i++) {
+        keys[i].address = map->labels[i].address;
+        keys[i].index = i;
+    }
+    qsort(keys, map->label_count, sizeof(AddressKey), compare_address_keys);
+
+    for (uint32_t i = 0; i < map->label_count; i++) {
+        map->labels_by_address[i] = keys[i].index;
+    }
+
+    free(keys);
+    return DEBUG_MAP_SUCCESS;
+}
+
+int debug_map_from_parse_result(const ParseResult* result, const char* source_name, DebugMap** out_map) {
+    if (!result || !out_map) {
+        return DEBUG_MAP_ERROR_IO;
+    }
+    *out_map = NULL;
+
+    if (!source_name) {
+        source_name = "";
+    }
+
+    size_t strings_size = strlen(source_name) + 1;
+    for (int i = 0; i < result->labels.count; i++) {
+        strings_size += result->labels.labels[i].name_length + 1;
+    }
+    if (strings_size > UINT32_MAX) {
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    DebugMap* map = debug_map_create((uint32_t)result->instruction_count, 1, (uint32_t)result->labels.count,
+                                     (uint32_t)strings_size);
+    if (!map) {
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    for (int i = 0; i < result->instruction_count; i++) {
+        map->lines[i] = result->instructions[i].line_number > 0 ? (uint32_t)result->instructions[i].line_number : 0;
+        map->files[i] = 0;
+    }
+
+    char* p = map->strings;
+    size_t length = strlen(source_name) + 1;
+    memcpy(p, source_name, length);
+    map->file_names[0] = p;
+    p += length;
+
+    for (int i = 0; i < result->labels.count; i++) {
+        const Label* label = &result->labels.labels[i];
+
+        memcpy(p, label->name, label->name_length);
+        p[label->name_length] = '\0';
+        map->labels[i].name = p;
+        map->labels[i].hash = label->hash;
+        map->labels[i].address = label->address;
+        p += label->name_length + 1;
+    }
+
+    qsort(map->labels, map->label_count, sizeof(DebugMapLabel), compare_labels_by_name);
+
+    if (build_address_index(map) != DEBUG_MAP_SUCCESS) {
+        debug_map_free(map);
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    *out_map = map;
+    return DEBUG_MAP_SUCCESS;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    p[0] = (value >> 24) & 0xFF;
+    p[1] = (value >> 16) & 0xFF;
+    p[2] = (value >> 8) & 0xFF;
+    p[3] = value & 0xFF;
+    return p + 4;
+}
+
+static uint8_t* put_u16(uint8_t* p, uint16_t value) {
+    p[0] = (value >> 8) & 0xFF;
+    p[1] = value & 0xFF;
+    return p + 2;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t string_offset(const DebugMap* map, const char* name) {
+    return (uint32_t)(name - map->strings);
+}
+
+int debug_map_write(const DebugMap* map, const char* filename) {
+    if (!map || !filename) {
+        return DEBUG_MAP_ERROR_IO;
+    }
+
+    size_t size = DEBUG_MAP_HEADER_SIZE + (size_t)map->file_count * 4 +
+                  (size_t)map->instruction_count * DEBUG_MAP_LINE_SIZE +
+                  (size_t)map->label_count * (DEBUG_MAP_LABEL_SIZE + 4) + map->strings_size;
+    uint8_t* buffer = (uint8_t*)calloc(1, size);
+    if (!buffer) {
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    uint8_t* p = buffer;
+    memcpy(p, DEBUG_MAP_MAGIC, 4);
+    p = put_u16(p + 4, DEBUG_MAP_VERSION);
+    p = put_u16(p, 0);
+    p = put_u32(p, map->instruction_count);
+    p = put_u32(p, map->label_count);
+    p = put_u32(p, map->file_count);
+    p = put_u32(p, map->strings_size);
+
+    for (uint32_t i = 0; i < map->file_count; i++) {
+        p = put_u32(p, string_offset(map, map->file_names[i]));
+    }
+
+    for (uint32_t i = 0; i < map->instruction_count; i++) {
+        p = put_u32(p, map->lines[i]);
+        p = put_u16(p, map->files[i]);
+        p = put_u16(p, 0);
+    }
+
+    for (uint32_t i = 0; i < map->label_count; i++) {
+        p = put_u32(p, string_offset(map, map->labels[i].name));
+        p = put_u32(p, map->labels[i].hash);
+        p = put_u16(p, map->labels[i].address);
+        p = put_u16(p, 0);
+    }
+
+    for (uint32_t i = 0; i < map->label_count; i++) {
+        p = put_u32(p, map->labels_by_address[i]);
+    }
+
+    memcpy(p, map->strings, map->strings_size);
+
+    int status = DEBUG_MAP_SUCCESS;
+    FILE* file = fopen(filename, "wb");
+    if (!file || fwrite(buffer, 1, size, file) != size) {
+        status = DEBUG_MAP_ERROR_IO;
+    }
+    if (file && fclose(file) != 0) {
+        status = DEBUG_MAP_ERROR_IO;
+    }
+
+    free(buffer);
+    return status;
+}
+
+// Имя по смещению в таблице строк (NULL - смещение или завершающий ноль вне таблицы)
+static const char* decode_string(const DebugMap* map, uint32_t offset) {
+    if (offset >= map->strings_size || !memchr(map->strings + offset, '\0', map->strings_size - offset)) {
+        return NULL;
+    }
+    return map->strings + offset;
+}
+
+static int debug_map_decode(const uint8_t* data, size_t size, DebugMap** out_map) {
+    if (size < DEBUG_MAP_HEADER_SIZE || memcmp(data, DEBUG_MAP_MAGIC, 4) != 0 ||
+        get_u16(data + 4) != DEBUG_MAP_VERSION) {
+        return DEBUG_MAP_ERROR_BAD_FORMAT;
+    }
+
+    uint32_t instruction_count = get_u32(data + 8);
+    uint32_t label_count = get_u32(data + 12);
+    uint32_t file_count = get_u32(data + 16);
+    uint32_t strings_size = get_u32(data + 20);
+
+    uint64_t expected = DEBUG_MAP_HEADER_SIZE + (uint64_t)file_count * 4 +
+                        (uint64_t)instruction_count * DEBUG_MAP_LINE_SIZE +
+                        (uint64_t)label_count * (DEBUG_MAP_LABEL_SIZE + 4) + strings_size;
+    if (expected != size || instruction_count > MAX_PROGRAM_INSTRUCTIONS || file_count > UINT16_MAX + 1u) {
+        return DEBUG_MAP_ERROR_BAD_FORMAT;
+    }
+
+    DebugMap* map = debug_map_create(instruction_count, file_count, label_count, strings_size);
+    if (!map) {
+        return DEBUG_MAP_ERROR_NO_MEMORY;
+    }
+
+    memcpy(map->strings, data + size - strings_size, strings_size);
+    map->strings[strings_size] = '\0';
+
+    const uint8_t* p = data + DEBUG_MAP_HEADER_SIZE;
+    int status = DEBUG_MAP_SUCCESS;
+
+    for (uint32_t i = 0; i < file_count && status == DEBUG_MAP_SUCCESS; i++, p += 4) {
+        map->file_names[i] = decode_string(map, get_u32(p));
+        if (!map->file_names[i]) {
+            status = DEBUG_MAP_ERROR_BAD_FORMAT;
+        }
+    }
+
+    for (uint32_t i = 0; i < instruction_count && status == DEBUG_MAP_SUCCESS; i++, p += DEBUG_MAP_LINE_SIZE) {
+        map->lines[i] = get_u32(p);
+        map->files[i] = get_u16(p + 4);
+        if (map->files[i] >= file_count) {
+            status = DEBUG_MAP_ERROR_BAD_FORMAT;
+        }
+    }
+
+    for (uint32_t i = 0; i < label_count && status == DEBUG_MAP_SUCCESS; i++, p += DEBUG_MAP_LABEL_SIZE) {
+        map->labels[i].name = decode_string(map, get_u32(p));
+        map->labels[i].hash = get_u32(p + 4);
+        map->labels[i].address = get_u16(p + 8);
+        if (!map->labels[i].name) {
+            status = DEBUG_MAP_ERROR_BAD_FORMAT;
+        }
+    }
+
+    for (uint32_t i = 0; i < label_count && status == DEBUG_MAP_SUCCESS; i++, p += 4) {
+        map->labels_by_address[i] = get_u32(p);
+        if (map->labels_by_address[i] >= label_count) {
+            status = DEBUG_MAP_ERROR_BAD_FORMAT;
+        }
+    }
+
+    if (status != DEBUG_MAP_SUCCESS) {
+        debug_map_free(map);
+        return status;
+    }
+
+    *out_map = map;
+    return DEBUG_MAP_SUCCESS;
+}
+
+int debug_map_read(const char* filename, DebugMap** out_map) {
+    if (!filename || !out_map) {
+        return DEBUG_MAP_ERROR_IO;
+    }
+    *out_map = NULL;
+
+    SourceBuffer buffer;
+    if (source_buffer_open_file(&buffer, filename) != 0) {
+        return DEBUG_MAP_ERROR_IO;
+    }
+
+    int status = debug_map_decode((const uint8_t*)buffer.data, buffer.size, out_map);
+    source_buffer_close(&buffer);
+
+    return status;
+}
+
+int debug_map_lookup_address(const DebugMap* map, uint16_t address, const char** file, uint32_t* line) {
+    uint32_t index = address / 4u;
+    if (!map || address % 4 != 0 || index >= map->instruction_count || map->lines[index] == 0) {
+        return DEBUG_MAP_ERROR_NOT_FOUND;
+    }
+
+    if (file) {
+        *file = map->file_names[map->files[index]];
+    }
+    if (line) {
+        *line = map->lines[index];
+    }
+    return DEBUG_MAP_SUCCESS;
+}
+
+int debug_map_find_label(const DebugMap* map, const char* name, uint16_t* address) {
+    if (!map || !name) {
+        return DEBUG_MAP_ERROR_NOT_FOUND;
+    }
+
+    uint32_t hash = symbol_hash(name, strlen(name));
+    uint32_t low = 0;
+    uint32_t high = map->label_count;
+
+    // Первая метка с хешем >= hash
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (map->labels[middle].hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (uint32_t i = low; i < map->label_count && map->labels[i].hash == hash; i++) {
+        if (strcmp(map->labels[i].name, name) == 0) {
+            if (address) {
+                *address = map->labels[i].address;
+            }
+            return DEBUG_MAP_SUCCESS;
+        }
+    }
+
+    return DEBUG_MAP_ERROR_NOT_FOUND;
+}
+
+const DebugMapLabel* debug_map_symbolize(const DebugMap* map, uint16_t address) {
+    if (!map || map->label_count == 0) {
+        return NULL;
+    }
+
+    // Число меток с адресом <= address
+    uint32_t low = 0;
+    uint32_t high = map->label_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (map->labels[map->labels_by_address[middle]].address <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low > 0 ? &map->labels[map->labels_by_address[low - 1]] : NULL;
+}
+
+int debug_map_format_location(const DebugMap* map, uint16_t address, char* buffer, size_t size) {
+    const char* file = NULL;
+    uint32_t line = 0;
+    int written;
+
+    if (debug_map_lookup_address(map, address, &file, &line) == DEBUG_MAP_SUCCESS) {
+        written = snprintf(buffer, size, "%s:%u", file, line);
+    } else {
+        written = snprintf(buffer, size, "0x%04X", address);
+    }
+
+    const DebugMapLabel* label = debug_map_symbolize(map, address);
+    if (label && written >= 0) {
+        size_t used = (size_t)written < size ? (size_t)written : size;
+        int extra = address == label->address
+            ? snprintf(buffer ? buffer + used : NULL, size - used, " (%s)", label->name)
+            : snprintf(buffer ? buffer + used : NULL, size - used, " (%s+%u)", label->name,
+                       (unsigned)(address - label->address));
+        written = extra >= 0 ? written + extra : extra;
+    }
+
+    return written;
+}
@@ -0,0 +1,45 @@
+#ifndef FLOW_ANALYSIS_H
+#define FLOW_ANALYSIS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parserHeader.h"
+
+// Граф переходов и живые регистры программы после парсинга (все метки разрешены).
+// Используется оптимизирующими проходами ассемблера (peepholeHeader.h, layoutHeader.h).
+//
+// Регистры после ready и при выходе за конец программы считаются наблюдаемыми:
+// ready читает все регистры.
+#define FLOW_ALL_REGISTERS 0xFFFFu
+
+// Коды результата
+typedef enum {
+    FLOW_SUCCESS = 0,
+    FLOW_ERROR_NO_MEMORY,            // Не удалось выделить память
+    FLOW_ERROR_UNSAFE_TARGET,        // Цель bnz не является инструкцией программы
+    FLOW_ERROR_COUNT                 // Количество кодов ошибок (всегда последний)
+} FlowErrorCode;
+
+typedef struct {
+    const ParseResult* result;
+    int count;
+    uint32_t* reads;                 // Читаемые регистры (маски)
+    uint32_t* writes;                // Записываемые регистры
+    uint32_t* live_in;               // Живые регистры до инструкции
+    uint32_t* live_out;              // Живые регистры после инструкции
+    int* target_index;               // Индекс цели bnz (count - конец программы), -1 - не bnz
+    uint8_t* leader;                 // Инструкция - цель перехода
+} FlowAnalysis;
+
+// Маски регистров, цели переходов и живые регистры
+int flow_analysis_build(FlowAnalysis* flow, const ParseResult* result);
+void flow_analysis_free(FlowAnalysis* flow);
+
+// Пересчёт масок инструкции после её изменения (живые регистры не пересчитываются)
+void flow_analysis_update_usage(FlowAnalysis* flow, int index);
+
+// Цель bnz в байтах (0 - метка не найдена)
+int flow_branch_target(const ParseResult* result, const Instruction* instruction, uint32_t* target);
+
+#endif // FLOW_ANALYSIS_H
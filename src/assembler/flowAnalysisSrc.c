@@ -0,0 +1,126 @@
+#include "flowAnalysisHeader.h"
+
+int flow_branch_target(const ParseResult* result, const Instruction* instruction, uint32_t* target) {
+    const Operand* operand = &instruction->operands[0];
+
+    if (!operand->is_label_valid) {
+        *target = operand->immediate;
+        return 1;
+    }
+
+    const Label* label = symbol_table_find(&result->labels, operand->label, operand->label_length,
+                                           operand->label_hash);
+    if (!label) {
+        return 0;
+    }
+    *target = label->address;
+    return 1;
+}
+
+void flow_analysis_update_usage(FlowAnalysis* flow, int i) {
+    const Instruction* instruction = &flow->result->instructions[i];
+
+    if (instruction->opcode == OPC_READY) {
+        // Регистры после ready видны пользователю
+        flow->reads[i] = FLOW_ALL_REGISTERS;
+        flow->writes[i] = 0;
+    } else {
+        isa_register_usage(instruction->machine_code, &flow->reads[i], &flow->writes[i]);
+    }
+}
+
+// Маски регистров, цели переходов и начала линейных участков
+static int analyze_instructions(FlowAnalysis* flow) {
+    const Instruction* instructions = flow->result->instructions;
+
+    for (int i = 0; i < flow->count; i++) {
+        flow_analysis_update_usage(flow, i);
+        flow->target_index[i] = -1;
+
+        if (instructions[i].opcode != OPC_BNZ) {
+            continue;
+        }
+
+        uint32_t target;
+        if (!flow_branch_target(flow->result, &instructions[i], &target) ||
+            target % 4 != 0 || target / 4 > (uint32_t)flow->count) {
+            return FLOW_ERROR_UNSAFE_TARGET;
+        }
+
+        flow->target_index[i] = (int)(target / 4);
+        if (flow->target_index[i] < flow->count) {
+            flow->leader[flow->target_index[i]] = 1;
+        }
+    }
+
+    return FLOW_SUCCESS;
+}
+
+// Обратный анализ живых регистров до неподвижной точки
+static void compute_liveness(FlowAnalysis* flow) {
+    int changed = 1;
+
+    while (changed) {
+        changed = 0;
+
+        for (int i = flow->count - 1; i >= 0; i--) {
+            const Instruction* instruction = &flow->result->instructions[i];
+            uint32_t out = 0;
+
+            if (instruction->opcode != OPC_READY) {
+                out = i + 1 < flow->count ? flow->live_in[i + 1] : FLOW_ALL_REGISTERS;
+            }
+            if (flow->target_index[i] >= 0) {
+                int target = flow->target_index[i];
+                out |= target < flow->count ? flow->live_in[target] : FLOW_ALL_REGISTERS;
+            }
+
+            uint32_t in = flow->reads[i] | (out & ~flow->writes[i]);
+            if (out != flow->live_out[i] || in != flow->live_in[i]) {
+                flow->live_out[i] = out;
+                flow->live_in[i] = in;
+                changed = 1;
+            }
+        }
+    }
+}
+
+int flow_analysis_build(FlowAnalysis* flow, const ParseResult* result) {
+    size_t words = (size_t)result->instruction_count + 1;
+
+    memset(flow, 0, sizeof(FlowAnalysis));
+    flow->result = result;
+    flow->count = result->instruction_count;
+
+    // Один блок под все маски
+    flow->reads = (uint32_t*)calloc(words * 4, sizeof(uint32_t));
+    flow->target_index = (int*)calloc(words, sizeof(int));
+    flow->leader = (uint8_t*)calloc(words, sizeof(uint8_t));
+    if (!flow->reads || !flow->target_index || !flow->leader) {
+        flow_analysis_free(flow);
+        return FLOW_ERROR_NO_MEMORY;
+    }
+    flow->writes = flow->reads + words;
+    flow->live_in = flow->reads + words * 2;
+    flow->live_out = flow->reads + words * 3;
+
+    int status = analyze_instructions(flow);
+    if (status != FLOW_SUCCESS) {
+        flow_analysis_free(flow);
+        return status;
+    }
+
+    compute_liveness(flow);
+    return FLOW_SUCCESS;
+}
+
+void flow_analysis_free(FlowAnalysis* flow) {
+    if (!flow) {
+        return;
+    }
+
+    free(flow->reads);
+    free(flow->target_index);
+    free(flow->leader);
+    memset(flow, 0, sizeof(FlowAnalysis));
+}
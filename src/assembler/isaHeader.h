@@ -0,0 +1,169 @@
+#ifndef ISA_H
+#define ISA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Единое описание системы команд. Парсер, кодировщик, декодер эмулятора,
+// модели производительности и дизассемблер используют только эту таблицу:
+// новая команда добавляется одной строкой в ISA_INSTRUCTION_LIST.
+
+// Поля машинного слова: opc[31:24], field0[23:16], field1[15:8], field2[7:0]
+#define ISA_FIELD_0 0x01u
+#define ISA_FIELD_1 0x02u
+#define ISA_FIELD_2 0x04u
+#define ISA_FIELDS_SRC (ISA_FIELD_0 | ISA_FIELD_1)
+#define ISA_FIELDS_ALL (ISA_FIELD_0 | ISA_FIELD_1 | ISA_FIELD_2)
+
+#define ISA_REGISTER_COUNT 16   // Регистры R0..R15
+
+// Семантические признаки команды
+#define ISA_FLAG_VALID         0x0001u  // Код операции определён
+#define ISA_FLAG_WRITES_DST    0x0002u  // Пишет RF[field2]
+#define ISA_FLAG_WRITES_PAIR   0x0004u  // Пишет также RF[field2 + 1] (по модулю 16)
+#define ISA_FLAG_READS_MEMORY  0x0008u  // Читает память данных
+#define ISA_FLAG_WRITES_MEMORY 0x0010u  // Пишет память данных
+#define ISA_FLAG_BRANCH        0x0020u  // Условный переход
+#define ISA_FLAG_HALT          0x0040u  // Останов
+#define ISA_FLAG_GROUP         0x0080u  // field2 - первый из ISA_GROUP_SIZE регистров (по модулю 16)
+
+#define ISA_GROUP_SIZE 4        // Регистров (слов памяти) в группе ldm/stm
+
+// Виды операндов в синтаксисе ассемблера
+typedef enum {
+    ISA_OPERAND_NONE = 0,
+    ISA_OPERAND_REGISTER,       // Регистр Rn
+    ISA_OPERAND_IMMEDIATE,      // 16-битная константа (число или метка)
+    ISA_OPERAND_TARGET          // Адрес перехода (число или метка)
+} IsaOperandKind;
+
+// Куда операнд попадает в машинном слове
+typedef enum {
+    ISA_SLOT_FIELD0 = 0,        // [23:16]
+    ISA_SLOT_FIELD1,            // [15:8]
+    ISA_SLOT_FIELD2,            // [7:0]
+    ISA_SLOT_IMM16,             // [15:0]
+    ISA_SLOT_CONST16            // [23:8]
+} IsaOperandSlot;
+
+#define ISA_MAX_OPERANDS 3
+
+typedef struct {
+    uint8_t kind;               // IsaOperandKind
+    uint8_t slot;               // IsaOperandSlot
+} IsaOperand;
+
+// Наборы операндов: количество и раскладка по полям
+#define ISA_SHAPE_NONE      0, {{0}}
+#define ISA_SHAPE_R0_R1_R2  3, {{ISA_OPERAND_REGISTER, ISA_SLOT_FIELD0}, \
+                                {ISA_OPERAND_REGISTER, ISA_SLOT_FIELD1}, \
+                                {ISA_OPERAND_REGISTER, ISA_SLOT_FIELD2}}
+#define ISA_SHAPE_IMM_R2    2, {{ISA_OPERAND_IMMEDIATE, ISA_SLOT_CONST16}, \
+                                {ISA_OPERAND_REGISTER, ISA_SLOT_FIELD2}}
+#define ISA_SHAPE_TARGET_R0 2, {{ISA_OPERAND_TARGET, ISA_SLOT_IMM16}, \
+                                {ISA_OPERAND_REGISTER, ISA_SLOT_FIELD0}}
+
+// X(имя, мнемоника, код, формат, операнды, поля-регистры, читаемые поля, признаки)
+// Поля-регистры проверяются декодером (номер < 16), читаемые поля - источники
+// для моделей зависимостей.
+//
+// Упакованные команды (0x10-0x14) работают с регистром как с двумя 8-битными
+// дорожками без знака (биты 7:0 и 15:8): addsb/subsb - сложение и вычитание
+// с насыщением, cmpgeb - 0xFF в дорожке, где src_0 >= src_1, иначе 0x00,
+// minb/maxb - минимум и максимум. ldm/stm пересылают ISA_GROUP_SIZE слов
+// памяти с адреса RF[src_0] + RF[src_1] в регистры group..group+3 и обратно;
+// при выходе за границы памяти не пересылается ни одно слово.
+#define ISA_INSTRUCTION_LIST(X) \
+    X(NOP,       "nop",       0x00, FORMAT_F1, ISA_SHAPE_NONE,      ISA_FIELDS_ALL, 0,              0) \
+    X(ADD,       "add",       0x01, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(SUB,       "sub",       0x02, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(MUL,       "mul",       0x03, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST | ISA_FLAG_WRITES_PAIR) \
+    X(DIV,       "div",       0x04, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(CMPGE,     "cmpge",     0x05, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(RSHFT,     "rshft",     0x06, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(LSHFT,     "lshft",     0x07, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(AND,       "and",       0x08, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(OR,        "or",        0x09, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(XOR,       "xor",       0x0A, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(LD,        "ld",        0x0B, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST | ISA_FLAG_READS_MEMORY) \
+    X(SET_CONST, "set_const", 0x0C, FORMAT_F2, ISA_SHAPE_IMM_R2,    ISA_FIELD_2,    0,              ISA_FLAG_WRITES_DST) \
+    X(ST,        "st",        0x0D, FORMAT_F3, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_ALL, ISA_FLAG_WRITES_MEMORY) \
+    X(BNZ,       "bnz",       0x0E, FORMAT_F4, ISA_SHAPE_TARGET_R0, ISA_FIELD_0,    ISA_FIELD_0,    ISA_FLAG_BRANCH) \
+    X(READY,     "ready",     0x0F, FORMAT_F4, ISA_SHAPE_NONE,      0,              0,              ISA_FLAG_HALT) \
+    X(ADDSB,     "addsb",     0x10, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(SUBSB,     "subsb",     0x11, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(CMPGEB,    "cmpgeb",    0x12, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(MINB,      "minb",      0x13, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(MAXB,      "maxb",      0x14, FORMAT_F1, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST) \
+    X(LDM,       "ldm",       0x15, FORMAT_F5, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_SRC, ISA_FLAG_WRITES_DST | ISA_FLAG_READS_MEMORY | ISA_FLAG_GROUP) \
+    X(STM,       "stm",       0x16, FORMAT_F5, ISA_SHAPE_R0_R1_R2,  ISA_FIELDS_ALL, ISA_FIELDS_ALL, ISA_FLAG_WRITES_MEMORY | ISA_FLAG_GROUP)
+
+// Коды операций
+#define ISA_DEFINE_OPCODE(name, mnemonic, code, ...) OPC_##name = code,
+typedef enum {
+    ISA_INSTRUCTION_LIST(ISA_DEFINE_OPCODE)
+} OpCode;
+#undef ISA_DEFINE_OPCODE
+
+// Форматы команд
+typedef enum {
+    FORMAT_F1,  // opc[7:0], src_0[7:0],  src_1[7:0],   dst[7:0]
+    FORMAT_F2,  // opc[7:0], const[15:8], const[7:0],   dst[7:0]
+    FORMAT_F3,  // opc[7:0], src_0[7:0],  src_1[7:0],   src_2[7:0]
+    FORMAT_F4,  // opc[7:0], src_0[7:0],  target[15:8], target[7:0]
+    FORMAT_F5   // opc[7:0], src_0[7:0],  src_1[7:0],   group[7:0]
+} InstructionFormat;
+
+// Описание команды
+typedef struct {
+    const char* mnemonic;       // NULL - код операции не определён
+    uint8_t mnemonic_length;
+    uint8_t opcode;
+    InstructionFormat format;
+    uint8_t operand_count;      // Операндов в синтаксисе ассемблера
+    IsaOperand operands[ISA_MAX_OPERANDS];
+    uint8_t register_fields;    // Поля, которые обязаны быть регистрами R0-R15
+    uint8_t read_fields;        // Поля-источники
+    uint16_t flags;             // ISA_FLAG_*
+} IsaInstruction;
+
+// Таблица, индексируемая кодом операции
+#define ISA_OPCODE_SPACE 256
+extern const IsaInstruction IsaTable[ISA_OPCODE_SPACE];
+
+// Описание команды по коду операции (всегда не NULL, см. ISA_FLAG_VALID)
+#define isa_lookup_opcode(opcode) (&IsaTable[(uint8_t)(opcode)])
+
+// Поиск команды по мнемонике (совершенное хеширование); NULL - не найдена
+const IsaInstruction* isa_lookup_mnemonic(const char* mnemonic, size_t length);
+
+// Маска полей машинного слова, значение которых не является номером регистра (>= 16).
+// Вычисляется без ветвлений; команда корректна, если маска & register_fields == 0.
+static inline uint8_t isa_invalid_register_fields(uint32_t instruction) {
+    return (uint8_t)((((instruction >> 20) & 0x0F) != 0) |
+                     ((((instruction >> 12) & 0x0F) != 0) << 1) |
+                     ((((instruction >> 4) & 0x0F) != 0) << 2));
+}
+
+// Регистры поля 2 (бит r - регистр Rr): один регистр или группа ldm/stm
+static inline uint16_t isa_field2_registers(const IsaInstruction* isa, uint8_t field2) {
+    if (!(isa->flags & ISA_FLAG_GROUP)) {
+        return (uint16_t)(1u << (field2 & 0x0F));
+    }
+    uint32_t group = ((1u << ISA_GROUP_SIZE) - 1) << (field2 & 0x0F);
+    return (uint16_t)(group | (group >> 16));
+}
+
+// Кодирование команды по значениям операндов в порядке синтаксиса
+uint32_t isa_encode(const IsaInstruction* isa, const uint16_t values[ISA_MAX_OPERANDS], int value_count);
+
+// Маски регистров, читаемых и записываемых командой (бит r - регистр Rr)
+void isa_register_usage(uint32_t instruction, uint32_t* reads, uint32_t* writes);
+
+// Дизассемблирование в синтаксис ассемблера; возвращает длину строки или -1
+int isa_disassemble(uint32_t instruction, char* buffer, size_t size);
+
+#endif // ISA_H
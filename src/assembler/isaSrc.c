@@ -0,0 +1,200 @@
+#include "isaHeader.h"
+#include <pthread.h>
+
+// Таблица команд, индексируемая кодом операции
+#define ISA_DEFINE_ENTRY(name, mnemonic, code, format, shape, register_fields, read_fields, flags) \
+    [code] = {mnemonic, sizeof(mnemonic) - 1, code, format, shape, register_fields, read_fields, \
+              (flags) | ISA_FLAG_VALID},
+
+const IsaInstruction IsaTable[ISA_OPCODE_SPACE] = {
+    ISA_INSTRUCTION_LIST(ISA_DEFINE_ENTRY)
+};
+
+#undef ISA_DEFINE_ENTRY
+
+// Совершенный хеш мнемоник: ключ из первых двух символов, последнего символа и длины,
+// слот - старшие биты произведения ключа на нечётный множитель. Множитель подбирается
+// один раз при первом обращении так, чтобы мнемоники таблицы не имели коллизий.
+// Если подобрать не удалось (совпадающие ключи), поиск идёт перебором таблицы.
+#define ISA_HASH_BITS 6
+#define ISA_HASH_ATTEMPTS 65536
+#define ISA_HASH_SLOTS (1u << ISA_HASH_BITS)
+
+static uint8_t isa_hash_slots[ISA_HASH_SLOTS];   // Код операции + 1 (0 - пустой слот)
+static uint32_t isa_hash_multiplier;            // 0 - совершенный хеш не построен
+static pthread_once_t isa_hash_once = PTHREAD_ONCE_INIT;
+
+static uint32_t isa_hash_key(const char* mnemonic, size_t length) {
+    return (uint32_t)(uint8_t)mnemonic[0] |
+           ((uint32_t)(uint8_t)mnemonic[length > 1 ? 1 : 0] << 8) |
+           ((uint32_t)(uint8_t)mnemonic[length - 1] << 16) |
+           ((uint32_t)length << 24);
+}
+
+static uint32_t isa_hash_slot(uint32_t key, uint32_t multiplier) {
+    return (key * multiplier) >> (32 - ISA_HASH_BITS);
+}
+
+static void isa_build_hash(void) {
+    uint32_t multiplier = 0x9E3779B1u;
+    for (int attempt = 0; attempt < ISA_HASH_ATTEMPTS; attempt++, multiplier += 2) {
+        memset(isa_hash_slots, 0, sizeof(isa_hash_slots));
+        int collision = 0;
+
+        for (int opcode = 0; opcode < ISA_OPCODE_SPACE && !collision; opcode++) {
+            const IsaInstruction* isa = &IsaTable[opcode];
+            if (!isa->mnemonic) {
+                continue;
+            }
+
+            uint32_t slot = isa_hash_slot(isa_hash_key(isa->mnemonic, isa->mnemonic_length), multiplier);
+            if (isa_hash_slots[slot] != 0) {
+                collision = 1;
+            } else {
+                isa_hash_slots[slot] = (uint8_t)(opcode + 1);
+            }
+        }
+
+        if (!collision) {
+            isa_hash_multiplier = multiplier;
+            return;
+        }
+    }
+
+    isa_hash_multiplier = 0;
+}
+
+const IsaInstruction* isa_lookup_mnemonic(const char* mnemonic, size_t length) {
+    if (!mnemonic || length == 0 || length > 255) {
+        return NULL;
+    }
+
+    pthread_once(&isa_hash_once, isa_build_hash);
+
+    if (isa_hash_multiplier == 0) {
+        for (int opcode = 0; opcode < ISA_OPCODE_SPACE; opcode++) {
+            const IsaInstruction* isa = &IsaTable[opcode];
+            if (isa->mnemonic && isa->mnemonic_length == length && memcmp(isa->mnemonic, mnemonic, length) == 0) {
+                return isa;
+            }
+        }
+        return NULL;
+    }
+
+    uint8_t entry = isa_hash_slots[isa_hash_slot(isa_hash_key(mnemonic, length), isa_hash_multiplier)];
+    if (entry == 0) {
+        return NULL;
+    }
+
+    // Одно сравнение строк для подтверждения
+    const IsaInstruction* isa = &IsaTable[entry - 1];
+    if (isa->mnemonic_length != length || memcmp(isa->mnemonic, mnemonic, length) != 0) {
+        return NULL;
+    }
+
+    return isa;
+}
+
+uint32_t isa_encode(const IsaInstruction* isa, const uint16_t values[ISA_MAX_OPERANDS], int value_count) {
+    uint32_t machine_code = (uint32_t)isa->opcode << 24;
+
+    // Неполный набор операндов кодируется только кодом операции
+    if (value_count < isa->operand_count) {
+        return machine_code;
+    }
+
+    for (int i = 0; i < isa->operand_count; i++) {
+        switch (isa->operands[i].slot) {
+            case ISA_SLOT_FIELD0: machine_code |= (uint32_t)(values[i] & 0xFF) << 16; break;
+            case ISA_SLOT_FIELD1: machine_code |= (uint32_t)(values[i] & 0xFF) << 8; break;
+            case ISA_SLOT_FIELD2: machine_code |= (uint32_t)(values[i] & 0xFF); break;
+            case ISA_SLOT_IMM16:  machine_code |= (uint32_t)values[i]; break;
+            case ISA_SLOT_CONST16: machine_code |= (uint32_t)values[i] << 8; break;
+        }
+    }
+
+    return machine_code;
+}
+
+void isa_register_usage(uint32_t instruction, uint32_t* reads, uint32_t* writes) {
+    const IsaInstruction* isa = isa_lookup_opcode(instruction >> 24);
+    uint8_t field0 = (instruction >> 16) & 0x0F;
+    uint8_t field1 = (instruction >> 8) & 0x0F;
+    uint8_t field2 = instruction & 0x0F;
+
+    uint32_t read_mask = 0;
+    if (isa->read_fields & ISA_FIELD_0) read_mask |= 1u << field0;
+    if (isa->read_fields & ISA_FIELD_1) read_mask |= 1u << field1;
+    if (isa->read_fields & ISA_FIELD_2) read_mask |= isa_field2_registers(isa, field2);
+
+    uint32_t write_mask = 0;
+    if (isa->flags & ISA_FLAG_WRITES_DST) write_mask |= isa_field2_registers(isa, field2);
+    if (isa->flags & ISA_FLAG_WRITES_PAIR) write_mask |= 1u << ((field2 + 1) & 0x0F);
+
+    *reads = read_mask;
+    *writes = write_mask;
+}
+
+// Вывод регистра "Rn" без printf
+static char* isa_put_register(char* out, uint8_t reg) {
+    *out++ = 'R';
+    if (reg >= 100) *out++ = (char)('0' + reg / 100);
+    if (reg >= 10) *out++ = (char)('0' + (reg / 10) % 10);
+    *out++ = (char)('0' + reg % 10);
+    return out;
+}
+
+// Вывод 16-битного значения "0xHHHH"
+static char* isa_put_hex16(char* out, uint16_t value) {
+    static const char digits[] = "0123456789ABCDEF";
+    *out++ = '0';
+    *out++ = 'x';
+    for (int shift = 12; shift >= 0; shift -= 4) {
+        *out++ = digits[(value >> shift) & 0x0F];
+    }
+    return out;
+}
+
+int isa_disassemble(uint32_t instruction, char* buffer, size_t size) {
+    const IsaInstruction* isa = isa_lookup_opcode(instruction >> 24);
+    if (!isa->mnemonic || !buffer || size == 0) {
+        return -1;
+    }
+
+    char text[32];
+    char* out = text;
+
+    memcpy(out, isa->mnemonic, isa->mnemonic_length);
+    out += isa->mnemonic_length;
+
+    for (int i = 0; i < isa->operand_count; i++) {
+        *out++ = i == 0 ? ' ' : ',';
+        if (i > 0) {
+            *out++ = ' ';
+        }
+
+        uint16_t value;
+        switch (isa->operands[i].slot) {
+            case ISA_SLOT_FIELD0: value = (instruction >> 16) & 0xFF; break;
+            case ISA_SLOT_FIELD1: value = (instruction >> 8) & 0xFF; break;
+            case ISA_SLOT_FIELD2: value = instruction & 0xFF; break;
+            case ISA_SLOT_CONST16: value = (instruction >> 8) & 0xFFFF; break;
+            default: value = instruction & 0xFFFF; break;
+        }
+
+        if (isa->operands[i].kind == ISA_OPERAND_REGISTER) {
+            out = isa_put_register(out, (uint8_t)value);
+        } else {
+            out = isa_put_hex16(out, value);
+        }
+    }
+
+    size_t length = (size_t)(out - text);
+    if (length >= size) {
+        length = size - 1;
+    }
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+
+    return (int)length;
+}
@@ -0,0 +1,58 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parserHeader.h"
+#include "flowAnalysisHeader.h"
+#include "profileHeader.h"
+
+// Раскладка линейных участков по профилю выполнения (profileHeader.h).
+//
+// В ISA нет безусловного перехода и перехода по нулю, поэтому безусловный
+// переход записывается парой "set_const c, Rt; bnz L, Rt" (c != 0) и стоит
+// две инструкции на каждое выполнение. Проход переставляет участки так,
+// чтобы горячие переходы стали проваливанием:
+//   - участок, заканчивающийся безусловным переходом, ставится перед целью,
+//     bnz удаляется (set_const - если Rt не живой в цели);
+//   - горячий цикл с проверкой в начале поворачивается: тело проваливается
+//     в проверку, bnz проверки выполняется внизу цикла;
+//   - холодные участки уходят за горячие.
+// Если проваливание в участок нарушено, добавляется "set_const 1, Rt; bnz",
+// где Rt - свободный (не живой) регистр; без свободного регистра проваливание
+// сохраняется. Условные bnz не инвертируются: инверсия стоит дороже, чем
+// экономит. Перестановка применяется, только если по профилю число
+// выполненных инструкций уменьшается. Метки и числовые цели bnz
+// пересчитываются, машинный код генерируется заново.
+
+// Коды результата
+typedef enum {
+    LAYOUT_SUCCESS = 0,
+    LAYOUT_ERROR_NO_MEMORY,          // Не удалось выделить память
+    LAYOUT_ERROR_UNSAFE_TARGET,      // Цель bnz вне программы: проход не применяется
+    LAYOUT_ERROR_PROFILE_MISMATCH,   // Профиль снят с другой программы
+    LAYOUT_ERROR_TOO_LARGE,          // Программа с переходами не помещается в память
+    LAYOUT_ERROR_COUNT               // Количество кодов ошибок (всегда последний)
+} LayoutErrorCode;
+
+extern const char* LayoutErrorMessages[LAYOUT_ERROR_COUNT];
+
+// Статистика раскладки
+typedef struct {
+    int blocks;                      // Линейных участков
+    int chains;                      // Цепочек проваливания
+    int removed_jumps;               // Удалённые bnz безусловных переходов
+    int removed_constants;           // Удалённые set_const этих переходов
+    int inserted_jumps;              // Добавленные переходы (включая переход ко входу)
+    int applied;                     // Раскладка применена
+    uint64_t instructions_before;    // Выполненных инструкций по профилю
+    uint64_t instructions_after;     // Оценка после раскладки
+} LayoutStats;
+
+// Раскладка результата парсинга на месте (все метки должны быть разрешены);
+// профиль должен быть снят с машинного кода result
+int layout_optimize(ParseResult* result, const ExecutionProfile* profile, LayoutStats* stats);
+
+#endif // LAYOUT_H
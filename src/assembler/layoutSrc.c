@@ -0,0 +1,570 @@
+#include "layoutHeader.h"
+
+const char* LayoutErrorMessages[LAYOUT_ERROR_COUNT] = {
+    "Success",                               // LAYOUT_SUCCESS
+    "Out of memory",                         // LAYOUT_ERROR_NO_MEMORY
+    "Branch target outside the program",     // LAYOUT_ERROR_UNSAFE_TARGET
+    "Profile belongs to a different program", // LAYOUT_ERROR_PROFILE_MISMATCH
+    "Program too large after layout"         // LAYOUT_ERROR_TOO_LARGE
+};
+
+#define NO_BLOCK (-1)
+#define END_BLOCK (-2)              // Выход за конец программы
+#define NO_REGISTER (-1)
+#define JUMP_LENGTH 2               // set_const + bnz
+
+// Как заканчивается линейный участок
+typedef enum {
+    BLOCK_FALLTHROUGH,              // Проваливание в следующий участок
+    BLOCK_BRANCH,                   // Условный bnz, иначе проваливание
+    BLOCK_JUMP,                     // Безусловный переход set_const c, Rt; bnz L, Rt
+    BLOCK_READY                     // Остановка
+} BlockKind;
+
+typedef struct {
+    int start;                      // Первая инструкция
+    int end;                        // За последней инструкцией
+    BlockKind kind;
+    int successor;                  // Участок проваливания (END_BLOCK, NO_BLOCK - нет)
+    int jump_target;                // Цель безусловного перехода (END_BLOCK - конец программы)
+    uint64_t fall_weight;           // Выполнений проваливания
+    uint64_t jump_weight;           // Выполнений безусловного перехода
+    uint64_t heat;                  // Выполнений первой инструкции
+    int scratch;                    // Свободный регистр для перехода к successor
+} Block;
+
+// Кандидат на проваливание: from ставится непосредственно перед to
+typedef struct {
+    int from;
+    int to;
+    uint64_t weight;
+    int is_jump;
+} Edge;
+
+// Состояние прохода
+typedef struct {
+    ParseResult* result;
+    const ExecutionProfile* profile;
+    FlowAnalysis flow;
+    int count;
+    Block* blocks;
+    int block_count;
+    int* block_of;                  // Участок инструкции
+    int* next;                      // Следующий участок в цепочке
+    int* prev;                      // Предыдущий участок в цепочке
+    int* chain;                     // Номер цепочки участка
+    int* chain_head;                // Первый участок цепочки (по номеру цепочки)
+    int* chain_size;
+    int* layout_next;               // Следующий участок в новом порядке
+    int* order;                     // Участки в новом порядке
+    int end_block;                  // Участок, проваливающийся за конец программы
+    int entry_scratch;              // Свободный регистр для перехода ко входу
+} LayoutPass;
+
+static uint64_t executed(const LayoutPass* pass, int index) {
+    return (uint32_t)index < pass->profile->instruction_count ? pass->profile->executed[index] : 0;
+}
+
+static uint64_t taken(const LayoutPass* pass, int index) {
+    return (uint32_t)index < pass->profile->instruction_count ? pass->profile->taken[index] : 0;
+}
+
+static int free_register(uint32_t live) {
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        if (!(live & (1u << r))) {
+            return r;
+        }
+    }
+    return NO_REGISTER;
+}
+
+// Профиль должен относиться к текущему машинному коду
+static int profile_matches(const ParseResult* result, const ExecutionProfile* profile) {
+    size_t size = (size_t)result->instruction_count * 4;
+    uint8_t* code = (uint8_t*)malloc(size + 1);
+    if (!code) {
+        return -1;
+    }
+
+    for (int i = 0; i < result->instruction_count; i++) {
+        uint32_t word = result->instructions[i].machine_code;
+        code[i * 4] = (word >> 24) & 0xFF;
+        code[i * 4 + 1] = (word >> 16) & 0xFF;
+        code[i * 4 + 2] = (word >> 8) & 0xFF;
+        code[i * 4 + 3] = word & 0xFF;
+    }
+
+    int matches = profile_program_hash(code, size) == profile->program_hash &&
+                  profile->instruction_count <= (uint32_t)result->instruction_count;
+    free(code);
+    return matches;
+}
+
+// Безусловный переход: set_const c, Rt (c != 0) непосредственно перед bnz L, Rt
+static int is_jump_idiom(const Instruction* instructions, int start, int last) {
+    return last > start &&
+           instructions[last - 1].opcode == OPC_SET_CONST &&
+           instructions[last - 1].operands[0].immediate != 0 &&
+           instructions[last - 1].operands[1].reg_num == instructions[last].operands[1].reg_num;
+}
+
+static int is_block_start(const LayoutPass* pass, int i) {
+    if (i == 0 || pass->flow.leader[i]) {
+        return 1;
+    }
+    OpCode previous = pass->result->instructions[i - 1].opcode;
+    return previous == OPC_BNZ || previous == OPC_READY;
+}
+
+// Разбиение на участки и веса переходов между ними
+static void build_blocks(LayoutPass* pass) {
+    const Instruction* instructions = pass->result->instructions;
+
+    pass->block_count = 0;
+    for (int i = 0; i < pass->count; i++) {
+        if (is_block_start(pass, i)) {
+            if (pass->block_count > 0) {
+                pass->blocks[pass->block_count - 1].end = i;
+            }
+            pass->blocks[pass->block_count].start = i;
+            pass->block_count++;
+        }
+        pass->block_of[i] = pass->block_count - 1;
+    }
+    pass->blocks[pass->block_count - 1].end = pass->count;
+
+    pass->end_block = NO_BLOCK;
+    for (int b = 0; b < pass->block_count; b++) {
+        Block* block = &pass->blocks[b];
+        int last = block->end - 1;
+        int fall = b + 1 < pass->block_count ? b + 1 : END_BLOCK;
+
+        block->successor = NO_BLOCK;
+        block->jump_target = NO_BLOCK;
+        block->heat = executed(pass, block->start);
+        block->scratch = NO_REGISTER;
+
+        switch (instructions[last].opcode) {
+            case OPC_READY:
+                block->kind = BLOCK_READY;
+                continue;
+
+            case OPC_BNZ:
+                if (is_jump_idiom(instructions, block->start, last)) {
+                    int target = pass->flow.target_index[last];
+                    block->kind = BLOCK_JUMP;
+                    block->jump_target = target < pass->count ? pass->block_of[target] : END_BLOCK;
+                    block->jump_weight = executed(pass, last);
+                    continue;
+                }
+                block->kind = BLOCK_BRANCH;
+                block->fall_weight = executed(pass, last) - taken(pass, last);
+                break;
+
+            default:
+                block->kind = BLOCK_FALLTHROUGH;
+                block->fall_weight = executed(pass, last);
+                break;
+        }
+
+        block->successor = fall;
+        if (fall == END_BLOCK) {
+            pass->end_block = b;
+        } else {
+            block->scratch = free_register(pass->flow.live_in[pass->blocks[fall].start]);
+        }
+    }
+
+    pass->entry_scratch = free_register(pass->flow.live_in[0]);
+}
+
+static int can_merge(const LayoutPass* pass, int from, int to) {
+    return to >= 0 && from != pass->end_block &&
+           pass->next[from] == NO_BLOCK && pass->prev[to] == NO_BLOCK &&
+           pass->chain[from] != pass->chain[to] &&
+           (to != 0 || pass->entry_scratch != NO_REGISTER);
+}
+
+// Соединение цепочек; меньшая цепочка получает номер большей
+static void merge(LayoutPass* pass, int from, int to) {
+    int a = pass->chain[from];
+    int c = pass->chain[to];
+
+    pass->next[from] = to;
+    pass->prev[to] = from;
+
+    int keep = pass->chain_size[a] >= pass->chain_size[c] ? a : c;
+    int drop = keep == a ? c : a;
+    int block = pass->chain_head[drop];
+
+    for (int i = 0; i < pass->chain_size[drop]; i++, block = pass->next[block]) {
+        pass->chain[block] = keep;
+    }
+    pass->chain_head[keep] = pass->chain_head[a];
+    pass->chain_size[keep] += pass->chain_size[drop];
+}
+
+// Горячие переходы первыми; при равенстве проваливание сохраняет исходный порядок
+static int compare_edges(const void* left, const void* right) {
+    const Edge* a = (const Edge*)left;
+    const Edge* b = (const Edge*)right;
+
+    if (a->weight != b->weight) {
+        return a->weight > b->weight ? -1 : 1;
+    }
+    if (a->is_jump != b->is_jump) {
+        return a->is_jump - b->is_jump;
+    }
+    return a->from - b->from;
+}
+
+// Жадное построение цепочек проваливания (Pettis-Hansen)
+static int build_chains(LayoutPass* pass) {
+    Edge* edges = (Edge*)malloc(((size_t)pass->block_count + 1) * sizeof(Edge));
+    if (!edges) {
+        return LAYOUT_ERROR_NO_MEMORY;
+    }
+
+    for (int b = 0; b < pass->block_count; b++) {
+        pass->next[b] = NO_BLOCK;
+        pass->prev[b] = NO_BLOCK;
+        pass->chain[b] = b;
+        pass->chain_head[b] = b;
+        pass->chain_size[b] = 1;
+    }
+
+    // Проваливание без свободного регистра нельзя заменить переходом
+    int edge_count = 0;
+    for (int b = 0; b < pass->block_count; b++) {
+        const Block* block = &pass->blocks[b];
+
+        if (block->successor >= 0 && block->scratch == NO_REGISTER) {
+            merge(pass, b, block->successor);
+        } else if (block->successor >= 0) {
+            edges[edge_count++] = (Edge){b, block->successor, block->fall_weight, 0};
+        } else if (block->kind == BLOCK_JUMP && block->jump_target >= 0) {
+            edges[edge_count++] = (Edge){b, block->jump_target, block->jump_weight, 1};
+        }
+    }
+
+    qsort(edges, edge_count, sizeof(Edge), compare_edges);
+
+    for (int i = 0; i < edge_count; i++) {
+        if (can_merge(pass, edges[i].from, edges[i].to)) {
+            merge(pass, edges[i].from, edges[i].to);
+        }
+    }
+
+    free(edges);
+    return LAYOUT_SUCCESS;
+}
+
+// Цепочка в новом порядке
+typedef struct {
+    int head;
+    int rank;                       // 0 - вход, 1 - прочие, 2 - выход за конец программы
+    uint64_t heat;                  // Наибольшее число выполнений участка цепочки
+} ChainKey;
+
+static int compare_chains(const void* left, const void* right) {
+    const ChainKey* a = (const ChainKey*)left;
+    const ChainKey* b = (const ChainKey*)right;
+
+    if (a->rank != b->rank) {
+        return a->rank - b->rank;
+    }
+    if (a->heat != b->heat) {
+        return a->heat > b->heat ? -1 : 1;
+    }
+    return a->head - b->head;
+}
+
+// Порядок цепочек: вход, остальные по убыванию выполнений, цепочка с выходом
+// за конец программы - последней
+static int order_chains(LayoutPass* pass, LayoutStats* stats) {
+    ChainKey* keys = (ChainKey*)malloc(((size_t)pass->block_count + 1) * sizeof(ChainKey));
+    if (!keys) {
+        return LAYOUT_ERROR_NO_MEMORY;
+    }
+
+    int entry_chain = pass->chain[0];
+    int end_chain = pass->end_block >= 0 ? pass->chain[pass->end_block] : NO_BLOCK;
+    int chain_count = 0;
+
+    for (int head = 0; head < pass->block_count; head++) {
+        if (pass->prev[head] != NO_BLOCK) {
+            continue;
+        }
+
+        ChainKey* key = &keys[chain_count++];
+        key->head = head;
+        key->rank = pass->chain[head] == end_chain ? 2 : pass->chain[head] == entry_chain ? 0 : 1;
+        key->heat = 0;
+        for (int b = head; b != NO_BLOCK; b = pass->next[b]) {
+            key->heat = pass->blocks[b].heat > key->heat ? pass->blocks[b].heat : key->heat;
+        }
+    }
+    stats->chains = chain_count;
+
+    qsort(keys, chain_count, sizeof(ChainKey), compare_chains);
+
+    int position = 0;
+    for (int i = 0; i < chain_count; i++) {
+        for (int b = keys[i].head; b != NO_BLOCK; b = pass->next[b]) {
+            pass->order[position++] = b;
+        }
+    }
+
+    for (int i = 0; i < pass->block_count; i++) {
+        pass->layout_next[pass->order[i]] = i + 1 < pass->block_count ? pass->order[i + 1] : NO_BLOCK;
+    }
+
+    free(keys);
+    return LAYOUT_SUCCESS;
+}
+
+// set_const безусловного перехода удаляется вместе с bnz, если Rt не живой в цели
+static int jump_constant_removable(const LayoutPass* pass, const Block* block) {
+    int last = block->end - 1;
+    uint8_t reg = pass->result->instructions[last].operands[1].reg_num;
+    return !(pass->flow.live_in[pass->blocks[block->jump_target].start] & (1u << reg));
+}
+
+// Оценка числа выполненных инструкций после раскладки
+static void estimate(const LayoutPass* pass, LayoutStats* stats) {
+    uint64_t saved = 0;
+    uint64_t added = 0;
+
+    for (int i = 0; i < pass->count; i++) {
+        stats->instructions_before += executed(pass, i);
+    }
+
+    for (int b = 0; b < pass->block_count; b++) {
+        const Block* block = &pass->blocks[b];
+
+        if (block->kind == BLOCK_JUMP && block->jump_target >= 0 && pass->layout_next[b] == block->jump_target) {
+            saved += block->jump_weight;
+            stats->removed_jumps++;
+            if (jump_constant_removable(pass, block)) {
+                saved += executed(pass, block->end - 2);
+                stats->removed_constants++;
+            }
+        } else if (block->successor >= 0 && pass->layout_next[b] != block->successor) {
+            added += JUMP_LENGTH * block->fall_weight;
+            stats->inserted_jumps++;
+        }
+    }
+
+    if (pass->order[0] != 0) {
+        added += JUMP_LENGTH;
+        stats->inserted_jumps++;
+    }
+
+    stats->instructions_after = stats->instructions_before - saved + added;
+}
+
+// Переход "set_const 1, reg; bnz <old_target>, reg"; цель пересчитывается после раскладки
+static void emit_jump(Instruction* output, int position, uint8_t reg, int line_number) {
+    Instruction* constant = &output[position];
+    Instruction* branch = &output[position + 1];
+
+    memset(constant, 0, 2 * sizeof(Instruction));
+
+    constant->opcode = OPC_SET_CONST;
+    constant->format = get_format_from_opcode(OPC_SET_CONST);
+    constant->operand_count = 2;
+    constant->operands[0].immediate = 1;
+    constant->operands[0].is_immediate_valid = 1;
+    constant->operands[1].reg_num = reg;
+    constant->operands[1].is_reg_valid = 1;
+    constant->line_number = line_number;
+
+    branch->opcode = OPC_BNZ;
+    branch->format = get_format_from_opcode(OPC_BNZ);
+    branch->operand_count = 2;
+    branch->operands[0].is_immediate_valid = 1;
+    branch->operands[1].reg_num = reg;
+    branch->operands[1].is_reg_valid = 1;
+    branch->line_number = line_number;
+}
+
+// Новый список инструкций. new_index удалённой инструкции - следующая
+// записанная в новом порядке; jump_source - старая цель добавленного перехода
+static int emit(LayoutPass* pass, const LayoutStats* stats, int* new_index) {
+    ParseResult* result = pass->result;
+    const Instruction* instructions = result->instructions;
+    int total = pass->count + JUMP_LENGTH * stats->inserted_jumps -
+                stats->removed_jumps - stats->removed_constants;
+
+    if (total > MAX_PROGRAM_INSTRUCTIONS) {
+        return LAYOUT_ERROR_TOO_LARGE;
+    }
+
+    Instruction* output = (Instruction*)calloc((size_t)total + 1, sizeof(Instruction));
+    int* jump_source = (int*)malloc(((size_t)total + 1) * sizeof(int));
+    int* pending = (int*)malloc(((size_t)pass->count + 1) * sizeof(int));
+    if (!output || !jump_source || !pending) {
+        free(output);
+        free(jump_source);
+        free(pending);
+        return LAYOUT_ERROR_NO_MEMORY;
+    }
+
+    int position = 0;
+    int pending_count = 0;
+
+    if (pass->order[0] != 0) {
+        emit_jump(output, position, (uint8_t)pass->entry_scratch, instructions[0].line_number);
+        jump_source[position] = -1;
+        jump_source[position + 1] = 0;
+        position += JUMP_LENGTH;
+    }
+
+    for (int k = 0; k < pass->block_count; k++) {
+        int b = pass->order[k];
+        const Block* block = &pass->blocks[b];
+        int end = block->end;
+
+        if (block->kind == BLOCK_JUMP && block->jump_target >= 0 && pass->layout_next[b] == block->jump_target) {
+            end -= jump_constant_removable(pass, block) ? 2 : 1;
+        }
+
+        for (int i = block->start; i < block->end; i++) {
+            if (i >= end) {
+                pending[pending_count++] = i;
+                continue;
+            }
+
+            while (pending_count > 0) {
+                new_index[pending[--pending_count]] = position;
+            }
+            new_index[i] = position;
+            jump_source[position] = -1;
+            output[position++] = instructions[i];
+        }
+
+        if (block->successor >= 0 && pass->layout_next[b] != block->successor) {
+            while (pending_count > 0) {
+                new_index[pending[--pending_count]] = position;
+            }
+            emit_jump(output, position, (uint8_t)block->scratch, instructions[block->end - 1].line_number);
+            jump_source[position] = -1;
+            jump_source[position + 1] = pass->blocks[block->successor].start;
+            position += JUMP_LENGTH;
+        }
+    }
+
+    while (pending_count > 0) {
+        new_index[pending[--pending_count]] = position;
+    }
+    new_index[pass->count] = position;
+
+    // Числовые цели: старые bnz и добавленные переходы
+    for (int i = 0; i < position; i++) {
+        Operand* target = &output[i].operands[0];
+
+        if (jump_source[i] >= 0) {
+            target->immediate = (uint16_t)(new_index[jump_source[i]] * 4);
+        } else if (output[i].opcode == OPC_BNZ && !target->is_label_valid) {
+            target->immediate = (uint16_t)(new_index[target->immediate / 4] * 4);
+        }
+        output[i].address = (uint16_t)(i * 4);
+    }
+
+    for (int i = 0; i < result->labels.count; i++) {
+        Label* label = &result->labels.labels[i];
+        uint32_t index = label->address / 4u;
+        if (label->address % 4 == 0 && index <= (uint32_t)pass->count) {
+            label->address = (uint16_t)(new_index[index] * 4);
+        }
+    }
+
+    free(result->instructions);
+    result->instructions = output;
+    result->instruction_count = position;
+    result->instruction_capacity = total + 1;
+    generate_machine_code_for_all(result);
+
+    free(jump_source);
+    free(pending);
+    return LAYOUT_SUCCESS;
+}
+
+static int run_layout(LayoutPass* pass, LayoutStats* stats) {
+    size_t words = (size_t)pass->count + 1;
+
+    pass->blocks = (Block*)calloc(words, sizeof(Block));
+    // Один блок под все индексные массивы прохода
+    int* indices = (int*)malloc(words * 9 * sizeof(int));
+    if (!pass->blocks || !indices) {
+        free(indices);
+        return LAYOUT_ERROR_NO_MEMORY;
+    }
+    pass->block_of = indices;
+    pass->next = indices + words;
+    pass->prev = indices + words * 2;
+    pass->chain = indices + words * 3;
+    pass->chain_head = indices + words * 4;
+    pass->chain_size = indices + words * 5;
+    pass->layout_next = indices + words * 6;
+    pass->order = indices + words * 7;
+    int* new_index = indices + words * 8;
+
+    build_blocks(pass);
+    stats->blocks = pass->block_count;
+
+    int status = build_chains(pass);
+    if (status == LAYOUT_SUCCESS) {
+        status = order_chains(pass, stats);
+    }
+
+    if (status == LAYOUT_SUCCESS) {
+        estimate(pass, stats);
+        int entry_possible = pass->order[0] == 0 || pass->entry_scratch != NO_REGISTER;
+
+        if (entry_possible && stats->instructions_after < stats->instructions_before) {
+            status = emit(pass, stats, new_index);
+            stats->applied = status == LAYOUT_SUCCESS;
+        }
+    }
+
+    free(indices);
+    return status;
+}
+
+int layout_optimize(ParseResult* result, const ExecutionProfile* profile, LayoutStats* stats) {
+    LayoutStats local;
+    if (!stats) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(LayoutStats));
+
+    if (!result || !profile || result->instruction_count <= 0) {
+        return LAYOUT_SUCCESS;
+    }
+
+    int matches = profile_matches(result, profile);
+    if (matches < 0) {
+        return LAYOUT_ERROR_NO_MEMORY;
+    }
+    if (!matches) {
+        return LAYOUT_ERROR_PROFILE_MISMATCH;
+    }
+
+    LayoutPass pass;
+    memset(&pass, 0, sizeof(LayoutPass));
+    pass.result = result;
+    pass.profile = profile;
+    pass.count = result->instruction_count;
+
+    int status = flow_analysis_build(&pass.flow, result);
+    if (status != FLOW_SUCCESS) {
+        return status == FLOW_ERROR_UNSAFE_TARGET ? LAYOUT_ERROR_UNSAFE_TARGET : LAYOUT_ERROR_NO_MEMORY;
+    }
+
+    status = run_layout(&pass, stats);
+
+    free(pass.blocks);
+    flow_analysis_free(&pass.flow);
+    return status;
+}
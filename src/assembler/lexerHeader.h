@@ -0,0 +1,49 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Исходный текст программы: отображённый в память файл или буфер в куче
+typedef struct {
+    const char* data;
+    size_t size;
+    void* mapping;          // Адрес mmap (NULL, если не отображён)
+    char* heap_copy;        // Буфер, прочитанный из потока (NULL, если не используется)
+} SourceBuffer;
+
+// Отображение файла в память (для не-регулярных файлов - чтение в буфер)
+int source_buffer_open_file(SourceBuffer* buffer, const char* filename);
+
+// Чтение всего потока в буфер (каналы и другие потоки без позиционирования)
+int source_buffer_read_stream(SourceBuffer* buffer, FILE* stream);
+
+// Использование чужого буфера без копирования
+void source_buffer_wrap(SourceBuffer* buffer, const char* data, size_t size);
+
+void source_buffer_close(SourceBuffer* buffer);
+
+// Построчный обход исходного текста без копирования
+typedef struct {
+    const char* data;
+    size_t size;
+    size_t position;        // Смещение начала следующей строки
+    int line_number;        // Номер последней выданной строки
+} Lexer;
+
+void lexer_init(Lexer* lexer, const char* data, size_t size);
+
+// Следующая строка без комментария (от ';' до конца строки) и без '\n'.
+// Возвращает 0, когда текст закончился.
+int lexer_next_line(Lexer* lexer, const char** line, size_t* length, size_t* offset);
+
+// Поиск первого '\n' или ';' в [begin, end); возвращает end, если не найдено
+const char* lexer_scan_line_end(const char* begin, const char* end);
+
+// Поиск первого '\n' в [begin, end); возвращает end, если не найдено
+const char* lexer_scan_newline(const char* begin, const char* end);
+
+#endif // LEXER_H
@@ -0,0 +1,191 @@
+#include "lexerHeader.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+int source_buffer_open_file(SourceBuffer* buffer, const char* filename) {
+    if (!buffer || !filename) {
+        return -1;
+    }
+
+    memset(buffer, 0, sizeof(*buffer));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    // Каналы и устройства читаются целиком
+    if (!S_ISREG(info.st_mode)) {
+        close(fd);
+        FILE* stream = fopen(filename, "rb");
+        if (!stream) {
+            return -1;
+        }
+        int result = source_buffer_read_stream(buffer, stream);
+        fclose(stream);
+        return result;
+    }
+
+    if (info.st_size == 0) {
+        close(fd);
+        buffer->data = "";
+        return 0;
+    }
+
+    void* mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return -1;
+    }
+
+    // Текст читается один раз последовательно
+    madvise(mapping, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    buffer->mapping = mapping;
+    buffer->data = (const char*)mapping;
+    buffer->size = (size_t)info.st_size;
+
+    return 0;
+}
+
+int source_buffer_read_stream(SourceBuffer* buffer, FILE* stream) {
+    if (!buffer || !stream) {
+        return -1;
+    }
+
+    memset(buffer, 0, sizeof(*buffer));
+
+    size_t capacity = 65536;
+    size_t size = 0;
+    char* data = (char*)malloc(capacity);
+    if (!data) {
+        return -1;
+    }
+
+    for (;;) {
+        if (size == capacity) {
+            char* grown = (char*)realloc(data, capacity * 2);
+            if (!grown) {
+                free(data);
+                return -1;
+            }
+            data = grown;
+            capacity *= 2;
+        }
+
+        size_t read = fread(data + size, 1, capacity - size, stream);
+        size += read;
+        if (read == 0) {
+            break;
+        }
+    }
+
+    if (ferror(stream)) {
+        free(data);
+        return -1;
+    }
+
+    buffer->heap_copy = data;
+    buffer->data = data;
+    buffer->size = size;
+
+    return 0;
+}
+
+void source_buffer_wrap(SourceBuffer* buffer, const char* data, size_t size) {
+    if (!buffer) {
+        return;
+    }
+
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->data = data ? data : "";
+    buffer->size = data ? size : 0;
+}
+
+void source_buffer_close(SourceBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    if (buffer->mapping) {
+        munmap(buffer->mapping, buffer->size);
+    }
+    free(buffer->heap_copy);
+
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+const char* lexer_scan_line_end(const char* begin, const char* end) {
+    const char* p = begin;
+
+#if defined(__SSE2__)
+    // 16 байт за итерацию: сравнение сразу с '\n' и ';'
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i semicolon = _mm_set1_epi8(';');
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, semicolon));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask) {
+            return p + __builtin_ctz((unsigned)mask);
+        }
+        p += 16;
+    }
+#endif
+
+    while (p < end && *p != '\n' && *p != ';') {
+        p++;
+    }
+
+    return p;
+}
+
+const char* lexer_scan_newline(const char* begin, const char* end) {
+    const char* found = (const char*)memchr(begin, '\n', (size_t)(end - begin));
+    return found ? found : end;
+}
+
+void lexer_init(Lexer* lexer, const char* data, size_t size) {
+    lexer->data = data;
+    lexer->size = size;
+    lexer->position = 0;
+    lexer->line_number = 0;
+}
+
+int lexer_next_line(Lexer* lexer, const char** line, size_t* length, size_t* offset) {
+    if (lexer->position >= lexer->size) {
+        return 0;
+    }
+
+    const char* begin = lexer->data + lexer->position;
+    const char* end = lexer->data + lexer->size;
+    const char* stop = lexer_scan_line_end(begin, end);
+
+    *line = begin;
+    *length = (size_t)(stop - begin);
+    *offset = lexer->position;
+
+    // Комментарий: пропускаем всё до конца строки
+    if (stop < end && *stop == ';') {
+        stop = lexer_scan_newline(stop, end);
+    }
+
+    lexer->position = (size_t)(stop - lexer->data) + (stop < end ? 1 : 0);
+    lexer->line_number++;
+
+    return 1;
+}
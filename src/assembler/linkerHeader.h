@@ -0,0 +1,35 @@
+#ifndef LINKER_H
+#define LINKER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "assemblerHeader.h"
+#include "objectHeader.h"
+
+// Коды ошибок компоновщика
+typedef enum {
+    LINKER_SUCCESS = 0,
+    LINKER_ERROR_INVALID_INPUT,      // Нет входных файлов или файл не прочитан
+    LINKER_ERROR_DUPLICATE_SYMBOL,   // Метка экспортирована несколькими модулями
+    LINKER_ERROR_UNDEFINED_SYMBOL,   // Импортированная метка нигде не экспортирована
+    LINKER_ERROR_TOO_LARGE,          // Программа превышает MAX_PROGRAM_INSTRUCTIONS
+    LINKER_ERROR_NO_MEMORY,          // Не удалось выделить память
+    LINKER_ERROR_WRITING_FAILED,     // Ошибка записи .bin файла
+    LINKER_ERROR_COUNT               // Количество кодов ошибок (всегда последний)
+} LinkerErrorCode;
+
+extern const char* LinkerErrorMessages[LINKER_ERROR_COUNT];
+
+// Компоновка модулей в образ программы. Модули располагаются подряд в порядке
+// аргументов, первый модуль - точка входа (адрес 0). Результат побайтно
+// совпадает с ассемблированием склеенного исходного текста.
+int link_objects(const ObjectFile* const* objects, int object_count, ProgramImage** image);
+
+// Чтение объектных файлов, компоновка и запись .bin файла
+int link_object_files(const char* const* input_filenames, int input_count, const char* output_filename);
+
+void print_linker_error(int error_code, const char* custom_message);
+
+#endif // LINKER_H
@@ -0,0 +1,191 @@
+#include "linkerHeader.h"
+
+const char* LinkerErrorMessages[LINKER_ERROR_COUNT] = {
+    "Success",                       // LINKER_SUCCESS
+    "Invalid input",                 // LINKER_ERROR_INVALID_INPUT
+    "Duplicate symbol",              // LINKER_ERROR_DUPLICATE_SYMBOL
+    "Undefined symbol",              // LINKER_ERROR_UNDEFINED_SYMBOL
+    "Program too large",             // LINKER_ERROR_TOO_LARGE
+    "Out of memory",                 // LINKER_ERROR_NO_MEMORY
+    "Writing failed"                 // LINKER_ERROR_WRITING_FAILED
+};
+
+void print_linker_error(int error_code, const char* custom_message) {
+    if (error_code >= 0 && error_code < LINKER_ERROR_COUNT) {
+        fprintf(stderr, "%s: %s (%d)\n", custom_message ? custom_message : "Linker error",
+                LinkerErrorMessages[error_code], error_code);
+    } else {
+        fprintf(stderr, "%s: Unknown error code: %d\n",
+                custom_message ? custom_message : "Linker error", error_code);
+    }
+}
+
+// Глобальная таблица экспортированных символов с абсолютными адресами
+static int collect_exports(const ObjectFile* const* objects, int object_count, const uint32_t* bases,
+                           SymbolTable* globals) {
+    for (int m = 0; m < object_count; m++) {
+        for (uint32_t i = 0; i < objects[m]->symbol_count; i++) {
+            const ObjectSymbol* symbol = &objects[m]->symbols[i];
+            if (symbol->kind != OBJECT_SYMBOL_EXPORT) {
+                continue;
+            }
+
+            int status = symbol_table_add(globals, symbol->name, symbol->name_length,
+                                          symbol_hash(symbol->name, symbol->name_length),
+                                          (uint16_t)(bases[m] * 4 + symbol->address), NULL);
+            if (status == SYMBOL_TABLE_DUPLICATE) {
+                fprintf(stderr, "Symbol already defined: %s (module %d)\n", symbol->name, m + 1);
+                return LINKER_ERROR_DUPLICATE_SYMBOL;
+            }
+            if (status != SYMBOL_TABLE_SUCCESS) {
+                return LINKER_ERROR_NO_MEMORY;
+            }
+        }
+    }
+
+    return LINKER_SUCCESS;
+}
+
+// Перенос кода модуля и применение перемещений к полю цели bnz
+static int relocate_module(const ObjectFile* object, int module_number, uint16_t base,
+                           const SymbolTable* globals, uint32_t* code) {
+    memcpy(code, object->code, (size_t)object->instruction_count * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < object->relocation_count; i++) {
+        const ObjectRelocation* relocation = &object->relocations[i];
+        uint32_t* word = &code[relocation->instruction_index];
+        uint16_t target = (uint16_t)(*word & OBJECT_TARGET_MASK);
+
+        if (relocation->kind == OBJECT_RELOC_MODULE) {
+            target = (uint16_t)(target + base);
+        } else {
+            const ObjectSymbol* symbol = &object->symbols[relocation->symbol_index];
+            const Label* definition = symbol_table_find(globals, symbol->name, symbol->name_length,
+                                                        symbol_hash(symbol->name, symbol->name_length));
+            if (!definition) {
+                fprintf(stderr, "Undefined symbol: %s (module %d)\n", symbol->name, module_number);
+                return LINKER_ERROR_UNDEFINED_SYMBOL;
+            }
+            target = definition->address;
+        }
+
+        *word = (*word & ~(uint32_t)OBJECT_TARGET_MASK) | target;
+    }
+
+    return LINKER_SUCCESS;
+}
+
+int link_objects(const ObjectFile* const* objects, int object_count, ProgramImage** out_image) {
+    if (!objects || object_count <= 0 || !out_image) {
+        return LINKER_ERROR_INVALID_INPUT;
+    }
+    *out_image = NULL;
+
+    // Индексы первых инструкций модулей: префиксные суммы размеров кода
+    uint32_t* bases = (uint32_t*)malloc((size_t)object_count * sizeof(uint32_t));
+    if (!bases) {
+        return LINKER_ERROR_NO_MEMORY;
+    }
+
+    size_t total = 0;
+    for (int m = 0; m < object_count; m++) {
+        bases[m] = (uint32_t)total;
+        total += objects[m]->instruction_count;
+        if (total > MAX_PROGRAM_INSTRUCTIONS) {
+            fprintf(stderr, "Too many instructions (max %d)\n", MAX_PROGRAM_INSTRUCTIONS);
+            free(bases);
+            return LINKER_ERROR_TOO_LARGE;
+        }
+    }
+
+    SymbolTable globals;
+    uint32_t* code = (uint32_t*)malloc((total ? total : 1) * sizeof(uint32_t));
+    if (!code || symbol_table_init(&globals) != SYMBOL_TABLE_SUCCESS) {
+        free(code);
+        free(bases);
+        return LINKER_ERROR_NO_MEMORY;
+    }
+
+    int status = collect_exports(objects, object_count, bases, &globals);
+    for (int m = 0; m < object_count && status == LINKER_SUCCESS; m++) {
+        status = relocate_module(objects[m], m + 1, (uint16_t)(bases[m] * 4), &globals, &code[bases[m]]);
+    }
+
+    symbol_table_free(&globals);
+    free(bases);
+
+    ProgramImage* image = NULL;
+    if (status == LINKER_SUCCESS) {
+        image = (ProgramImage*)calloc(1, sizeof(ProgramImage));
+        if (image) {
+            image->instruction_count = (int)total;
+            image->size = total * 4;
+            image->code = (uint8_t*)malloc(image->size ? image->size : 1);
+        }
+        if (!image || !image->code) {
+            program_image_free(image);
+            image = NULL;
+            status = LINKER_ERROR_NO_MEMORY;
+        }
+    }
+
+    // Образ в формате Big Endian, как в .bin файле
+    for (size_t i = 0; image && i < total; i++) {
+        uint8_t* bytes = &image->code[i * 4];
+
+        bytes[0] = (code[i] >> 24) & 0xFF;
+        bytes[1] = (code[i] >> 16) & 0xFF;
+        bytes[2] = (code[i] >> 8) & 0xFF;
+        bytes[3] = code[i] & 0xFF;
+    }
+
+    free(code);
+    *out_image = image;
+    return status;
+}
+
+int link_object_files(const char* const* input_filenames, int input_count, const char* output_filename) {
+    if (!input_filenames || input_count <= 0 || !output_filename) {
+        print_linker_error(LINKER_ERROR_INVALID_INPUT, "No input files");
+        return LINKER_ERROR_INVALID_INPUT;
+    }
+
+    ObjectFile** objects = (ObjectFile**)calloc((size_t)input_count, sizeof(ObjectFile*));
+    if (!objects) {
+        print_linker_error(LINKER_ERROR_NO_MEMORY, NULL);
+        return LINKER_ERROR_NO_MEMORY;
+    }
+
+    int status = LINKER_SUCCESS;
+    for (int i = 0; i < input_count && status == LINKER_SUCCESS; i++) {
+        int object_status = object_read(input_filenames[i], &objects[i]);
+        if (object_status != OBJECT_SUCCESS) {
+            fprintf(stderr, "Failed to read object file: %s\n", input_filenames[i]);
+            print_object_error(object_status, NULL);
+            status = LINKER_ERROR_INVALID_INPUT;
+        }
+    }
+
+    ProgramImage* image = NULL;
+    if (status == LINKER_SUCCESS) {
+        status = link_objects((const ObjectFile* const*)objects, input_count, &image);
+    }
+
+    if (status == LINKER_SUCCESS && program_image_write(image, output_filename) != ASSEMBLER_SUCCESS) {
+        status = LINKER_ERROR_WRITING_FAILED;
+    }
+
+    if (status == LINKER_SUCCESS) {
+        printf("Successfully linked %d instructions to %s\n", image->instruction_count, output_filename);
+    } else {
+        print_linker_error(status, "Linking failed");
+    }
+
+    program_image_free(image);
+    for (int i = 0; i < input_count; i++) {
+        object_free(objects[i]);
+    }
+    free(objects);
+
+    return status;
+}
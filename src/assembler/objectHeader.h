@@ -0,0 +1,94 @@
+#ifndef OBJECT_H
+#define OBJECT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arenaHeader.h"
+#include "parserHeader.h"
+
+// Перемещаемый объектный файл модуля.
+//
+// Код модуля собирается с адреса 0. Переходы bnz на метки модуля получают
+// перемещение OBJECT_RELOC_MODULE (к цели прибавляется базовый адрес модуля),
+// переходы на метки, не определённые в модуле, - OBJECT_RELOC_SYMBOL (цель
+// берётся из экспортированной метки другого модуля). Числовые цели bnz
+// считаются абсолютными и не перемещаются. Метки экспортируются директивой
+// .global, всё неопределённое импортируется автоматически.
+//
+// Формат файла (все числа Big Endian, как машинный код в .bin):
+//   заголовок:   "CPUO", u16 версия, u16 резерв,
+//                u32 число инструкций, u32 число символов,
+//                u32 число перемещений, u32 размер таблицы строк
+//   код:         инструкции по 4 байта
+//   символы:     u32 смещение имени, u16 адрес, u8 вид, u8 резерв
+//   перемещения: u32 индекс инструкции, u32 индекс символа, u8 вид, u8[3] резерв
+//   строки:      имена, завершённые нулём
+#define OBJECT_MAGIC "CPUO"
+#define OBJECT_VERSION 1
+#define OBJECT_HEADER_SIZE 24
+#define OBJECT_SYMBOL_SIZE 8
+#define OBJECT_RELOCATION_SIZE 12
+#define OBJECT_TARGET_MASK 0x0000FFFF   // Поле цели bnz (ISA_SLOT_IMM16)
+
+// Коды ошибок объектных файлов
+typedef enum {
+    OBJECT_SUCCESS = 0,
+    OBJECT_ERROR_IO,                 // Ошибка чтения или записи файла
+    OBJECT_ERROR_BAD_FORMAT,         // Файл не является объектным файлом
+    OBJECT_ERROR_NO_MEMORY,          // Не удалось выделить память
+    OBJECT_ERROR_ASSEMBLY_FAILED,    // Ошибка парсинга исходного текста
+    OBJECT_ERROR_EXPORT_UNDEFINED,   // .global для неопределённой метки
+    OBJECT_ERROR_COUNT               // Количество кодов ошибок (всегда последний)
+} ObjectErrorCode;
+
+extern const char* ObjectErrorMessages[OBJECT_ERROR_COUNT];
+
+// Вид символа
+typedef enum {
+    OBJECT_SYMBOL_EXPORT = 0,        // Определён в модуле, виден другим модулям
+    OBJECT_SYMBOL_IMPORT = 1         // Используется, но не определён в модуле
+} ObjectSymbolKind;
+
+// Вид перемещения
+typedef enum {
+    OBJECT_RELOC_MODULE = 0,         // target += базовый адрес модуля
+    OBJECT_RELOC_SYMBOL = 1          // target = адрес символа symbol_index
+} ObjectRelocationKind;
+
+typedef struct {
+    const char* name;                // Хранится в арене объектного файла
+    uint32_t name_length;
+    uint16_t address;                // Адрес в модуле (для экспорта)
+    uint8_t kind;                    // ObjectSymbolKind
+} ObjectSymbol;
+
+typedef struct {
+    uint32_t instruction_index;
+    uint32_t symbol_index;           // Для OBJECT_RELOC_SYMBOL
+    uint8_t kind;                    // ObjectRelocationKind
+} ObjectRelocation;
+
+typedef struct {
+    uint32_t* code;                  // Машинный код
+    uint32_t instruction_count;
+    ObjectSymbol* symbols;
+    uint32_t symbol_count;
+    ObjectRelocation* relocations;
+    uint32_t relocation_count;
+    Arena names;                     // Имена символов
+} ObjectFile;
+
+// Построение объектного модуля из исходного текста
+int object_from_source(const char* source, size_t size, ObjectFile** object);
+
+// Запись и чтение объектного файла
+int object_write(const ObjectFile* object, const char* filename);
+int object_read(const char* filename, ObjectFile** object);
+
+void object_free(ObjectFile* object);
+
+void print_object_error(int error_code, const char* custom_message);
+
+#endif // OBJECT_H
@@ -0,0 +1,368 @@
+#include "objectHeader.h"
+
+const char* ObjectErrorMessages[OBJECT_ERROR_COUNT] = {
+    "Success",                       // OBJECT_SUCCESS
+    "Input/output error",            // OBJECT_ERROR_IO
+    "Invalid object file format",    // OBJECT_ERROR_BAD_FORMAT
+    "Out of memory",                 // OBJECT_ERROR_NO_MEMORY
+    "Assembly failed",               // OBJECT_ERROR_ASSEMBLY_FAILED
+    "Exported label is not defined"  // OBJECT_ERROR_EXPORT_UNDEFINED
+};
+
+void print_object_error(int error_code, const char* custom_message) {
+    if (error_code >= 0 && error_code < OBJECT_ERROR_COUNT) {
+        fprintf(stderr, "%s: %s (%d)\n", custom_message ? custom_message : "Object file error",
+                ObjectErrorMessages[error_code], error_code);
+    } else {
+        fprintf(stderr, "%s: Unknown error code: %d\n",
+                custom_message ? custom_message : "Object file error", error_code);
+    }
+}
+
+static ObjectFile* object_create(uint32_t instruction_count, uint32_t symbol_capacity,
+                                 uint32_t relocation_capacity) {
+    ObjectFile* object = (ObjectFile*)calloc(1, sizeof(ObjectFile));
+    if (!object) {
+        return NULL;
+    }
+
+    arena_init(&object->names, 0);
+    object->code = (uint32_t*)malloc((instruction_count ? instruction_count : 1) * sizeof(uint32_t));
+    object->symbols = (ObjectSymbol*)malloc((symbol_capacity ? symbol_capacity : 1) * sizeof(ObjectSymbol));
+    object->relocations = (ObjectRelocation*)malloc((relocation_capacity ? relocation_capacity : 1) *
+                                                    sizeof(ObjectRelocation));
+    if (!object->code || !object->symbols || !object->relocations) {
+        object_free(object);
+        return NULL;
+    }
+
+    object->instruction_count = instruction_count;
+    return object;
+}
+
+void object_free(ObjectFile* object) {
+    if (!object) {
+        return;
+    }
+
+    free(object->code);
+    free(object->symbols);
+    free(object->relocations);
+    arena_free(&object->names);
+    free(object);
+}
+
+// Добавление символа; в index хранится номер символа по имени (в поле address)
+static int object_add_symbol(ObjectFile* object, SymbolTable* index, const char* name, size_t length,
+                             uint16_t address, uint8_t kind, uint32_t* symbol_index) {
+    uint32_t hash = symbol_hash(name, length);
+    const Label* known = symbol_table_find(index, name, length, hash);
+    if (known) {
+        *symbol_index = known->address;
+        return OBJECT_SUCCESS;
+    }
+
+    ObjectSymbol* symbol = &object->symbols[object->symbol_count];
+    symbol->name = arena_strndup(&object->names, name, length);
+    if (!symbol->name ||
+        symbol_table_add(index, name, length, hash, (uint16_t)object->symbol_count, NULL) != SYMBOL_TABLE_SUCCESS) {
+        return OBJECT_ERROR_NO_MEMORY;
+    }
+    symbol->name_length = (uint32_t)length;
+    symbol->address = address;
+    symbol->kind = kind;
+
+    *symbol_index = object->symbol_count++;
+    return OBJECT_SUCCESS;
+}
+
+// Экспорт меток из директив .global (повторные объявления игнорируются)
+static int object_add_exports(ObjectFile* object, SymbolTable* index, const ParseResult* result) {
+    for (int i = 0; i < result->export_count; i++) {
+        const ExportedName* exported = &result->exports[i];
+        const Label* label = symbol_table_find(&result->labels, exported->name, exported->length,
+                                               symbol_hash(exported->name, exported->length));
+        if (!label) {
+            fprintf(stderr, "Exported label not defined: %s\n", exported->name);
+            report_parse_error("Failed to export label", exported->line_number, PARSER_ERROR_LABEL_NOT_FOUND);
+            return OBJECT_ERROR_EXPORT_UNDEFINED;
+        }
+
+        uint32_t symbol_index;
+        int status = object_add_symbol(object, index, exported->name, exported->length,
+                                       label->address, OBJECT_SYMBOL_EXPORT, &symbol_index);
+        if (status != OBJECT_SUCCESS) {
+            return status;
+        }
+    }
+
+    return OBJECT_SUCCESS;
+}
+
+// Машинный код и перемещения для инструкций со ссылками на метки
+static int object_add_relocations(ObjectFile* object, SymbolTable* index, const ParseResult* result,
+                                  const FixupList* fixups) {
+    for (int i = 0; i < fixups->count; i++) {
+        const Instruction* instruction = &result->instructions[fixups->indices[i]];
+        const Operand* target = &instruction->operands[0];
+        ObjectRelocation* relocation = &object->relocations[object->relocation_count++];
+
+        relocation->instruction_index = (uint32_t)fixups->indices[i];
+        relocation->symbol_index = 0;
+
+        if (symbol_table_find(&result->labels, target->label, target->label_length, target->label_hash)) {
+            // Метка модуля: адрес относительно начала модуля
+            relocation->kind = OBJECT_RELOC_MODULE;
+            object->code[relocation->instruction_index] = generate_machine_code(instruction, result);
+            continue;
+        }
+
+        // Внешняя метка: цель 0, адрес подставит компоновщик
+        Instruction unresolved = *instruction;
+        unresolved.operands[0].is_label_valid = 0;
+        unresolved.operands[0].immediate = 0;
+
+        relocation->kind = OBJECT_RELOC_SYMBOL;
+        object->code[relocation->instruction_index] = generate_machine_code(&unresolved, result);
+
+        int status = object_add_symbol(object, index, target->label, target->label_length, 0,
+                                       OBJECT_SYMBOL_IMPORT, &relocation->symbol_index);
+        if (status != OBJECT_SUCCESS) {
+            return status;
+        }
+    }
+
+    return OBJECT_SUCCESS;
+}
+
+int object_from_source(const char* source, size_t size, ObjectFile** out_object) {
+    if (!source || !out_object) {
+        return OBJECT_ERROR_IO;
+    }
+    *out_object = NULL;
+
+    ParseResult* result = parse_result_create();
+    if (!result) {
+        return OBJECT_ERROR_NO_MEMORY;
+    }
+
+    // Все ссылки на метки откладываются: неизвестные метки становятся импортом
+    FixupList fixups = {0};
+    if (parse_fragment(result, source, size, 0, 1, &fixups) != PARSER_SUCCESS) {
+        fixup_list_free(&fixups);
+        parse_result_free(result);
+        return OBJECT_ERROR_ASSEMBLY_FAILED;
+    }
+
+    int status = OBJECT_ERROR_NO_MEMORY;
+    SymbolTable index;
+    ObjectFile* object = object_create((uint32_t)result->instruction_count,
+                                       (uint32_t)(result->export_count + fixups.count),
+                                       (uint32_t)fixups.count);
+
+    if (object && symbol_table_init(&index) == SYMBOL_TABLE_SUCCESS) {
+        for (int i = 0; i < result->instruction_count; i++) {
+            object->code[i] = result->instructions[i].machine_code;
+        }
+
+        status = object_add_exports(object, &index, result);
+        if (status == OBJECT_SUCCESS) {
+            status = object_add_relocations(object, &index, result, &fixups);
+        }
+        symbol_table_free(&index);
+    }
+
+    fixup_list_free(&fixups);
+    parse_result_free(result);
+
+    if (status != OBJECT_SUCCESS) {
+        object_free(object);
+        return status;
+    }
+
+    *out_object = object;
+    return OBJECT_SUCCESS;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    p[0] = (value >> 24) & 0xFF;
+    p[1] = (value >> 16) & 0xFF;
+    p[2] = (value >> 8) & 0xFF;
+    p[3] = value & 0xFF;
+    return p + 4;
+}
+
+static uint8_t* put_u16(uint8_t* p, uint16_t value) {
+    p[0] = (value >> 8) & 0xFF;
+    p[1] = value & 0xFF;
+    return p + 2;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+int object_write(const ObjectFile* object, const char* filename) {
+    if (!object || !filename) {
+        return OBJECT_ERROR_IO;
+    }
+
+    size_t strings_size = 0;
+    for (uint32_t i = 0; i < object->symbol_count; i++) {
+        strings_size += object->symbols[i].name_length + 1;
+    }
+
+    size_t size = OBJECT_HEADER_SIZE + (size_t)object->instruction_count * 4 +
+                  (size_t)object->symbol_count * OBJECT_SYMBOL_SIZE +
+                  (size_t)object->relocation_count * OBJECT_RELOCATION_SIZE + strings_size;
+    uint8_t* buffer = (uint8_t*)calloc(1, size);
+    if (!buffer) {
+        return OBJECT_ERROR_NO_MEMORY;
+    }
+
+    // Заголовок
+    uint8_t* p = buffer;
+    memcpy(p, OBJECT_MAGIC, 4);
+    p = put_u16(p + 4, OBJECT_VERSION);
+    p = put_u16(p, 0);
+    p = put_u32(p, object->instruction_count);
+    p = put_u32(p, object->symbol_count);
+    p = put_u32(p, object->relocation_count);
+    p = put_u32(p, (uint32_t)strings_size);
+
+    for (uint32_t i = 0; i < object->instruction_count; i++) {
+        p = put_u32(p, object->code[i]);
+    }
+
+    // Символы и таблица строк
+    uint8_t* strings = buffer + size - strings_size;
+    uint32_t name_offset = 0;
+    for (uint32_t i = 0; i < object->symbol_count; i++) {
+        const ObjectSymbol* symbol = &object->symbols[i];
+
+        p = put_u32(p, name_offset);
+        p = put_u16(p, symbol->address);
+        p[0] = symbol->kind;
+        p += 2;
+
+        memcpy(strings + name_offset, symbol->name, symbol->name_length);
+        name_offset += symbol->name_length + 1;
+    }
+
+    for (uint32_t i = 0; i < object->relocation_count; i++) {
+        const ObjectRelocation* relocation = &object->relocations[i];
+
+        p = put_u32(p, relocation->instruction_index);
+        p = put_u32(p, relocation->symbol_index);
+        p[0] = relocation->kind;
+        p += 4;
+    }
+
+    int status = OBJECT_SUCCESS;
+    FILE* file = fopen(filename, "wb");
+    if (!file || fwrite(buffer, 1, size, file) != size) {
+        status = OBJECT_ERROR_IO;
+    }
+    if (file && fclose(file) != 0) {
+        status = OBJECT_ERROR_IO;
+    }
+
+    free(buffer);
+    return status;
+}
+
+// Разбор содержимого объектного файла с проверкой всех смещений и индексов
+static int object_decode(const uint8_t* data, size_t size, ObjectFile** out_object) {
+    if (size < OBJECT_HEADER_SIZE || memcmp(data, OBJECT_MAGIC, 4) != 0 ||
+        get_u16(data + 4) != OBJECT_VERSION) {
+        return OBJECT_ERROR_BAD_FORMAT;
+    }
+
+    uint32_t instruction_count = get_u32(data + 8);
+    uint32_t symbol_count = get_u32(data + 12);
+    uint32_t relocation_count = get_u32(data + 16);
+    uint32_t strings_size = get_u32(data + 20);
+
+    uint64_t expected = OBJECT_HEADER_SIZE + (uint64_t)instruction_count * 4 +
+                        (uint64_t)symbol_count * OBJECT_SYMBOL_SIZE +
+                        (uint64_t)relocation_count * OBJECT_RELOCATION_SIZE + strings_size;
+    if (expected != size || instruction_count > MAX_PROGRAM_INSTRUCTIONS) {
+        return OBJECT_ERROR_BAD_FORMAT;
+    }
+
+    ObjectFile* object = object_create(instruction_count, symbol_count, relocation_count);
+    if (!object) {
+        return OBJECT_ERROR_NO_MEMORY;
+    }
+
+    const uint8_t* p = data + OBJECT_HEADER_SIZE;
+    for (uint32_t i = 0; i < instruction_count; i++, p += 4) {
+        object->code[i] = get_u32(p);
+    }
+
+    const char* strings = (const char*)data + size - strings_size;
+    int status = OBJECT_SUCCESS;
+
+    for (uint32_t i = 0; i < symbol_count && status == OBJECT_SUCCESS; i++, p += OBJECT_SYMBOL_SIZE) {
+        ObjectSymbol* symbol = &object->symbols[i];
+        uint32_t name_offset = get_u32(p);
+        const char* name_end = name_offset < strings_size
+            ? memchr(strings + name_offset, '\0', strings_size - name_offset) : NULL;
+
+        symbol->address = get_u16(p + 4);
+        symbol->kind = p[6];
+        if (!name_end || name_end == strings + name_offset || symbol->kind > OBJECT_SYMBOL_IMPORT) {
+            status = OBJECT_ERROR_BAD_FORMAT;
+            break;
+        }
+
+        symbol->name_length = (uint32_t)(name_end - (strings + name_offset));
+        symbol->name = arena_strndup(&object->names, strings + name_offset, symbol->name_length);
+        if (!symbol->name) {
+            status = OBJECT_ERROR_NO_MEMORY;
+        }
+        object->symbol_count++;
+    }
+
+    for (uint32_t i = 0; i < relocation_count && status == OBJECT_SUCCESS; i++, p += OBJECT_RELOCATION_SIZE) {
+        ObjectRelocation* relocation = &object->relocations[i];
+
+        relocation->instruction_index = get_u32(p);
+        relocation->symbol_index = get_u32(p + 4);
+        relocation->kind = p[8];
+        if (relocation->instruction_index >= instruction_count || relocation->kind > OBJECT_RELOC_SYMBOL ||
+            (relocation->kind == OBJECT_RELOC_SYMBOL && relocation->symbol_index >= symbol_count)) {
+            status = OBJECT_ERROR_BAD_FORMAT;
+        }
+        object->relocation_count++;
+    }
+
+    if (status != OBJECT_SUCCESS) {
+        object_free(object);
+        return status;
+    }
+
+    *out_object = object;
+    return OBJECT_SUCCESS;
+}
+
+int object_read(const char* filename, ObjectFile** out_object) {
+    if (!filename || !out_object) {
+        return OBJECT_ERROR_IO;
+    }
+    *out_object = NULL;
+
+    SourceBuffer buffer;
+    if (source_buffer_open_file(&buffer, filename) != 0) {
+        return OBJECT_ERROR_IO;
+    }
+
+    int status = object_decode((const uint8_t*)buffer.data, buffer.size, out_object);
+    source_buffer_close(&buffer);
+
+    return status;
+}
@@ -0,0 +1,20 @@
+#ifndef PARALLEL_PARSER_H
+#define PARALLEL_PARSER_H
+
+#include "parserHeader.h"
+
+// Параллельный разбор больших исходных текстов
+#define PARALLEL_PARSER_MIN_CHUNK_SIZE (256 * 1024)  // Меньшие тексты разбираются последовательно
+#define PARALLEL_PARSER_MAX_THREADS 64
+
+// Текст делится на фрагменты по границам строк, каждый фрагмент разбирается в своём
+// потоке с адресами относительно начала фрагмента. Затем таблицы меток сливаются
+// с базовыми адресами фрагментов (префиксные суммы числа инструкций), и ссылки
+// на метки разрешаются параллельно. Машинный код совпадает с parse_buffer.
+// Сообщения фрагментов выводятся после объединения в порядке исходного текста;
+// при ошибке текст разбирается повторно через parse_buffer, поэтому сообщения
+// об ошибках также совпадают с последовательным разбором.
+// thread_count = 0 - по числу процессоров; для небольших текстов - parse_buffer.
+ParseResult* parse_buffer_parallel(const char* source, size_t size, int thread_count);
+
+#endif // PARALLEL_PARSER_H
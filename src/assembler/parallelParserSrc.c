@@ -0,0 +1,302 @@
+#include "parallelParserHeader.h"
+#include <pthread.h>
+#include <unistd.h>
+
+// Фрагмент исходного текста и его состояние на всех этапах
+typedef struct {
+    const char* source;
+    size_t size;
+    int line_base;              // Число строк до начала фрагмента
+    int line_count;             // Число '\n' во фрагменте
+    ParseResult* result;        // Результат разбора с относительными адресами
+    FixupList fixups;           // Инструкции со ссылками на метки
+    char* diagnostics;          // Сообщения парсера о фрагменте (open_memstream)
+    size_t diagnostics_length;
+    int error_code;
+    ParseResult* merged;        // Общий результат (этап разрешения)
+    int base_index;             // Индекс первой инструкции фрагмента в общем результате
+    int unresolved_index;       // Первая инструкция с неизвестной меткой (-1 - нет)
+} ParseChunk;
+
+// Этап 1: подсчёт строк для нумерации строк в сообщениях об ошибках
+static void* count_lines_worker(void* argument) {
+    ParseChunk* chunk = (ParseChunk*)argument;
+    const char* end = chunk->source + chunk->size;
+    const char* p = chunk->source;
+
+    chunk->line_count = 0;
+    while ((p = lexer_scan_newline(p, end)) < end) {
+        chunk->line_count++;
+        p++;
+    }
+
+    return NULL;
+}
+
+// Этап 2: разбор фрагмента, все ссылки на метки откладываются
+static void* parse_worker(void* argument) {
+    ParseChunk* chunk = (ParseChunk*)argument;
+
+    chunk->result = parse_result_create();
+    if (!chunk->result) {
+        chunk->error_code = PARSER_ERROR_TOO_MANY_INSTR;
+        return NULL;
+    }
+
+    // Сообщения фрагмента копятся в буфере; без буфера выводятся сразу
+    FILE* previous = parser_diagnostics();
+    FILE* stream = open_memstream(&chunk->diagnostics, &chunk->diagnostics_length);
+    if (stream) {
+        parser_set_diagnostics(stream);
+    }
+
+    chunk->error_code = parse_fragment(chunk->result, chunk->source, chunk->size,
+                                       chunk->line_base, 1, &chunk->fixups);
+
+    if (stream) {
+        parser_set_diagnostics(previous);
+        fclose(stream);
+    }
+    return NULL;
+}
+
+// Этап 3: перенос инструкций в общий результат и разрешение ссылок по общей таблице меток
+static void* resolve_worker(void* argument) {
+    ParseChunk* chunk = (ParseChunk*)argument;
+    ParseResult* merged = chunk->merged;
+    Instruction* instructions = &merged->instructions[chunk->base_index];
+    uint16_t base_address = (uint16_t)(chunk->base_index * 4);
+
+    if (chunk->result->instruction_count > 0) {
+        memcpy(instructions, chunk->result->instructions,
+               (size_t)chunk->result->instruction_count * sizeof(Instruction));
+    }
+
+    for (int i = 0; i < chunk->result->instruction_count; i++) {
+        instructions[i].address += base_address;
+    }
+
+    chunk->unresolved_index = -1;
+    for (int i = 0; i < chunk->fixups.count; i++) {
+        Instruction* instruction = &instructions[chunk->fixups.indices[i]];
+
+        if (!is_target_resolved(merged, instruction)) {
+            chunk->unresolved_index = chunk->base_index + chunk->fixups.indices[i];
+            break;
+        }
+
+        instruction->machine_code = generate_machine_code(instruction, merged);
+    }
+
+    return NULL;
+}
+
+// Запуск обработчика для всех фрагментов; первый фрагмент обрабатывается в текущем потоке
+static void run_workers(void* (*worker)(void*), ParseChunk* chunks, int chunk_count) {
+    pthread_t threads[PARALLEL_PARSER_MAX_THREADS];
+    int started[PARALLEL_PARSER_MAX_THREADS] = {0};
+
+    for (int i = 1; i < chunk_count; i++) {
+        started[i] = pthread_create(&threads[i], NULL, worker, &chunks[i]) == 0;
+        if (!started[i]) {
+            worker(&chunks[i]);  // Поток не создан - обрабатываем сами
+        }
+    }
+
+    worker(&chunks[0]);
+
+    for (int i = 1; i < chunk_count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+// Деление текста на фрагменты по границам строк
+static int split_chunks(const char* source, size_t size, int chunk_count, ParseChunk* chunks) {
+    const char* end = source + size;
+    const char* start = source;
+    int count = 0;
+
+    for (int i = 0; i < chunk_count && start < end; i++) {
+        const char* stop = end;
+        if (i < chunk_count - 1) {
+            const char* target = source + size / (size_t)chunk_count * (size_t)(i + 1);
+            if (target < start) {
+                target = start;
+            }
+            stop = lexer_scan_newline(target, end);
+            if (stop < end) {
+                stop++;  // '\n' остаётся в текущем фрагменте
+            }
+        }
+
+        memset(&chunks[count], 0, sizeof(ParseChunk));
+        chunks[count].source = start;
+        chunks[count].size = (size_t)(stop - start);
+        chunks[count].unresolved_index = -1;
+        count++;
+
+        start = stop;
+    }
+
+    return count;
+}
+
+// Слияние таблиц меток (с базовыми адресами фрагментов) и списков экспорта в порядке фрагментов
+static int merge_labels(ParseResult* merged, const ParseChunk* chunks, int chunk_count) {
+    for (int c = 0; c < chunk_count; c++) {
+        const SymbolTable* labels = &chunks[c].result->labels;
+        uint16_t base_address = (uint16_t)(chunks[c].base_index * 4);
+
+        for (int i = 0; i < labels->count; i++) {
+            const Label* label = &labels->labels[i];
+            int status = symbol_table_add(&merged->labels, label->name, label->name_length, label->hash,
+                                          (uint16_t)(label->address + base_address), NULL);
+
+            if (status == SYMBOL_TABLE_DUPLICATE) {
+                return PARSER_ERROR_LABEL_ALREADY_DEF;
+            }
+            if (status != SYMBOL_TABLE_SUCCESS) {
+                return PARSER_ERROR_TOO_MANY_LABELS;
+            }
+
+            merged->labels.labels[merged->labels.count - 1].line_number = label->line_number;
+        }
+
+        // Директивы .global - в порядке исходного текста
+        const ParseResult* result = chunks[c].result;
+        for (int i = 0; i < result->export_count; i++) {
+            const ExportedName* exported = &result->exports[i];
+            if (parse_result_add_export(merged, exported->name, exported->length,
+                                        exported->line_number) != PARSER_SUCCESS) {
+                return PARSER_ERROR_TOO_MANY_LABELS;
+            }
+        }
+    }
+
+    return PARSER_SUCCESS;
+}
+
+// Выбор числа фрагментов
+static int choose_chunk_count(size_t size, int thread_count) {
+    if (thread_count <= 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        size_t by_size = size / PARALLEL_PARSER_MIN_CHUNK_SIZE;
+
+        thread_count = processors > 0 ? (int)processors : 1;
+        if ((size_t)thread_count > by_size) {
+            thread_count = (int)by_size;
+        }
+    }
+
+    if (thread_count > PARALLEL_PARSER_MAX_THREADS) {
+        thread_count = PARALLEL_PARSER_MAX_THREADS;
+    }
+
+    return thread_count;
+}
+
+ParseResult* parse_buffer_parallel(const char* source, size_t size, int thread_count) {
+    if (!source) {
+        return NULL;
+    }
+
+    int chunk_count = choose_chunk_count(size, thread_count);
+    if (chunk_count <= 1) {
+        return parse_buffer(source, size);
+    }
+
+    ParseChunk chunks[PARALLEL_PARSER_MAX_THREADS];
+    chunk_count = split_chunks(source, size, chunk_count, chunks);
+    if (chunk_count <= 1) {
+        return parse_buffer(source, size);
+    }
+
+    // Нумерация строк: префиксные суммы числа строк фрагментов
+    run_workers(count_lines_worker, chunks, chunk_count);
+    for (int c = 1; c < chunk_count; c++) {
+        chunks[c].line_base = chunks[c - 1].line_base + chunks[c - 1].line_count;
+    }
+
+    run_workers(parse_worker, chunks, chunk_count);
+
+    int error_code = PARSER_SUCCESS;
+    for (int c = 0; c < chunk_count && error_code == PARSER_SUCCESS; c++) {
+        error_code = chunks[c].error_code;
+    }
+
+    // Базовые индексы фрагментов: префиксные суммы числа инструкций
+    int total = 0;
+    for (int c = 0; c < chunk_count && error_code == PARSER_SUCCESS; c++) {
+        chunks[c].base_index = total;
+        total += chunks[c].result->instruction_count;
+    }
+
+    if (error_code == PARSER_SUCCESS && total > MAX_PROGRAM_INSTRUCTIONS) {
+        error_code = PARSER_ERROR_TOO_MANY_INSTR;
+    }
+
+    ParseResult* merged = NULL;
+    if (error_code == PARSER_SUCCESS) {
+        merged = parse_result_create();
+        if (merged && total > 0) {
+            merged->instructions = (Instruction*)malloc((size_t)total * sizeof(Instruction));
+            if (merged->instructions) {
+                merged->instruction_count = total;
+                merged->instruction_capacity = total;
+            }
+        }
+        if (!merged || (total > 0 && !merged->instructions)) {
+            error_code = PARSER_ERROR_TOO_MANY_INSTR;
+        }
+    }
+
+    if (error_code == PARSER_SUCCESS) {
+        error_code = merge_labels(merged, chunks, chunk_count);
+    }
+
+    if (error_code == PARSER_SUCCESS) {
+        for (int c = 0; c < chunk_count; c++) {
+            chunks[c].merged = merged;
+        }
+        run_workers(resolve_worker, chunks, chunk_count);
+
+        for (int c = 0; c < chunk_count; c++) {
+            if (chunks[c].unresolved_index >= 0) {
+                error_code = PARSER_ERROR_LABEL_NOT_FOUND;
+                break;
+            }
+        }
+    }
+
+    // Сообщения фрагментов (предупреждения) - в порядке исходного текста
+    if (error_code == PARSER_SUCCESS) {
+        for (int c = 0; c < chunk_count; c++) {
+            if (chunks[c].diagnostics_length > 0) {
+                fwrite(chunks[c].diagnostics, 1, chunks[c].diagnostics_length, parser_diagnostics());
+            }
+        }
+    }
+
+    // Имена меток в операндах интернированы в таблицах меток фрагментов
+    for (int c = 0; c < chunk_count; c++) {
+        if (merged && chunks[c].result) {
+            arena_adopt(&merged->arena, &chunks[c].result->labels.names);
+        }
+        parse_result_free(chunks[c].result);
+        fixup_list_free(&chunks[c].fixups);
+        free(chunks[c].diagnostics);
+    }
+
+    // Ошибка в любом фрагменте: текст разбирается заново последовательно. Сообщения
+    // фрагментов отбрасываются, и parse_buffer выводит первую ошибку в порядке
+    // исходного текста (вместе с предшествующими ей предупреждениями) так же,
+    // как без параллельного разбора.
+    if (error_code != PARSER_SUCCESS) {
+        parse_result_free(merged);
+        return parse_buffer(source, size);
+    }
+
+    return merged;
+}
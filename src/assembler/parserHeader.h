@@ -6,13 +6,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "arenaHeader.h"
+#include "isaHeader.h"
+#include "lexerHeader.h"
+#include "symbolTableHeader.h"
 
 // Максимальные размеры
-#define MAX_LINE_LENGTH 256
-#define MAX_TOKENS 32
-#define MAX_TOKEN_LENGTH 64
-#define MAX_LABELS 256
-#define MAX_INSTRUCTION_COUNT 1024
+#define MAX_PROGRAM_INSTRUCTIONS 16384  // 64KB адресного пространства / 4 байта на инструкцию
 
 // Коды ошибок парсера
 typedef enum {
@@ -39,6 +39,11 @@ extern const char* ParserErrorMessages[PARSER_ERROR_COUNT];
 // Функция извлечения имени файла из пути
 const char* get_filename(const char* path);
 
+// Поток сообщений парсера в текущем потоке (по умолчанию stderr). Параллельный
+// разбор собирает сообщения фрагментов в буферы и выводит их после объединения.
+FILE* parser_diagnostics(void);
+void parser_set_diagnostics(FILE* stream);  // NULL - stderr
+
 // Макрос для проверки условия и возврата кода ошибки
 #define RETURN_ERROR_IF(condition, error_code) \
 do { \
@@ -61,8 +66,8 @@ return _err; \
 do { \
 int _err = (error_code); \
 if (_err != PARSER_SUCCESS) { \
-fprintf(stderr, __VA_ARGS__); \
-fprintf(stderr, " Error: %s (%d).\nFile: %s, line: %d.\n", \
+fprintf(parser_diagnostics(), __VA_ARGS__); \
+fprintf(parser_diagnostics(), " Error: %s (%d).\nFile: %s, line: %d.\n", \
 ParserErrorMessages[_err], _err, get_filename(__FILE__), __LINE__); \
 return _err; \
 } \
@@ -82,59 +87,31 @@ typedef enum {
     TOKEN_EOF
 } TokenType;
 
-// Коды операций
-typedef enum {
-    OPC_NOP = 0x00,
-    OPC_ADD = 0x01,
-    OPC_SUB = 0x02,
-    OPC_MUL = 0x03,
-    OPC_DIV = 0x04,
-    OPC_CMPGE = 0x05,
-    OPC_RSHFT = 0x06,
-    OPC_LSHFT = 0x07,
-    OPC_AND = 0x08,
-    OPC_OR = 0x09,
-    OPC_XOR = 0x0A,
-    OPC_LD = 0x0B,
-    OPC_SET_CONST = 0x0C,
-    OPC_ST = 0x0D,
-    OPC_BNZ = 0x0E,
-    OPC_READY = 0x0F
-} OpCode;
-
-// Форматы команд
-typedef enum {
-    FORMAT_F1,  // opc[7:0], src_0[7:0],  src_1[7:0],   dst[7:0]
-    FORMAT_F2,  // opc[7:0], const[15:8], const[7:0],   dst[7:0]
-    FORMAT_F3,  // opc[7:0], src_0[7:0],  src_1[7:0],   src_2[7:0]
-    FORMAT_F4   // opc[7:0], src_0[7:0],  target[15:8], target[7:0]
-} InstructionFormat;
-
-// Структура токена
+// Структура токена: ссылка на исходный текст без копирования
 typedef struct {
     TokenType type;
-    char value[MAX_TOKEN_LENGTH];
+    const char* text;         // Начало токена в исходном тексте (без завершающего нуля)
+    uint32_t length;          // Длина токена
+    uint32_t offset;          // Смещение токена от начала исходного текста
     int line_number;
-    unsigned long position;
+    unsigned long position;   // Позиция токена в строке
 } Token;
 
-// Структура метки
-typedef struct {
-    char name[MAX_TOKEN_LENGTH];
-    uint16_t address;
-} Label;
-
-// Структура для хранения результатов токенизации
+// Структура для хранения результатов токенизации.
+// Массив токенов растёт по необходимости и переиспользуется между строками.
 typedef struct {
-    Token tokens[MAX_TOKENS];
+    Token* tokens;
     int token_count;
+    int token_capacity;
 } TokenizationResult;
 
 // Структура операнда
 typedef struct {
     uint8_t reg_num;      // Номер регистра
     uint16_t immediate;   // Непосредственное значение
-    char label[MAX_TOKEN_LENGTH];  // Имя метки (если используется)
+    const char* label;    // Имя метки (если используется), интернировано в таблице меток ParseResult
+    uint32_t label_length; // Длина имени метки
+    uint32_t label_hash;  // Предвычисленный хеш имени метки
     int is_memory_access; // Флаг доступа к памяти [reg+reg]
     int is_reg_valid;     // Флаг валидности номера регистра
     int is_immediate_valid; // Флаг валидности непосредственного значения
@@ -149,29 +126,67 @@ typedef struct {
     uint16_t address;     // Адрес инструкции в памяти
     uint32_t machine_code; // Машинный код инструкции
     int operand_count;    // Количество операндов
+    int line_number;      // Строка исходного файла
 } Instruction;
 
-// Структура, представляющая результат парсинга ассемблерного файла
+// Директива экспорта метки из модуля
+#define DIRECTIVE_GLOBAL ".global"
+
+// Метка, объявленная директивой .global
+typedef struct {
+    const char* name;            // Имя (хранится в арене ParseResult)
+    uint32_t length;
+    int line_number;             // Строка директивы
+} ExportedName;
+
+// Структура, представляющая результат парсинга ассемблерного файла.
+// Создаётся в куче (parse_result_create), освобождается parse_result_free.
 typedef struct {
-    Instruction instructions[MAX_INSTRUCTION_COUNT];
+    Arena arena;                 // Арена для имён из директив .global и имён фрагментов параллельного разбора
+    Instruction* instructions;   // Растущий массив инструкций
     int instruction_count;
-    Label labels[MAX_LABELS];
-    int label_count;
+    int instruction_capacity;
+    SymbolTable labels;          // Хеш-таблица меток
+    ExportedName* exports;       // Метки из директив .global (в порядке объявления)
+    int export_count;
+    int export_capacity;
 } ParseResult;
 
+// Инструкции, машинный код которых ждёт разрешения меток
+typedef struct {
+    int* indices;               // Индексы инструкций в ParseResult
+    int count;
+    int capacity;
+} FixupList;
+
 // Функции для работы с токенами
-TokenizationResult tokenize_line(const char* line, int line_number);
+int tokenize_line(TokenizationResult* result, const char* line, size_t length,
+                  int line_number, uint32_t line_offset);
+void tokenization_result_free(TokenizationResult* result);
 void print_token(const Token* token);
 void print_all_tokens(const TokenizationResult* result);
 
 // Функции для работы с метками
-int add_label(ParseResult* result, const char* name, uint16_t address);
+int add_label(ParseResult* result, const char* name, size_t length, uint16_t address);
 uint16_t get_label_address(const ParseResult* result, const char* name);
 
 // Функции для парсинга
-ParseResult parse_file(const char* filename);
+ParseResult* parse_file(const char* filename);
+ParseResult* parse_stream(FILE* stream);
+ParseResult* parse_buffer(const char* source, size_t size);
+int parse_fragment(ParseResult* result, const char* source, size_t size, int line_base,
+                   int defer_labels, FixupList* fixups);
+int parse_result_add_export(ParseResult* result, const char* name, size_t length, int line_number);
+int fixup_list_add(FixupList* fixups, int instruction_index);
+void fixup_list_free(FixupList* fixups);
+int is_target_resolved(const ParseResult* result, const Instruction* instruction);
+void report_parse_error(const char* message, int line_number, int error_code);
+ParseResult* parse_result_create(void);
+void parse_result_free(ParseResult* result);
+Instruction* parse_result_new_instruction(ParseResult* result);
 int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* token_idx, uint16_t current_address);
 OpCode get_opcode_from_mnemonic(const char* mnemonic);
+OpCode get_opcode_from_span(const char* mnemonic, size_t length);
 InstructionFormat get_format_from_opcode(OpCode opcode);
 int parse_operand(TokenizationResult* tokens, int* token_idx, Operand* operand);
 int parse_register(const Token* token, Operand* operand);
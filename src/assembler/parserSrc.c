@@ -1,4 +1,5 @@
 #include "parserHeader.h"
+#include "parallelParserHeader.h"
 
 const char* ParserErrorMessages[PARSER_ERROR_COUNT] = {
     "Success",                        // PARSER_SUCCESS
@@ -23,167 +24,141 @@ const char* get_filename(const char* path) {
     return filename + 1;
 }
 
-// Токенизация строки ассемблерного кода
-TokenizationResult tokenize_line(const char* line, int line_number) {
-    TokenizationResult result = {0};
-    char buffer[MAX_LINE_LENGTH] = {0};
-    strncpy(buffer, line, MAX_LINE_LENGTH - 1);
-    
-    // Удаление комментариев
-    char* comment = strchr(buffer, ';');
-    if (comment) {
-        *comment = '\0';
+static _Thread_local FILE* parser_diagnostic_stream = NULL;
+
+FILE* parser_diagnostics(void) {
+    return parser_diagnostic_stream ? parser_diagnostic_stream : stderr;
+}
+
+void parser_set_diagnostics(FILE* stream) {
+    parser_diagnostic_stream = stream;
+}
+
+// Добавление токена в растущий массив
+static Token* tokenization_result_push(TokenizationResult* result) {
+    if (result->token_count == result->token_capacity) {
+        int new_capacity = result->token_capacity ? result->token_capacity * 2 : 16;
+        Token* grown = (Token*)realloc(result->tokens, (size_t)new_capacity * sizeof(Token));
+        if (!grown) {
+            return NULL;
+        }
+        result->tokens = grown;
+        result->token_capacity = new_capacity;
     }
     
-    // Обрабатываем квадратные скобки и запятые как отдельные токены
-    char processed_buffer[MAX_LINE_LENGTH * 3] = {0};  // В худшем случае будет в 3 раза больше символов
-    int proc_pos = 0;
+    return &result->tokens[result->token_count++];
+}
+
+// Определение типа токена по его тексту
+static TokenType classify_token(const char* text, size_t length) {
+    if (text[length - 1] == ':') {
+        return TOKEN_LABEL;
+    }
     
-    for (int i = 0; buffer[i] != '\0'; i++) {
-        if (buffer[i] == '[' || buffer[i] == ']' || buffer[i] == ',') {
-            // Добавляем пробел перед спецсимволом, если перед ним не пробел
-            if (i > 0 && buffer[i-1] != ' ' && buffer[i-1] != '\t') {
-                processed_buffer[proc_pos++] = ' ';
+    if (text[0] == 'R' && length > 1 && isdigit((unsigned char)text[1])) {
+        // Регистр (Rn), только если после 'R' следуют одни цифры
+        for (size_t i = 2; i < length; i++) {
+            if (!isdigit((unsigned char)text[i])) {
+                return TOKEN_IDENTIFIER;
             }
-            
-            // Добавляем специальный символ
-            processed_buffer[proc_pos++] = buffer[i];
-            
-            // Добавляем пробел после спецсимвола, если после него не пробел или не конец строки
-            if (buffer[i+1] != '\0' && buffer[i+1] != ' ' && buffer[i+1] != '\t') {
-                processed_buffer[proc_pos++] = ' ';
-            }
-        } else {
-            processed_buffer[proc_pos++] = buffer[i];
         }
+        return TOKEN_REGISTER;
     }
     
-    // Теперь разбиваем строку на токены с помощью пробелов
-    char* token_str = strtok(processed_buffer, " \t\n\r");
-    unsigned long position = 0;
+    if (isdigit((unsigned char)text[0]) ||
+        (length > 1 && text[0] == '-' && isdigit((unsigned char)text[1]))) {
+        // Числовое значение (включая 0x...)
+        return TOKEN_IMMEDIATE;
+    }
     
-    while (token_str && result.token_count < MAX_TOKENS) {
-        Token *token = &result.tokens[result.token_count];
-        token->line_number = line_number;
-        token->position = position;
-        position += strlen(token_str) + 1;
-        
-        // Определение типа токена
-        const unsigned long token_len = strlen(token_str);
-        
-        if (token_len == 0) {
-            continue;  // Пропускаем пустые токены
-        }
-        
-        if (token_str[token_len - 1] == ':') {
-            // Метка
-            token_str[token_len - 1] = '\0';  // Удаляем ':'
-            token->type = TOKEN_LABEL;
-        } else if (token_str[0] == 'R' && isdigit(token_str[1])) {
-            // Проверяем, что после 'R' следуют только цифры
-            int is_valid_register = 1;
-            for (int i = 1; token_str[i] != '\0'; i++) {
-                if (!isdigit(token_str[i])) {
-                    is_valid_register = 0;
+    if (get_opcode_from_span(text, length) != (OpCode)0xFF) {
+        return TOKEN_INSTRUCTION;
+    }
+    
+    if (length == 1) {
+        switch (text[0]) {
+            case '[': return TOKEN_LBRACKET;
+            case ']': return TOKEN_RBRACKET;
+            case ',': return TOKEN_COMMA;
+            default: break;
+        }
+    }
+    
+    return TOKEN_IDENTIFIER;
+}
+
+// Токенизация строки ассемблерного кода (комментарий уже отброшен лексером).
+// Токены ссылаются на исходный текст, массив токенов переиспользуется.
+int tokenize_line(TokenizationResult* result, const char* line, size_t length,
+                  int line_number, uint32_t line_offset) {
+    result->token_count = 0;
+    
+    size_t i = 0;
+    while (i < length) {
+        char c = line[i];
+        
+        // Разделители
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            i++;
+            continue;
+        }
+        
+        // Квадратные скобки и запятые - отдельные токены
+        size_t start = i;
+        if (c == '[' || c == ']' || c == ',') {
+            i++;
+        } else {
+            while (i < length) {
+                c = line[i];
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '[' || c == ']' || c == ',') {
                     break;
                 }
+                i++;
             }
-            
-            if (is_valid_register) {
-                // Регистр (Rn)
-                token->type = TOKEN_REGISTER;
-            } else {
-                // Невалидный регистр, маркируем как идентификатор
-                token->type = TOKEN_IDENTIFIER;
-            }
-        } else if (isdigit(token_str[0]) || (token_str[0] == '-' && isdigit(token_str[1])) ||
-                  (token_str[0] == '0' && token_str[1] == 'x')) {
-            // Числовое значение
-            token->type = TOKEN_IMMEDIATE;
-        } else if (get_opcode_from_mnemonic(token_str) != (OpCode)0xFF) {
-            // Инструкция
-            token->type = TOKEN_INSTRUCTION;
-        } else if (token_len == 1) {
-            switch (token_str[0]) {
-                case '[':
-                    token->type = TOKEN_LBRACKET;
-                    break;
-                case ']':
-                    token->type = TOKEN_RBRACKET;
-                    break;
-                case ',':
-                    token->type = TOKEN_COMMA;
-                    break;
-                default:
-                    token->type = TOKEN_IDENTIFIER;
-                    break;
-            }
-        } else {
-            token->type = TOKEN_IDENTIFIER;
         }
-
-        // Копируем значение токена вне зависимости от его типа
-        strncpy(token->value, token_str, MAX_TOKEN_LENGTH - 1);
         
-        result.token_count++;
-        token_str = strtok(NULL, " \t\n\r");
+        Token* token = tokenization_result_push(result);
+        RETURN_ERROR_IF(!token, PARSER_ERROR_INVALID_INSTRUCTION);
+        
+        size_t token_length = i - start;
+        token->type = classify_token(line + start, token_length);
+        token->text = line + start;
+        token->length = (uint32_t)(token->type == TOKEN_LABEL ? token_length - 1 : token_length);  // Без ':'
+        token->offset = line_offset + (uint32_t)start;
+        token->line_number = line_number;
+        token->position = start;
     }
     
-    return result;
+    return PARSER_SUCCESS;
+}
+
+// Освобождение массива токенов
+void tokenization_result_free(TokenizationResult* result) {
+    free(result->tokens);
+    result->tokens = NULL;
+    result->token_count = 0;
+    result->token_capacity = 0;
+}
+
+// Получение кода операции из мнемоники, заданной началом и длиной
+OpCode get_opcode_from_span(const char* mnemonic, size_t length) {
+    const IsaInstruction* isa = isa_lookup_mnemonic(mnemonic, length);
+    return isa ? (OpCode)isa->opcode : (OpCode)0xFF;  // Неизвестная инструкция - используем значение 0xFF
 }
 
 // Получение кода операции из мнемоники
 OpCode get_opcode_from_mnemonic(const char* mnemonic) {
-    if (strcmp(mnemonic, "nop") == 0) return OPC_NOP;
-    else if (strcmp(mnemonic, "add") == 0) return OPC_ADD;
-    else if (strcmp(mnemonic, "sub") == 0) return OPC_SUB;
-    else if (strcmp(mnemonic, "mul") == 0) return OPC_MUL;
-    else if (strcmp(mnemonic, "div") == 0) return OPC_DIV;
-    else if (strcmp(mnemonic, "cmpge") == 0) return OPC_CMPGE;
-    else if (strcmp(mnemonic, "rshft") == 0) return OPC_RSHFT;
-    else if (strcmp(mnemonic, "lshft") == 0) return OPC_LSHFT;
-    else if (strcmp(mnemonic, "and") == 0) return OPC_AND;
-    else if (strcmp(mnemonic, "or") == 0) return OPC_OR;
-    else if (strcmp(mnemonic, "xor") == 0) return OPC_XOR;
-    else if (strcmp(mnemonic, "ld") == 0) return OPC_LD;
-    else if (strcmp(mnemonic, "set_const") == 0) return OPC_SET_CONST;
-    else if (strcmp(mnemonic, "st") == 0) return OPC_ST;
-    else if (strcmp(mnemonic, "bnz") == 0) return OPC_BNZ;
-    else if (strcmp(mnemonic, "ready") == 0) return OPC_READY;
-    else return (OpCode)0xFF;  // Неизвестная инструкция - используем значение 0xFF
+    return get_opcode_from_span(mnemonic, strlen(mnemonic));
 }
 
 // Получение формата инструкции по коду операции
 InstructionFormat get_format_from_opcode(OpCode opcode) {
-    switch (opcode) {
-        case OPC_NOP:
-        case OPC_ADD:
-        case OPC_SUB:
-        case OPC_MUL:
-        case OPC_DIV:
-        case OPC_CMPGE:
-        case OPC_RSHFT:
-        case OPC_LSHFT:
-        case OPC_AND:
-        case OPC_OR:
-        case OPC_XOR:
-        case OPC_LD:
-            return FORMAT_F1;  // F1: opc[7:0], src_0[7:0], src_1[7:0], dst[7:0]
-            
-        case OPC_SET_CONST:
-            return FORMAT_F2;  // F2: opc[7:0], const[15:8], const[7:0], dst[7:0]
-            
-        case OPC_ST:
-            return FORMAT_F3;  // F3: opc[7:0], src_0[7:0], src_1[7:0], src_2[7:0]
-            
-        case OPC_BNZ:
-        case OPC_READY:
-            return FORMAT_F4;  // F4: opc[7:0], src_0[7:0], target[15:8], target[7:0]
-            
-        default:
-            fprintf(stderr, "Unknown opcode format: %d\n", opcode);
-            return (InstructionFormat)0xFF;  // Используем значение 0xFF для неизвестного формата
+    const IsaInstruction* isa = isa_lookup_opcode(opcode);
+    if (!(isa->flags & ISA_FLAG_VALID)) {
+        fprintf(parser_diagnostics(), "Unknown opcode format: %d\n", opcode);
+        return (InstructionFormat)0xFF;  // Используем значение 0xFF для неизвестного формата
     }
+    return isa->format;
 }
 
 // Парсинг регистра
@@ -193,27 +168,33 @@ int parse_register(const Token* token, Operand* operand) {
         // Дополнительная проверка для строк вида "Ra", "Rb" и т.д.,
         // которые могут быть распознаны как идентификаторы
         if (token->type == TOKEN_IDENTIFIER && 
-            token->value[0] == 'R' && 
-            token->value[1] != '\0') {
-            fprintf(stderr, "Invalid register format: %s (must be R0-R15)\n", token->value);
+            token->text[0] == 'R' && 
+            token->length > 1) {
+            fprintf(parser_diagnostics(), "Invalid register format: %.*s (must be R0-R15)\n", (int)token->length, token->text);
             return PARSER_ERROR_INVALID_REGISTER;
         }
         return PARSER_ERROR_INVALID_REGISTER;
     }
 
     // Строковый анализ - ищем "R" и числовое значение
-    if (token->value[0] != 'R' || strlen(token->value) < 2) {
-        fprintf(stderr, "Invalid register format: %s (must be R0-R15)\n", token->value);
+    if (token->length < 2 || token->text[0] != 'R') {
+        fprintf(parser_diagnostics(), "Invalid register format: %.*s (must be R0-R15)\n", (int)token->length, token->text);
         return PARSER_ERROR_INVALID_REGISTER;
     }
 
-    // Парсинг номера регистра из Rn
-    char* endptr;
-    long reg_num = strtol(token->value + 1, &endptr, 10);  // Пропускаем 'R', основание 10
+    // Парсинг номера регистра из Rn (без выхода за границы токена)
+    long reg_num = 0;
+    for (uint32_t i = 1; i < token->length; i++) {
+        if (!isdigit((unsigned char)token->text[i]) || reg_num > 15) {
+            reg_num = -1;
+            break;
+        }
+        reg_num = reg_num * 10 + (token->text[i] - '0');
+    }
 
     // Проверка валидности номера регистра
-    if (*endptr != '\0' || reg_num < 0 || reg_num > 15) {
-        fprintf(stderr, "Invalid register number: %s (must be R0-R15)\n", token->value);
+    if (reg_num < 0 || reg_num > 15) {
+        fprintf(parser_diagnostics(), "Invalid register number: %.*s (must be R0-R15)\n", (int)token->length, token->text);
         return PARSER_ERROR_INVALID_REGISTER;
     }
 
@@ -224,6 +205,44 @@ int parse_register(const Token* token, Operand* operand) {
     return PARSER_SUCCESS;  // Успешный парсинг
 }
 
+// Разбор числа заданной длины; значения больше 0x10000 по модулю насыщаются.
+// Возвращает 0, если встретились недопустимые символы или нет цифр.
+static int parse_number_span(const char* text, size_t length, int base, long* value) {
+    size_t i = 0;
+    int negative = 0;
+    
+    if (base == 10 && i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        i++;
+    }
+    
+    if (i == length) {
+        return 0;
+    }
+    
+    long result = 0;
+    for (; i < length; i++) {
+        char c = text[i];
+        int digit;
+        
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (base == 16 && c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (base == 16 && c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return 0;
+        }
+        
+        if (result <= 0x10000) {
+            result = result * base + digit;
+        }
+    }
+    
+    *value = negative ? -result : result;
+    return 1;
+}
 
 // Парсинг непосредственного значения
 int parse_immediate(const Token* token, Operand* operand) {
@@ -233,32 +252,28 @@ int parse_immediate(const Token* token, Operand* operand) {
     
     if (token->type == TOKEN_IMMEDIATE) {
         // Преобразование строки в число
-        char* endptr;
         long value;
         
-        if (strncmp(token->value, "0x", 2) == 0) {
-            // Шестнадцатеричное значение
-            value = strtol(token->value + 2, &endptr, 16);
-            
-            // Проверяем, что все символы шестнадцатеричные
-            if (*endptr != '\0') {
-                fprintf(stderr, "Invalid hexadecimal format: %s (contains non-hex characters)\n", token->value);
+        if (token->length >= 2 && token->text[0] == '0' && token->text[1] == 'x') {
+            // Шестнадцатеричное значение, проверяем, что все символы шестнадцатеричные
+            if (!parse_number_span(token->text + 2, token->length - 2, 16, &value)) {
+                fprintf(parser_diagnostics(), "Invalid hexadecimal format: %.*s (contains non-hex characters)\n",
+                        (int)token->length, token->text);
                 return PARSER_ERROR_INVALID_IMMEDIATE;
             }
         } else {
-            // Десятичное значение
-            value = strtol(token->value, &endptr, 10);
-            
-            // Проверяем, что все символы десятичные
-            if (*endptr != '\0') {
-                fprintf(stderr, "Invalid decimal format: %s (contains non-decimal characters)\n", token->value);
+            // Десятичное значение, проверяем, что все символы десятичные
+            if (!parse_number_span(token->text, token->length, 10, &value)) {
+                fprintf(parser_diagnostics(), "Invalid decimal format: %.*s (contains non-decimal characters)\n",
+                        (int)token->length, token->text);
                 return PARSER_ERROR_INVALID_IMMEDIATE;
             }
         }
         
         // Проверка диапазона числа (должно быть 16-битным)
         if (value < -32768 || value > 65535) {
-            fprintf(stderr, "Immediate value out of range: %s (must be 16-bit: -32768 to 65535)\n", token->value);
+            fprintf(parser_diagnostics(), "Immediate value out of range: %.*s (must be 16-bit: -32768 to 65535)\n",
+                    (int)token->length, token->text);
             return PARSER_ERROR_INVALID_IMMEDIATE;
         }
         
@@ -266,8 +281,11 @@ int parse_immediate(const Token* token, Operand* operand) {
         operand->immediate = (uint16_t)value;
         operand->is_immediate_valid = 1;
     } else {
-        // Идентификатор (метка для последующего разрешения)
-        strncpy(operand->label, token->value, MAX_TOKEN_LENGTH - 1);
+        // Идентификатор (метка для последующего разрешения).
+        // Имя ссылается на исходный текст, parse_instruction копирует его в арену результата.
+        operand->label = token->text;
+        operand->label_length = token->length;
+        operand->label_hash = symbol_hash(operand->label, operand->label_length);
         operand->is_label_valid = 1;
     }
     
@@ -284,7 +302,8 @@ int parse_memory_access(TokenizationResult* tokens, int* token_idx, Operand* ope
     #ifdef DEBUG_PARSER
     printf("parse_memory_access: token_idx=%d, token_count=%d\n", *token_idx, tokens->token_count);
     for (int i = 0; i < tokens->token_count; i++) {
-        printf("Token %d: type=%d, value=%s\n", i, tokens->tokens[i].type, tokens->tokens[i].value);
+        printf("Token %d: type=%d, value=%.*s\n", i, tokens->tokens[i].type,
+               (int)tokens->tokens[i].length, tokens->tokens[i].text);
     }
     #endif
     
@@ -441,15 +460,15 @@ int parse_operand(TokenizationResult* tokens, int* token_idx, Operand* operand)
         // но не являющийся правильным регистром, возвращаем ошибку
         if (operand->is_label_valid) {
             // Проверяем формат 'Rx', где x - не число
-            if (operand->label[0] == 'R' && operand->label[1] != '\0') {
+            if (operand->label[0] == 'R' && operand->label_length > 1) {
                 return PARSER_ERROR_INVALID_REGISTER;
             }
             
             // Проверяем случайные символы, которые не могут быть метками
             int is_valid_label = 1;
-            for (int i = 0; operand->label[i] != '\0'; i++) {
+            for (uint32_t i = 0; i < operand->label_length; i++) {
                 char c = operand->label[i];
-                if (!(isalnum(c) || c == '_')) {
+                if (!(isalnum((unsigned char)c) || c == '_')) {
                     is_valid_label = 0;
                     break;
                 }
@@ -473,30 +492,29 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
     // Проверка границ
     RETURN_ERROR_IF(*token_idx >= tokens->token_count, PARSER_ERROR_INVALID_INSTRUCTION);
     
-    // Проверка, не превышено ли максимальное количество инструкций
-    PRINT_ERROR_IF(result->instruction_count >= MAX_INSTRUCTION_COUNT, 
-                  "Too many instructions (max %d)\n", MAX_INSTRUCTION_COUNT);
+    // Проверка, не исчерпано ли адресное пространство инструкций
+    PRINT_ERROR_IF(result->instruction_count >= MAX_PROGRAM_INSTRUCTIONS ? PARSER_ERROR_TOO_MANY_INSTR : PARSER_SUCCESS, 
+                  "Too many instructions (max %d)\n", MAX_PROGRAM_INSTRUCTIONS);
     
     Token* token = &tokens->tokens[*token_idx];
     
     // Проверяем, является ли токен инструкцией
     RETURN_ERROR_IF(token->type != TOKEN_INSTRUCTION, PARSER_ERROR_INVALID_INSTRUCTION);
     
-    // Получаем код операции и формат
-    OpCode opcode = get_opcode_from_mnemonic(token->value);
-    if (opcode == (OpCode)0xFF) {
-        fprintf(stderr, "Unknown instruction: %s\n", token->value);
+    // Описание команды из таблицы ISA
+    const IsaInstruction* isa = isa_lookup_mnemonic(token->text, token->length);
+    if (!isa) {
+        fprintf(parser_diagnostics(), "Unknown instruction: %.*s\n", (int)token->length, token->text);
         return PARSER_ERROR_INVALID_INSTRUCTION;
     }
     
-    InstructionFormat format = get_format_from_opcode(opcode);
-    if (format == (InstructionFormat)0xFF) {
-        fprintf(stderr, "Unknown instruction format for opcode: %d\n", opcode);
-        return PARSER_ERROR_INVALID_FORMAT;
-    }
+    OpCode opcode = (OpCode)isa->opcode;
+    InstructionFormat format = isa->format;
     
     // Создаем новую инструкцию
-    Instruction* instr = &result->instructions[result->instruction_count];
+    Instruction* instr = parse_result_new_instruction(result);
+    PRINT_ERROR_IF(instr ? PARSER_SUCCESS : PARSER_ERROR_TOO_MANY_INSTR,
+                  "Failed to grow instruction array (%d instructions)\n", result->instruction_count);
     instr->opcode = opcode;
     instr->format = format;
     instr->address = current_address;
@@ -505,30 +523,16 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
     // Переходим к следующему токену (после инструкции)
     (*token_idx)++;
     
-    // Парсинг операндов
-    int max_operands = 0;
-    switch (format) {
-        case FORMAT_F1: max_operands = 3; break;  // src0, src1, dst
-        case FORMAT_F2: max_operands = 2; break;  // const, dst
-        case FORMAT_F3: max_operands = 3; break;  // src0, src1, src2
-        case FORMAT_F4: max_operands = 2; break;  // target, src0
-    }
-    
-    // Специальный случай для nop и ready, которые не имеют операндов
-    if (opcode == OPC_NOP || opcode == OPC_READY) {
-        max_operands = 0;
-    }
-    
-    // clang-tidy: Недостижимый код
-    // После этих проверок код может быть недостижим для определенных опкодов
+    // Количество и виды операндов задаются таблицей ISA
+    int max_operands = isa->operand_count;
     
     // Парсинг операндов
     for (int i = 0; i < max_operands; i++) {
         int error_code;
         
-        // Специальная обработка для инструкции set_const, где первый операнд - непосредственное значение
-        if (format == FORMAT_F2 && i == 0) {
-            // Парсим непосредственное значение напрямую
+        // Непосредственное значение (первый операнд set_const) разбирается напрямую
+        if (isa->operands[i].kind == ISA_OPERAND_IMMEDIATE) {
+            RETURN_ERROR_IF(*token_idx >= tokens->token_count, PARSER_ERROR_TOO_FEW_OPERANDS);
             Token* immediate_token = &tokens->tokens[*token_idx];
             
             // Инициализируем операнд
@@ -536,8 +540,8 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
             
             // Проверяем, что токен это непосредственное значение
             if (immediate_token->type != TOKEN_IMMEDIATE && immediate_token->type != TOKEN_IDENTIFIER) {
-                fprintf(stderr, "Expected immediate value for the first operand of set_const, got %d\n", 
-                        immediate_token->type);
+                fprintf(parser_diagnostics(), "Expected immediate value for operand %d of %.*s, got %d\n", i + 1,
+                        (int)token->length, token->text, immediate_token->type);
                 return PARSER_ERROR_INVALID_IMMEDIATE;
             }
             
@@ -553,8 +557,8 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
                 } else {
                     // Запятая не обнаружена, но это не фатальная ошибка
                     // Некоторые синтаксисы ассемблера могут не требовать запятую между операндами
-                    fprintf(stderr, "Warning: No comma found after first operand for set_const instruction at line %d\n", 
-                            tokens->tokens[0].line_number);
+                    fprintf(parser_diagnostics(), "Warning: No comma found after operand %d for %.*s instruction at line %d\n", i + 1,
+                            (int)token->length, token->text, tokens->tokens[0].line_number);
                 }
             }
         } else {
@@ -572,22 +576,28 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
         }
         
         if (error_code != PARSER_SUCCESS) {
-            // clang-tidy: это выражение может быть всегда истинно для определенных опкодов
-            if (i == 0 && (opcode == OPC_NOP || opcode == OPC_READY)) {
-                // Для nop и ready операнды не требуются
-                break;
-            }
-            
             // Выводим сообщение об ошибке и возвращаем код ошибки
             if (i == 0) {
-                fprintf(stderr, "Failed to parse first operand for instruction %s\n", token->value);
+                fprintf(parser_diagnostics(), "Failed to parse first operand for instruction %.*s\n",
+                        (int)token->length, token->text);
             } else if (i == max_operands - 1) {
-                fprintf(stderr, "Failed to parse last operand for instruction %s\n", token->value);
+                fprintf(parser_diagnostics(), "Failed to parse last operand for instruction %.*s\n",
+                        (int)token->length, token->text);
             } else {
-                fprintf(stderr, "Failed to parse operand %d for instruction %s\n", i + 1, token->value);
+                fprintf(parser_diagnostics(), "Failed to parse operand %d for instruction %.*s\n", i + 1,
+                        (int)token->length, token->text);
             }
             return error_code;
         }
+        
+        // Имя метки из исходного текста заменяется интернированным в таблице меток
+        Operand* parsed = &instr->operands[i];
+        if (parsed->is_label_valid) {
+            parsed->label = symbol_table_intern(&result->labels, parsed->label, parsed->label_length,
+                                                parsed->label_hash);
+            RETURN_ERROR_IF(!parsed->label, PARSER_ERROR_INVALID_OPERAND);
+        }
+        
         instr->operand_count++;
     }
     
@@ -598,40 +608,30 @@ int parse_instruction(ParseResult* result, TokenizationResult* tokens, int* toke
 }
 
 // Добавление метки
-int add_label(ParseResult* result, const char* name, uint16_t address) {
-    // Проверка, не превышено ли максимальное количество меток
-    PRINT_ERROR_IF(result->label_count >= MAX_LABELS, 
-                  "Too many labels (max %d)", MAX_LABELS);
+int add_label(ParseResult* result, const char* name, size_t length, uint16_t address) {
+    int status = symbol_table_add(&result->labels, name, length, symbol_hash(name, length), address, NULL);
     
     // Проверка на повторное определение метки
-    for (int i = 0; i < result->label_count; i++) {
-        if (strcmp(result->labels[i].name, name) == 0) {
-            fprintf(stderr, "Label already defined: %s\n", name);
-            return PARSER_ERROR_LABEL_ALREADY_DEF;
-        }
+    if (status == SYMBOL_TABLE_DUPLICATE) {
+        fprintf(parser_diagnostics(), "Label already defined: %.*s\n", (int)length, name);
+        return PARSER_ERROR_LABEL_ALREADY_DEF;
     }
     
-    // Добавление новой метки
-    Label* label = &result->labels[result->label_count];
-    strncpy(label->name, name, MAX_TOKEN_LENGTH - 1);
-    label->address = address;
-    
-    result->label_count++;
+    PRINT_ERROR_IF(status == SYMBOL_TABLE_NO_MEMORY ? PARSER_ERROR_TOO_MANY_LABELS : PARSER_SUCCESS,
+                  "Failed to grow label table (%d labels)", result->labels.count);
     
     return PARSER_SUCCESS;  // Успешное добавление метки
 }
 
-// Получение адреса метки
-uint16_t get_label_address(const ParseResult* result, const char* name) {
-    for (int i = 0; i < result->label_count; i++) {
-        if (strcmp(result->labels[i].name, name) == 0) {
-            return result->labels[i].address;
-        }
-    }
-    
-    // Метка не найдена, выводим сообщение об ошибке
-    fprintf(stderr, "Label not found: %s\n", name);
-    fprintf(stderr, "Error: %s (%d).\nFile: %s, line: %d.\n", 
+// Поиск метки с предвычисленным хешем
+static const Label* find_label(const ParseResult* result, const char* name, size_t length, uint32_t hash) {
+    return symbol_table_find(&result->labels, name, length, hash);
+}
+
+// Вывод сообщения о ненайденной метке
+static uint16_t report_label_not_found(const char* name) {
+    fprintf(parser_diagnostics(), "Label not found: %s\n", name);
+    fprintf(parser_diagnostics(), "Error: %s (%d).\nFile: %s, line: %d.\n", 
             ParserErrorMessages[PARSER_ERROR_LABEL_NOT_FOUND], 
             PARSER_ERROR_LABEL_NOT_FOUND, 
             get_filename(__FILE__), __LINE__);
@@ -639,85 +639,204 @@ uint16_t get_label_address(const ParseResult* result, const char* name) {
     return 0xFFFF;  // Недопустимый адрес
 }
 
-// Парсинг ассемблерного файла
-ParseResult parse_file(const char* filename) {
-    ParseResult result = {0};
+// Получение адреса метки
+uint16_t get_label_address(const ParseResult* result, const char* name) {
+    size_t length = strlen(name);
+    const Label* label = find_label(result, name, length, symbol_hash(name, length));
+    if (label) {
+        return label->address;
+    }
     
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Failed to open file: %s\n", filename);
-        fprintf(stderr, "Error: %s (%d).\nFile: %s, line: %d.\n", 
-                ParserErrorMessages[PARSER_ERROR_FILE_NOT_FOUND], 
-                PARSER_ERROR_FILE_NOT_FOUND, 
-                get_filename(__FILE__), __LINE__);
-        return result;
+    // Метка не найдена, выводим сообщение об ошибке
+    return report_label_not_found(name);
+}
+
+// Создание пустого результата парсинга
+ParseResult* parse_result_create(void) {
+    ParseResult* result = (ParseResult*)calloc(1, sizeof(ParseResult));
+    if (!result) {
+        return NULL;
     }
     
-    char line[MAX_LINE_LENGTH];
-    int line_number = 0;
-    uint16_t current_address = 0;
+    arena_init(&result->arena, 0);
     
-    // Первый проход: сбор меток
-    while (fgets(line, MAX_LINE_LENGTH, file)) {
-        line_number++;
-        
-        // Проверка длины строки
-        if (strlen(line) >= MAX_LINE_LENGTH - 1) {
-            fprintf(stderr, "Line %d is too long (max %d characters)\n", line_number, MAX_LINE_LENGTH - 1);
-            fprintf(stderr, "Error: %s (%d).\nFile: %s, line: %d.\n", 
-                    ParserErrorMessages[PARSER_ERROR_LINE_TOO_LONG], 
-                    PARSER_ERROR_LINE_TOO_LONG, 
-                    get_filename(__FILE__), __LINE__);
-            fclose(file);
-            return result;
+    if (symbol_table_init(&result->labels) != SYMBOL_TABLE_SUCCESS) {
+        free(result);
+        return NULL;
+    }
+    
+    return result;
+}
+
+// Добавление новой инструкции (массив растёт удвоением, содержимое обнуляется)
+Instruction* parse_result_new_instruction(ParseResult* result) {
+    if (result->instruction_count == result->instruction_capacity) {
+        int new_capacity = result->instruction_capacity ? result->instruction_capacity * 2 : 64;
+        Instruction* grown = (Instruction*)realloc(result->instructions,
+                                                   (size_t)new_capacity * sizeof(Instruction));
+        if (!grown) {
+            return NULL;
         }
-        
-        // Токенизация строки
-        TokenizationResult tokens = tokenize_line(line, line_number);
-        
-        if (tokens.token_count == 0) {
-            continue;  // Пустая строка или комментарий
+        result->instructions = grown;
+        result->instruction_capacity = new_capacity;
+    }
+    
+    Instruction* instruction = &result->instructions[result->instruction_count];
+    memset(instruction, 0, sizeof(Instruction));
+    
+    return instruction;
+}
+
+// Добавление экспортируемой метки (имя копируется в арену результата)
+int parse_result_add_export(ParseResult* result, const char* name, size_t length, int line_number) {
+    if (result->export_count == result->export_capacity) {
+        int new_capacity = result->export_capacity ? result->export_capacity * 2 : 16;
+        ExportedName* grown = (ExportedName*)realloc(result->exports,
+                                                     (size_t)new_capacity * sizeof(ExportedName));
+        if (!grown) {
+            return PARSER_ERROR_TOO_MANY_LABELS;
+        }
+        result->exports = grown;
+        result->export_capacity = new_capacity;
+    }
+    
+    char* interned = arena_strndup(&result->arena, name, length);
+    RETURN_ERROR_IF(!interned, PARSER_ERROR_TOO_MANY_LABELS);
+    
+    ExportedName* export_name = &result->exports[result->export_count++];
+    export_name->name = interned;
+    export_name->length = (uint32_t)length;
+    export_name->line_number = line_number;
+    
+    return PARSER_SUCCESS;
+}
+
+// Освобождение результата парсинга
+void parse_result_free(ParseResult* result) {
+    if (!result) {
+        return;
+    }
+    
+    symbol_table_free(&result->labels);
+    arena_free(&result->arena);
+    free(result->instructions);
+    free(result->exports);
+    free(result);
+}
+
+// Вывод ошибки парсинга с номером строки исходного файла
+void report_parse_error(const char* message, int line_number, int error_code) {
+    fprintf(parser_diagnostics(), "%s at line %d\n", message, line_number);
+    fprintf(parser_diagnostics(), "Error: %s (%d).\nFile: %s, line: %d.\n", 
+            ParserErrorMessages[error_code], 
+            error_code, 
+            get_filename(__FILE__), __LINE__);
+}
+
+// Запоминание инструкции с неразрешённой меткой
+int fixup_list_add(FixupList* fixups, int instruction_index) {
+    if (fixups->count == fixups->capacity) {
+        int new_capacity = fixups->capacity ? fixups->capacity * 2 : 64;
+        int* grown = (int*)realloc(fixups->indices, (size_t)new_capacity * sizeof(int));
+        if (!grown) {
+            return PARSER_ERROR_TOO_MANY_INSTR;
+        }
+        fixups->indices = grown;
+        fixups->capacity = new_capacity;
+    }
+    
+    fixups->indices[fixups->count++] = instruction_index;
+    return PARSER_SUCCESS;
+}
+
+void fixup_list_free(FixupList* fixups) {
+    free(fixups->indices);
+    fixups->indices = NULL;
+    fixups->count = 0;
+    fixups->capacity = 0;
+}
+
+// Использует ли инструкция метку как цель перехода
+static int has_label_target(const Instruction* instruction) {
+    return instruction->format == FORMAT_F4 && instruction->operand_count >= 2 &&
+           instruction->operands[0].is_label_valid;
+}
+
+// Разрешена ли метка-цель инструкции (или метка не используется)
+int is_target_resolved(const ParseResult* result, const Instruction* instruction) {
+    if (!has_label_target(instruction)) {
+        return 1;
+    }
+    const Operand* target = &instruction->operands[0];
+    return find_label(result, target->label, target->label_length, target->label_hash) != NULL;
+}
+
+// Является ли токен директивой с заданным именем
+static int is_directive(const Token* token, const char* name) {
+    size_t length = strlen(name);
+    return token->type == TOKEN_IDENTIFIER && token->length == length && memcmp(token->text, name, length) == 0;
+}
+
+// Директива ".global имя[, имя...]": метки экспортируются из модуля (см. objectHeader.h).
+// При сборке в .bin директива проверяется, но на результат не влияет.
+static int parse_global_directive(ParseResult* result, const TokenizationResult* tokens, int token_idx,
+                                  int line_number) {
+    int name_count = 0;
+    
+    for (; token_idx < tokens->token_count; token_idx++) {
+        const Token* token = &tokens->tokens[token_idx];
+        if (token->type == TOKEN_COMMA) {
+            continue;
         }
         
-        int token_idx = 0;
+        int is_valid_name = token->type == TOKEN_IDENTIFIER || token->type == TOKEN_INSTRUCTION;
+        for (uint32_t i = 0; is_valid_name && i < token->length; i++) {
+            char c = token->text[i];
+            is_valid_name = isalnum((unsigned char)c) || c == '_';
+        }
         
-        // Поиск меток
-        while (token_idx < tokens.token_count) {
-            Token* token = &tokens.tokens[token_idx];
-            
-            if (token->type == TOKEN_LABEL) {
-                int error_code = add_label(&result, token->value, current_address);
-                if (error_code != PARSER_SUCCESS) {
-                    fprintf(stderr, "Error in line %d: ", line_number);
-                    fprintf(stderr, "Error: %s (%d).\nFile: %s, line: %d.\n", 
-                            ParserErrorMessages[error_code], 
-                            error_code, 
-                            get_filename(__FILE__), __LINE__);
-                    fclose(file);
-                    return result;
-                }
-                token_idx++;
-            } else if (token->type == TOKEN_INSTRUCTION) {
-                // Инструкция занимает 4 байта
-                current_address += 4;
-                break;
-            } else {
-                token_idx++;
-            }
+        if (!is_valid_name) {
+            fprintf(parser_diagnostics(), "Invalid label name in %s directive: %.*s\n", DIRECTIVE_GLOBAL,
+                    (int)token->length, token->text);
+            return PARSER_ERROR_INVALID_OPERAND;
         }
+        
+        RETURN_IF_ERROR(parse_result_add_export(result, token->text, token->length, line_number));
+        name_count++;
     }
     
-    // Сброс файла и счетчиков для второго прохода
-    rewind(file);
-    line_number = 0;
-    current_address = 0;
+    if (name_count == 0) {
+        fprintf(parser_diagnostics(), "Expected label name after %s\n", DIRECTIVE_GLOBAL);
+        return PARSER_ERROR_TOO_FEW_OPERANDS;
+    }
     
-    // Второй проход: парсинг инструкций
-    while (fgets(line, MAX_LINE_LENGTH, file)) {
-        line_number++;
+    return PARSER_SUCCESS;
+}
+
+// Разбор фрагмента исходного текста в результат: строки выделяются лексером без
+// копирования, машинный код генерируется сразу. Инструкции, ссылающиеся на ещё не
+// определённые метки (при defer_labels - на любые метки), попадают в fixups.
+int parse_fragment(ParseResult* result, const char* source, size_t size, int line_base,
+                   int defer_labels, FixupList* fixups) {
+    Lexer lexer;
+    lexer_init(&lexer, source, size);
+    
+    TokenizationResult tokens = {0};
+    const char* line;
+    size_t line_length;
+    size_t line_offset;
+    uint16_t current_address = (uint16_t)(result->instruction_count * 4);
+    int error_code = PARSER_SUCCESS;
+    
+    while (error_code == PARSER_SUCCESS && lexer_next_line(&lexer, &line, &line_length, &line_offset)) {
+        int line_number = line_base + lexer.line_number;
         
         // Токенизация строки
-        TokenizationResult tokens = tokenize_line(line, line_number);
+        error_code = tokenize_line(&tokens, line, line_length, line_number, (uint32_t)line_offset);
+        if (error_code != PARSER_SUCCESS) {
+            report_parse_error("Failed to tokenize line", line_number, error_code);
+            break;
+        }
         
         if (tokens.token_count == 0) {
             continue;  // Пустая строка или комментарий
@@ -725,22 +844,52 @@ ParseResult parse_file(const char* filename) {
         
         int token_idx = 0;
         
-        // Пропуск меток
+        // Метки в начале строки получают адрес следующей инструкции
         while (token_idx < tokens.token_count && tokens.tokens[token_idx].type == TOKEN_LABEL) {
+            error_code = add_label(result, tokens.tokens[token_idx].text, tokens.tokens[token_idx].length,
+                                   current_address);
+            if (error_code != PARSER_SUCCESS) {
+                report_parse_error("Failed to define label", line_number, error_code);
+                break;
+            }
+            result->labels.labels[result->labels.count - 1].line_number = line_number;
             token_idx++;
         }
         
-        // Парсинг инструкций
+        if (error_code != PARSER_SUCCESS) {
+            break;
+        }
+        
+        // Директива экспорта
+        if (token_idx < tokens.token_count && is_directive(&tokens.tokens[token_idx], DIRECTIVE_GLOBAL)) {
+            error_code = parse_global_directive(result, &tokens, token_idx + 1, line_number);
+            if (error_code != PARSER_SUCCESS) {
+                report_parse_error("Invalid directive", line_number, error_code);
+            }
+            continue;
+        }
+        
+        // Парсинг инструкции и немедленная генерация машинного кода
         if (token_idx < tokens.token_count && tokens.tokens[token_idx].type == TOKEN_INSTRUCTION) {
-            int error_code = parse_instruction(&result, &tokens, &token_idx, current_address);
+            error_code = parse_instruction(result, &tokens, &token_idx, current_address);
             if (error_code != PARSER_SUCCESS) {
-                fprintf(stderr, "Failed to parse instruction at line %d\n", line_number);
-                fprintf(stderr, "Error: %s (%d).\nFile: %s, line: %d.\n", 
-                        ParserErrorMessages[error_code], 
-                        error_code, 
-                        get_filename(__FILE__), __LINE__);
-                fclose(file);
-                return result;
+                report_parse_error("Failed to parse instruction", line_number, error_code);
+                break;
+            }
+            
+            int index = result->instruction_count - 1;
+            Instruction* instruction = &result->instructions[index];
+            instruction->line_number = line_number;
+            
+            int deferred = defer_labels ? has_label_target(instruction) : !is_target_resolved(result, instruction);
+            if (!deferred) {
+                instruction->machine_code = generate_machine_code(instruction, result);
+            } else {
+                error_code = fixup_list_add(fixups, index);
+                if (error_code != PARSER_SUCCESS) {
+                    report_parse_error("Failed to record forward reference", line_number, error_code);
+                    break;
+                }
             }
             
             // Инструкция занимает 4 байта
@@ -748,70 +897,121 @@ ParseResult parse_file(const char* filename) {
         }
     }
     
-    fclose(file);
+    tokenization_result_free(&tokens);
     
-    // Генерация машинного кода для всех инструкций
-    generate_machine_code_for_all(&result);
+    return error_code;
+}
+
+// Однопроходный парсинг исходного текста, ссылки вперёд исправляются в конце.
+// Текст должен оставаться доступным только на время вызова.
+ParseResult* parse_buffer(const char* source, size_t size) {
+    if (!source) {
+        return NULL;
+    }
+    
+    ParseResult* result = parse_result_create();
+    if (!result) {
+        fprintf(parser_diagnostics(), "Failed to allocate parse result\n");
+        return NULL;
+    }
+    
+    FixupList fixups = {0};
+    int error_code = parse_fragment(result, source, size, 0, 0, &fixups);
+    
+    // Исправление ссылок вперёд
+    for (int i = 0; error_code == PARSER_SUCCESS && i < fixups.count; i++) {
+        Instruction* instruction = &result->instructions[fixups.indices[i]];
+        
+        if (!is_target_resolved(result, instruction)) {
+            fprintf(parser_diagnostics(), "Label not found: %s\n", instruction->operands[0].label);
+            error_code = PARSER_ERROR_LABEL_NOT_FOUND;
+            report_parse_error("Unresolved branch target", instruction->line_number, error_code);
+            break;
+        }
+        
+        instruction->machine_code = generate_machine_code(instruction, result);
+    }
+    
+    fixup_list_free(&fixups);
+    
+    if (error_code != PARSER_SUCCESS) {
+        parse_result_free(result);
+        return NULL;
+    }
+    
+    return result;
+}
+
+// Парсинг потока: содержимое читается целиком, поток не обязан
+// поддерживать позиционирование (подходят каналы).
+ParseResult* parse_stream(FILE* stream) {
+    SourceBuffer source;
+    if (source_buffer_read_stream(&source, stream) != 0) {
+        fprintf(parser_diagnostics(), "Failed to read input stream\n");
+        return NULL;
+    }
+    
+    ParseResult* result = parse_buffer_parallel(source.data, source.size, 0);
+    source_buffer_close(&source);
     
     return result;
 }
 
-// Генерация машинного кода для инструкции
+// Парсинг ассемблерного файла (файл отображается в память, большие файлы
+// разбираются параллельно)
+ParseResult* parse_file(const char* filename) {
+    SourceBuffer source;
+    if (source_buffer_open_file(&source, filename) != 0) {
+        fprintf(parser_diagnostics(), "Failed to open file: %s\n", filename);
+        fprintf(parser_diagnostics(), "Error: %s (%d).\nFile: %s, line: %d.\n", 
+                ParserErrorMessages[PARSER_ERROR_FILE_NOT_FOUND], 
+                PARSER_ERROR_FILE_NOT_FOUND, 
+                get_filename(__FILE__), __LINE__);
+        return NULL;
+    }
+    
+    ParseResult* result = parse_buffer_parallel(source.data, source.size, 0);
+    source_buffer_close(&source);
+    
+    return result;
+}
+
+// Генерация машинного кода для инструкции (раскладка операндов - из таблицы ISA)
 uint32_t generate_machine_code(const Instruction* instruction, const ParseResult* parse_result) {
-    uint32_t machine_code = 0;
+    const IsaInstruction* isa = isa_lookup_opcode(instruction->opcode);
+    if (!(isa->flags & ISA_FLAG_VALID)) {
+        fprintf(parser_diagnostics(), "Unknown instruction format: %d\n", instruction->format);
+        return 0;
+    }
     
-    // Установка кода операции в старшие биты
-    machine_code |= ((uint32_t)instruction->opcode) << 24;
+    uint16_t values[ISA_MAX_OPERANDS] = {0};
     
-    switch (instruction->format) {
-        case FORMAT_F1:  // opc[7:0], src_0[7:0], src_1[7:0], dst[7:0]
-            if (instruction->operand_count >= 3) {
-                machine_code |= ((uint32_t)instruction->operands[0].reg_num) << 16;
-                machine_code |= ((uint32_t)instruction->operands[1].reg_num) << 8;
-                machine_code |= instruction->operands[2].reg_num;
-            }
-            break;
-            
-        case FORMAT_F2:  // opc[7:0], const[15:8], const[7:0], dst[7:0]
-            if (instruction->operand_count >= 2) {
-                uint16_t constant = instruction->operands[0].immediate;
-                machine_code |= ((uint32_t)(constant >> 8)) << 16;
-                machine_code |= ((uint32_t)(constant & 0xFF)) << 8;
-                machine_code |= instruction->operands[1].reg_num;
-            }
-            break;
-            
-        case FORMAT_F3:  // opc[7:0], src_0[7:0], src_1[7:0], src_2[7:0]
-            if (instruction->operand_count >= 3) {
-                machine_code |= ((uint32_t)instruction->operands[0].reg_num) << 16;
-                machine_code |= ((uint32_t)instruction->operands[1].reg_num) << 8;
-                machine_code |= instruction->operands[2].reg_num;
-            }
-            break;
-            
-        case FORMAT_F4:  // opc[7:0], src_0[7:0], target[15:8], target[7:0]
-            if (instruction->operand_count >= 2) {
-                uint16_t target;
+    for (int i = 0; i < isa->operand_count && i < instruction->operand_count; i++) {
+        const Operand* operand = &instruction->operands[i];
+        
+        switch (isa->operands[i].kind) {
+            case ISA_OPERAND_REGISTER:
+                values[i] = operand->reg_num;
+                break;
                 
-                // Если используется метка, получаем ее адрес
-                if (instruction->operands[0].is_label_valid) {
-                    target = get_label_address(parse_result, instruction->operands[0].label);
+            case ISA_OPERAND_TARGET:
+                // Если используется метка, получаем ее адрес (хеш вычислен при парсинге)
+                if (operand->is_label_valid) {
+                    const Label* label = find_label(parse_result, operand->label,
+                                                    operand->label_length, operand->label_hash);
+                    values[i] = label ? label->address : report_label_not_found(operand->label);
                 } else {
-                    target = instruction->operands[0].immediate;
+                    values[i] = operand->immediate;
                 }
+                break;
                 
-                machine_code |= ((uint32_t)instruction->operands[1].reg_num) << 16;
-                machine_code |= ((uint32_t)(target >> 8)) << 8;
-                machine_code |= (target & 0xFF);
-            }
-            break;
-            
-        default:
-            fprintf(stderr, "Unknown instruction format: %d\n", instruction->format);
-            return 0;
+            default:
+                values[i] = operand->immediate;
+                break;
+        }
     }
     
-    return machine_code;
+    return isa_encode(isa, values, instruction->operand_count);
 }
 
 // Генерация машинного кода для всех инструкций
@@ -825,7 +1025,7 @@ void generate_machine_code_for_all(ParseResult* result) {
 void write_machine_code_to_file(const ParseResult* result, const char* filename) {
     FILE* file = fopen(filename, "wb");
     if (!file) {
-        fprintf(stderr, "Failed to open file for writing: %s\n", filename);
+        fprintf(parser_diagnostics(), "Failed to open file for writing: %s\n", filename);
         return;
     }
     
@@ -865,8 +1065,8 @@ void print_token(const Token* token) {
         default: type_str = "UNKNOWN";
     }
     
-    printf("Token{type=%s, value=\"%s\", line=%d, pos=%lu}\n",
-           type_str, token->value, token->line_number, token->position);
+    printf("Token{type=%s, value=\"%.*s\", offset=%u, line=%d, pos=%lu}\n",
+           type_str, (int)token->length, token->text, token->offset, token->line_number, token->position);
 }
 
 // Печать всех токенов
@@ -883,27 +1083,8 @@ void print_all_tokens(const TokenizationResult* result) {
 
 // Печать инструкции
 void print_instruction(const Instruction* instruction) {
-    const char* opcode_str;
-    
-    switch (instruction->opcode) {
-        case OPC_NOP: opcode_str = "NOP"; break;
-        case OPC_ADD: opcode_str = "ADD"; break;
-        case OPC_SUB: opcode_str = "SUB"; break;
-        case OPC_MUL: opcode_str = "MUL"; break;
-        case OPC_DIV: opcode_str = "DIV"; break;
-        case OPC_CMPGE: opcode_str = "CMPGE"; break;
-        case OPC_RSHFT: opcode_str = "RSHFT"; break;
-        case OPC_LSHFT: opcode_str = "LSHFT"; break;
-        case OPC_AND: opcode_str = "AND"; break;
-        case OPC_OR: opcode_str = "OR"; break;
-        case OPC_XOR: opcode_str = "XOR"; break;
-        case OPC_LD: opcode_str = "LD"; break;
-        case OPC_SET_CONST: opcode_str = "SET_CONST"; break;
-        case OPC_ST: opcode_str = "ST"; break;
-        case OPC_BNZ: opcode_str = "BNZ"; break;
-        case OPC_READY: opcode_str = "READY"; break;
-        default: opcode_str = "UNKNOWN";
-    }
+    const IsaInstruction* isa = isa_lookup_opcode(instruction->opcode);
+    const char* opcode_str = isa->mnemonic ? isa->mnemonic : "UNKNOWN";
     
     const char* format_str;
     
@@ -912,6 +1093,7 @@ void print_instruction(const Instruction* instruction) {
         case FORMAT_F2: format_str = "F2"; break;
         case FORMAT_F3: format_str = "F3"; break;
         case FORMAT_F4: format_str = "F4"; break;
+        case FORMAT_F5: format_str = "F5"; break;
         default: format_str = "UNKNOWN";
     }
     
@@ -922,7 +1104,7 @@ void print_instruction(const Instruction* instruction) {
         const Operand* op = &instruction->operands[i];
         
         printf("  Operand{reg_num=%d, immediate=0x%04X, label=\"%s\", is_memory_access=%d, is_reg_valid=%d, is_immediate_valid=%d, is_label_valid=%d}\n",
-               op->reg_num, op->immediate, op->label, op->is_memory_access,
+               op->reg_num, op->immediate, op->label ? op->label : "", op->is_memory_access,
                op->is_reg_valid, op->is_immediate_valid, op->is_label_valid);
     }
     
@@ -932,7 +1114,7 @@ void print_instruction(const Instruction* instruction) {
 // Печать результата парсинга
 void print_parse_result(const ParseResult* result) {
     printf("ParseResult{instruction_count=%d, label_count=%d, instructions=[\n", 
-           result->instruction_count, result->label_count);
+           result->instruction_count, result->labels.count);
     
     for (int i = 0; i < result->instruction_count; i++) {
         printf("  ");
@@ -941,9 +1123,9 @@ void print_parse_result(const ParseResult* result) {
     
     printf("], labels=[\n");
     
-    for (int i = 0; i < result->label_count; i++) {
+    for (int i = 0; i < result->labels.count; i++) {
         printf("  Label{name=\"%s\", address=0x%04X}\n", 
-               result->labels[i].name, result->labels[i].address);
+               result->labels.labels[i].name, result->labels.labels[i].address);
     }
     
     printf("]}\n");
@@ -0,0 +1,49 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parserHeader.h"
+#include "flowAnalysisHeader.h"
+
+// Оптимизирующий проход по списку инструкций после парсинга.
+//
+// Сохраняется значение всех регистров в момент ready (их видит пользователь
+// эмулятора) и все обращения к памяти. Проход удаляет:
+//   - nop;
+//   - взаимно уничтожающиеся пары (add/sub и xor/xor с тем же регистром);
+//   - set_const в регистр, который уже содержит это значение;
+//   - инструкции без побочных эффектов, результат которых не читается;
+// и заменяет mul на степень двойки сдвигом lshft, если старшая половина
+// результата (dst+1) не используется. После удаления адреса меток и числовые
+// цели bnz пересчитываются, машинный код генерируется заново.
+// ld, st и div не удаляются, поэтому ошибки выполнения возникают там же, но
+// состояние прочих регистров в момент ошибки может отличаться.
+#define PEEPHOLE_MAX_PASSES 8
+
+// Коды результата
+typedef enum {
+    PEEPHOLE_SUCCESS = 0,
+    PEEPHOLE_ERROR_NO_MEMORY,        // Не удалось выделить память
+    PEEPHOLE_ERROR_UNSAFE_TARGET,    // Цель bnz вне программы: проход не применяется
+    PEEPHOLE_ERROR_COUNT             // Количество кодов ошибок (всегда последний)
+} PeepholeErrorCode;
+
+extern const char* PeepholeErrorMessages[PEEPHOLE_ERROR_COUNT];
+
+// Статистика преобразований
+typedef struct {
+    int removed_nops;
+    int removed_pairs;               // Удалённые пары (по две инструкции)
+    int removed_constants;           // Повторные set_const
+    int removed_dead;                // Инструкции с неиспользуемым результатом
+    int strength_reduced;            // mul -> lshft
+    int passes;
+} PeepholeStats;
+
+// Оптимизация результата парсинга на месте (все метки должны быть разрешены)
+int peephole_optimize(ParseResult* result, PeepholeStats* stats);
+
+#endif // PEEPHOLE_H
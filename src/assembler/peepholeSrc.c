@@ -0,0 +1,332 @@
+#include "peepholeHeader.h"
+
+const char* PeepholeErrorMessages[PEEPHOLE_ERROR_COUNT] = {
+    "Success",                               // PEEPHOLE_SUCCESS
+    "Out of memory",                         // PEEPHOLE_ERROR_NO_MEMORY
+    "Branch target outside the program"      // PEEPHOLE_ERROR_UNSAFE_TARGET
+};
+
+#define UNKNOWN_VALUE (-1)
+
+// Состояние одного прохода; массивы анализа берутся из FlowAnalysis
+typedef struct {
+    ParseResult* result;
+    FlowAnalysis* flow;
+    int count;
+    uint32_t* reads;
+    uint32_t* writes;
+    uint32_t* live_out;
+    int* target_index;
+    uint8_t* leader;
+    uint8_t* removed;
+} PeepholePass;
+
+// Известные значения регистров внутри линейного участка
+typedef struct {
+    int32_t value[ISA_REGISTER_COUNT];        // UNKNOWN_VALUE - неизвестно
+    int definition[ISA_REGISTER_COUNT];       // Индекс set_const, задавшей значение (-1 - нет)
+    uint8_t read_since_definition[ISA_REGISTER_COUNT];
+} KnownRegisters;
+
+static void known_registers_reset(KnownRegisters* known) {
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        known->value[r] = UNKNOWN_VALUE;
+        known->definition[r] = -1;
+        known->read_since_definition[r] = 0;
+    }
+}
+
+// Инструкция без побочных эффектов: её можно удалить, если результат не читается.
+// div (деление на ноль) и ld (ошибка доступа) остаются.
+static int is_pure(OpCode opcode) {
+    switch (opcode) {
+        case OPC_ADD: case OPC_SUB: case OPC_MUL: case OPC_CMPGE:
+        case OPC_RSHFT: case OPC_LSHFT: case OPC_AND: case OPC_OR:
+        case OPC_XOR: case OPC_SET_CONST:
+        case OPC_ADDSB: case OPC_SUBSB: case OPC_CMPGEB: case OPC_MINB: case OPC_MAXB:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Пара, возвращающая dst к исходному значению:
+// add d,b,d + sub d,b,d; sub d,b,d + add d,b,d; xor d,b,d + xor d,b,d (b != d)
+static int is_cancelling_pair(const Instruction* first, const Instruction* second) {
+    if (first->operand_count != 3 || second->operand_count != 3) {
+        return 0;
+    }
+
+    uint8_t d = first->operands[2].reg_num;
+    uint8_t b;
+    int commutative = first->opcode == OPC_ADD || first->opcode == OPC_XOR;
+
+    if (second->operands[2].reg_num != d) {
+        return 0;
+    }
+    if (first->operands[0].reg_num == d) {
+        b = first->operands[1].reg_num;
+    } else if (commutative && first->operands[1].reg_num == d) {
+        b = first->operands[0].reg_num;
+    } else {
+        return 0;
+    }
+    if (b == d) {
+        return 0;
+    }
+
+    uint8_t s0 = second->operands[0].reg_num;
+    uint8_t s1 = second->operands[1].reg_num;
+    int same_sources = (s0 == d && s1 == b) || (s0 == b && s1 == d);
+
+    switch (first->opcode) {
+        case OPC_ADD: return second->opcode == OPC_SUB && s0 == d && s1 == b;
+        case OPC_SUB: return second->opcode == OPC_ADD && same_sources;
+        case OPC_XOR: return second->opcode == OPC_XOR && same_sources;
+        default:      return 0;
+    }
+}
+
+static int is_power_of_two(int32_t value) {
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+// mul src, c, d, где c = 2^k, а dst+1 не читается -> lshft src, rk, d.
+// Регистр со значением k ищется среди известных; иначе set_const, задавшая c,
+// переписывается на k, если c больше никем не читается.
+static int reduce_multiplication(PeepholePass* pass, KnownRegisters* known, int i) {
+    Instruction* instructions = pass->result->instructions;
+    Instruction* instruction = &instructions[i];
+    uint8_t a = instruction->operands[0].reg_num;
+    uint8_t b = instruction->operands[1].reg_num;
+    uint8_t d = instruction->operands[2].reg_num;
+    uint8_t high = (d + 1) & (ISA_REGISTER_COUNT - 1);
+
+    if (pass->live_out[i] & (1u << high)) {
+        return 0;
+    }
+
+    uint8_t source;
+    uint8_t constant;
+    if (is_power_of_two(known->value[b])) {
+        source = a;
+        constant = b;
+    } else if (is_power_of_two(known->value[a])) {
+        source = b;
+        constant = a;
+    } else {
+        return 0;
+    }
+
+    int32_t shift = __builtin_ctz((uint32_t)known->value[constant]);
+    int shift_register = -1;
+
+    for (int r = 0; r < ISA_REGISTER_COUNT && shift_register < 0; r++) {
+        if (known->value[r] == shift) {
+            shift_register = r;
+        }
+    }
+
+    int definition = known->definition[constant];
+    if (shift_register < 0 && definition >= 0 && !known->read_since_definition[constant] &&
+        source != constant && (constant == d || !(pass->live_out[i] & (1u << constant)))) {
+        instructions[definition].operands[0].immediate = (uint16_t)shift;
+        instructions[definition].machine_code = generate_machine_code(&instructions[definition], pass->result);
+        known->value[constant] = shift;
+        shift_register = constant;
+    }
+
+    if (shift_register < 0) {
+        return 0;
+    }
+
+    instruction->opcode = OPC_LSHFT;
+    instruction->format = get_format_from_opcode(OPC_LSHFT);
+    instruction->operands[0].reg_num = source;
+    instruction->operands[1].reg_num = (uint8_t)shift_register;
+    instruction->machine_code = generate_machine_code(instruction, pass->result);
+    flow_analysis_update_usage(pass->flow, i);
+
+    return 1;
+}
+
+// Прямой проход с преобразованиями; удалённые инструкции не меняют известные значения
+static int transform(PeepholePass* pass, PeepholeStats* stats) {
+    Instruction* instructions = pass->result->instructions;
+    KnownRegisters known;
+    int changed = 0;
+
+    known_registers_reset(&known);
+
+    for (int i = 0; i < pass->count; i++) {
+        Instruction* instruction = &instructions[i];
+
+        if (pass->leader[i]) {
+            known_registers_reset(&known);
+        }
+
+        if (instruction->opcode == OPC_NOP) {
+            pass->removed[i] = 1;
+            stats->removed_nops++;
+            changed = 1;
+            continue;
+        }
+
+        if (is_pure(instruction->opcode) && !(pass->writes[i] & pass->live_out[i])) {
+            pass->removed[i] = 1;
+            stats->removed_dead++;
+            changed = 1;
+            continue;
+        }
+
+        if (instruction->opcode == OPC_SET_CONST) {
+            uint8_t d = instruction->operands[1].reg_num;
+            int32_t value = instruction->operands[0].immediate;
+
+            if (known.value[d] == value) {
+                pass->removed[i] = 1;
+                stats->removed_constants++;
+                changed = 1;
+            } else {
+                known.value[d] = value;
+                known.definition[d] = i;
+                known.read_since_definition[d] = 0;
+            }
+            continue;
+        }
+
+        if (i + 1 < pass->count && !pass->leader[i + 1] && is_cancelling_pair(instruction, &instructions[i + 1])) {
+            pass->removed[i] = 1;
+            pass->removed[i + 1] = 1;
+            stats->removed_pairs++;
+            changed = 1;
+            i++;
+            continue;
+        }
+
+        if (instruction->opcode == OPC_MUL && reduce_multiplication(pass, &known, i)) {
+            stats->strength_reduced++;
+            changed = 1;
+        }
+
+        for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+            if (pass->reads[i] & (1u << r)) {
+                known.read_since_definition[r] = 1;
+            }
+            if (pass->writes[i] & (1u << r)) {
+                known.value[r] = UNKNOWN_VALUE;
+                known.definition[r] = -1;
+            }
+        }
+    }
+
+    return changed;
+}
+
+// Сжатие списка и пересчёт адресов: метка удалённой инструкции переходит
+// к следующей оставшейся
+static void compact(PeepholePass* pass, int* new_index) {
+    ParseResult* result = pass->result;
+    int kept = 0;
+
+    for (int i = 0; i < pass->count; i++) {
+        new_index[i] = kept;
+        kept += !pass->removed[i];
+    }
+    new_index[pass->count] = kept;
+
+    for (int i = 0; i < result->labels.count; i++) {
+        Label* label = &result->labels.labels[i];
+        uint32_t index = label->address / 4u;
+        if (label->address % 4 == 0 && index <= (uint32_t)pass->count) {
+            label->address = (uint16_t)(new_index[index] * 4);
+        }
+    }
+
+    for (int i = 0; i < pass->count; i++) {
+        Operand* target = &result->instructions[i].operands[0];
+        if (pass->target_index[i] >= 0 && !target->is_label_valid) {
+            target->immediate = (uint16_t)(new_index[pass->target_index[i]] * 4);
+        }
+    }
+
+    for (int i = 0; i < pass->count; i++) {
+        if (!pass->removed[i]) {
+            Instruction* instruction = &result->instructions[new_index[i]];
+            *instruction = result->instructions[i];
+            instruction->address = (uint16_t)(new_index[i] * 4);
+        }
+    }
+
+    result->instruction_count = kept;
+    generate_machine_code_for_all(result);
+}
+
+static int run_pass(ParseResult* result, PeepholeStats* stats, int* changed) {
+    FlowAnalysis flow;
+    *changed = 0;
+
+    int status = flow_analysis_build(&flow, result);
+    if (status != FLOW_SUCCESS) {
+        return status == FLOW_ERROR_UNSAFE_TARGET ? PEEPHOLE_ERROR_UNSAFE_TARGET : PEEPHOLE_ERROR_NO_MEMORY;
+    }
+
+    size_t words = (size_t)flow.count + 1;
+    uint8_t* removed = (uint8_t*)calloc(words, sizeof(uint8_t));
+    int* new_index = (int*)calloc(words, sizeof(int));
+    if (!removed || !new_index) {
+        free(removed);
+        free(new_index);
+        flow_analysis_free(&flow);
+        return PEEPHOLE_ERROR_NO_MEMORY;
+    }
+
+    PeepholePass pass = {
+        .result = result,
+        .flow = &flow,
+        .count = flow.count,
+        .reads = flow.reads,
+        .writes = flow.writes,
+        .live_out = flow.live_out,
+        .target_index = flow.target_index,
+        .leader = flow.leader,
+        .removed = removed
+    };
+
+    *changed = transform(&pass, stats);
+    if (*changed) {
+        compact(&pass, new_index);
+    }
+
+    free(removed);
+    free(new_index);
+    flow_analysis_free(&flow);
+    return PEEPHOLE_SUCCESS;
+}
+
+int peephole_optimize(ParseResult* result, PeepholeStats* stats) {
+    PeepholeStats local;
+    if (!stats) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(PeepholeStats));
+
+    if (!result || result->instruction_count <= 0) {
+        return PEEPHOLE_SUCCESS;
+    }
+
+    for (int pass = 0; pass < PEEPHOLE_MAX_PASSES; pass++) {
+        int changed;
+        int status = run_pass(result, stats, &changed);
+        if (status != PEEPHOLE_SUCCESS) {
+            return status;
+        }
+
+        stats->passes++;
+        if (!changed) {
+            break;
+        }
+    }
+
+    return PEEPHOLE_SUCCESS;
+}
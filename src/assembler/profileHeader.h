@@ -0,0 +1,66 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Профиль выполнения программы: сколько раз выполнена каждая инструкция
+// и сколько раз выполнен переход bnz. Собирается эмулятором
+// (emulator_attach_profile), читается ассемблером для раскладки кода
+// (layoutHeader.h).
+//
+// Профиль привязан к машинному коду хешем: после изменения исходника
+// старый профиль не применяется.
+//
+// Формат файла (все числа Big Endian):
+//   заголовок: "CPUP", u16 версия, u16 резерв, u32 число инструкций, u32 хеш кода
+//   счётчики:  для инструкции i - u64 выполнено, u64 переходов
+#define PROFILE_MAGIC "CPUP"
+#define PROFILE_VERSION 1
+#define PROFILE_HEADER_SIZE 16
+#define PROFILE_ENTRY_SIZE 16
+
+// Коды ошибок профиля
+typedef enum {
+    PROFILE_SUCCESS = 0,
+    PROFILE_ERROR_IO,                // Ошибка чтения или записи файла
+    PROFILE_ERROR_BAD_FORMAT,        // Файл не является профилем
+    PROFILE_ERROR_NO_MEMORY,         // Не удалось выделить память
+    PROFILE_ERROR_MISMATCH,          // Профиль снят с другой программы
+    PROFILE_ERROR_COUNT              // Количество кодов ошибок (всегда последний)
+} ProfileErrorCode;
+
+extern const char* ProfileErrorMessages[PROFILE_ERROR_COUNT];
+
+typedef struct ExecutionProfile {
+    uint32_t instruction_count;
+    uint32_t program_hash;           // profile_program_hash кода программы
+    uint64_t* executed;              // Выполнений инструкции i (адрес 4*i)
+    uint64_t* taken;                 // Выполненных переходов bnz i
+} ExecutionProfile;
+
+// Хеш машинного кода (FNV-1a); нулевые слова в конце памяти инструкций не учитываются,
+// поэтому хеш образа и загруженной памяти совпадает
+uint32_t profile_program_hash(const uint8_t* code, size_t size);
+
+// Пустой профиль для кода программы (размер - без нулевых слов в конце)
+int profile_init(ExecutionProfile* profile, const uint8_t* code, size_t size);
+void profile_free(ExecutionProfile* profile);
+
+// Учёт выполненной инструкции; адреса за концом программы не учитываются
+static inline void profile_record(ExecutionProfile* profile, uint16_t address, int taken) {
+    uint32_t index = address / 4u;
+    if (index < profile->instruction_count) {
+        profile->executed[index]++;
+        profile->taken[index] += taken != 0;
+    }
+}
+
+int profile_write(const ExecutionProfile* profile, const char* filename);
+int profile_read(ExecutionProfile* profile, const char* filename);
+
+void print_profile_error(int error_code, const char* custom_message);
+
+#endif // PROFILE_H
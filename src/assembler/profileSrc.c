@@ -0,0 +1,179 @@
+#include "profileHeader.h"
+#include "lexerHeader.h"
+
+const char* ProfileErrorMessages[PROFILE_ERROR_COUNT] = {
+    "Success",                       // PROFILE_SUCCESS
+    "Input/output error",            // PROFILE_ERROR_IO
+    "Invalid profile format",        // PROFILE_ERROR_BAD_FORMAT
+    "Out of memory",                 // PROFILE_ERROR_NO_MEMORY
+    "Profile belongs to a different program" // PROFILE_ERROR_MISMATCH
+};
+
+void print_profile_error(int error_code, const char* custom_message) {
+    if (error_code >= 0 && error_code < PROFILE_ERROR_COUNT) {
+        fprintf(stderr, "%s: %s (%d)\n", custom_message ? custom_message : "Profile error",
+                ProfileErrorMessages[error_code], error_code);
+    } else {
+        fprintf(stderr, "%s: Unknown error code: %d\n",
+                custom_message ? custom_message : "Profile error", error_code);
+    }
+}
+
+// Размер кода без нулевых слов в конце
+static size_t trimmed_size(const uint8_t* code, size_t size) {
+    size -= size % 4;
+    while (size >= 4 && (code[size - 4] | code[size - 3] | code[size - 2] | code[size - 1]) == 0) {
+        size -= 4;
+    }
+    return size;
+}
+
+uint32_t profile_program_hash(const uint8_t* code, size_t size) {
+    uint32_t hash = 2166136261u;
+    size = code ? trimmed_size(code, size) : 0;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= code[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int profile_allocate(ExecutionProfile* profile, uint32_t instruction_count) {
+    memset(profile, 0, sizeof(ExecutionProfile));
+
+    // Один блок под оба массива счётчиков
+    profile->executed = (uint64_t*)calloc((size_t)instruction_count * 2 + 1, sizeof(uint64_t));
+    if (!profile->executed) {
+        return PROFILE_ERROR_NO_MEMORY;
+    }
+    profile->taken = profile->executed + instruction_count;
+    profile->instruction_count = instruction_count;
+    return PROFILE_SUCCESS;
+}
+
+int profile_init(ExecutionProfile* profile, const uint8_t* code, size_t size) {
+    if (!profile || (!code && size > 0)) {
+        return PROFILE_ERROR_BAD_FORMAT;
+    }
+
+    size_t used = code ? trimmed_size(code, size) : 0;
+    int status = profile_allocate(profile, (uint32_t)(used / 4));
+    if (status == PROFILE_SUCCESS) {
+        profile->program_hash = profile_program_hash(code, used);
+    }
+    return status;
+}
+
+void profile_free(ExecutionProfile* profile) {
+    if (!profile) {
+        return;
+    }
+
+    free(profile->executed);
+    memset(profile, 0, sizeof(ExecutionProfile));
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    p[0] = (value >> 24) & 0xFF;
+    p[1] = (value >> 16) & 0xFF;
+    p[2] = (value >> 8) & 0xFF;
+    p[3] = value & 0xFF;
+    return p + 4;
+}
+
+static uint8_t* put_u64(uint8_t* p, uint64_t value) {
+    p = put_u32(p, (uint32_t)(value >> 32));
+    return put_u32(p, (uint32_t)value);
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint64_t get_u64(const uint8_t* p) {
+    return ((uint64_t)get_u32(p) << 32) | get_u32(p + 4);
+}
+
+int profile_write(const ExecutionProfile* profile, const char* filename) {
+    if (!profile || !filename) {
+        return PROFILE_ERROR_IO;
+    }
+
+    size_t size = PROFILE_HEADER_SIZE + (size_t)profile->instruction_count * PROFILE_ENTRY_SIZE;
+    uint8_t* buffer = (uint8_t*)calloc(1, size);
+    if (!buffer) {
+        return PROFILE_ERROR_NO_MEMORY;
+    }
+
+    uint8_t* p = buffer;
+    memcpy(p, PROFILE_MAGIC, 4);
+    p[4] = (PROFILE_VERSION >> 8) & 0xFF;
+    p[5] = PROFILE_VERSION & 0xFF;
+    p = put_u32(p + 8, profile->instruction_count);
+    p = put_u32(p, profile->program_hash);
+
+    for (uint32_t i = 0; i < profile->instruction_count; i++) {
+        p = put_u64(p, profile->executed[i]);
+        p = put_u64(p, profile->taken[i]);
+    }
+
+    int status = PROFILE_SUCCESS;
+    FILE* file = fopen(filename, "wb");
+    if (!file || fwrite(buffer, 1, size, file) != size) {
+        status = PROFILE_ERROR_IO;
+    }
+    if (file && fclose(file) != 0) {
+        status = PROFILE_ERROR_IO;
+    }
+
+    free(buffer);
+    return status;
+}
+
+static int profile_decode(ExecutionProfile* profile, const uint8_t* data, size_t size) {
+    if (size < PROFILE_HEADER_SIZE || memcmp(data, PROFILE_MAGIC, 4) != 0 ||
+        ((data[4] << 8) | data[5]) != PROFILE_VERSION) {
+        return PROFILE_ERROR_BAD_FORMAT;
+    }
+
+    uint32_t instruction_count = get_u32(data + 8);
+    if ((uint64_t)instruction_count * PROFILE_ENTRY_SIZE + PROFILE_HEADER_SIZE != size) {
+        return PROFILE_ERROR_BAD_FORMAT;
+    }
+
+    int status = profile_allocate(profile, instruction_count);
+    if (status != PROFILE_SUCCESS) {
+        return status;
+    }
+    profile->program_hash = get_u32(data + 12);
+
+    const uint8_t* p = data + PROFILE_HEADER_SIZE;
+    for (uint32_t i = 0; i < instruction_count; i++, p += PROFILE_ENTRY_SIZE) {
+        profile->executed[i] = get_u64(p);
+        profile->taken[i] = get_u64(p + 8);
+        if (profile->taken[i] > profile->executed[i]) {
+            profile_free(profile);
+            return PROFILE_ERROR_BAD_FORMAT;
+        }
+    }
+
+    return PROFILE_SUCCESS;
+}
+
+int profile_read(ExecutionProfile* profile, const char* filename) {
+    if (!profile || !filename) {
+        return PROFILE_ERROR_IO;
+    }
+    memset(profile, 0, sizeof(ExecutionProfile));
+
+    SourceBuffer buffer;
+    if (source_buffer_open_file(&buffer, filename) != 0) {
+        return PROFILE_ERROR_IO;
+    }
+
+    int status = profile_decode(profile, (const uint8_t*)buffer.data, buffer.size);
+    source_buffer_close(&buffer);
+
+    return status;
+}
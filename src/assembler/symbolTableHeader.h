@@ -0,0 +1,68 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arenaHeader.h"
+
+// Начальная ёмкость таблицы (степень двойки)
+#define SYMBOL_TABLE_INITIAL_SLOTS 64
+
+// Результаты операций с таблицей символов
+typedef enum {
+    SYMBOL_TABLE_SUCCESS = 0,
+    SYMBOL_TABLE_DUPLICATE,       // Символ уже определён
+    SYMBOL_TABLE_NO_MEMORY        // Не удалось увеличить таблицу
+} SymbolTableStatus;
+
+// Структура метки
+typedef struct {
+    const char* name;             // Интернированное имя (живёт в арене таблицы)
+    uint32_t name_length;
+    uint32_t hash;                // Предвычисленный хеш имени
+    uint16_t address;
+    int line_number;              // Строка определения (0 - неизвестна)
+} Label;
+
+// Слот множества интернированных имён (text == NULL - пустой слот)
+typedef struct {
+    const char* text;
+    uint32_t length;
+    uint32_t hash;
+} SymbolName;
+
+// Хеш-таблица меток с открытой адресацией. Метки хранятся в порядке
+// добавления, слоты содержат индекс метки + 1 (0 - пустой слот).
+// Имена меток и ссылок на метки в операндах интернируются: каждое
+// различное имя хранится в арене names один раз.
+typedef struct {
+    Label* labels;
+    int count;
+    int capacity;
+    uint32_t* slots;
+    uint32_t slot_count;
+    Arena names;                  // Хранилище интернированных имён
+    SymbolName* name_slots;       // Множество имён (открытая адресация)
+    uint32_t name_slot_count;
+    uint32_t name_count;
+} SymbolTable;
+
+// Хеш имени (FNV-1a)
+uint32_t symbol_hash(const char* name, size_t length);
+
+int symbol_table_init(SymbolTable* table);
+void symbol_table_free(SymbolTable* table);
+
+// Добавление символа; при успехе *out_label указывает на новую метку
+int symbol_table_add(SymbolTable* table, const char* name, size_t length, uint32_t hash,
+                     uint16_t address, const Label** out_label);
+
+// Единственная копия имени в таблице (добавляется при первом обращении);
+// NULL - не хватило памяти
+const char* symbol_table_intern(SymbolTable* table, const char* name, size_t length, uint32_t hash);
+
+// Поиск символа по имени и предвычисленному хешу (NULL - не найден)
+const Label* symbol_table_find(const SymbolTable* table, const char* name, size_t length, uint32_t hash);
+
+#endif // SYMBOL_TABLE_H
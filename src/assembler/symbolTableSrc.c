@@ -0,0 +1,212 @@
+#include "symbolTableHeader.h"
+
+uint32_t symbol_hash(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int symbol_table_init(SymbolTable* table) {
+    if (!table) {
+        return SYMBOL_TABLE_NO_MEMORY;
+    }
+
+    memset(table, 0, sizeof(*table));
+    arena_init(&table->names, 0);
+
+    table->slots = (uint32_t*)calloc(SYMBOL_TABLE_INITIAL_SLOTS, sizeof(uint32_t));
+    if (!table->slots) {
+        return SYMBOL_TABLE_NO_MEMORY;
+    }
+    table->slot_count = SYMBOL_TABLE_INITIAL_SLOTS;
+
+    table->name_slots = (SymbolName*)calloc(SYMBOL_TABLE_INITIAL_SLOTS, sizeof(SymbolName));
+    if (!table->name_slots) {
+        free(table->slots);
+        table->slots = NULL;
+        return SYMBOL_TABLE_NO_MEMORY;
+    }
+    table->name_slot_count = SYMBOL_TABLE_INITIAL_SLOTS;
+
+    return SYMBOL_TABLE_SUCCESS;
+}
+
+void symbol_table_free(SymbolTable* table) {
+    if (!table) {
+        return;
+    }
+
+    free(table->labels);
+    free(table->slots);
+    free(table->name_slots);
+    arena_free(&table->names);
+
+    table->labels = NULL;
+    table->slots = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->slot_count = 0;
+    table->name_slots = NULL;
+    table->name_slot_count = 0;
+    table->name_count = 0;
+}
+
+// Поиск слота для имени: занятый совпадающей меткой или первый пустой
+static uint32_t symbol_table_probe(const SymbolTable* table, const char* name, size_t length, uint32_t hash) {
+    uint32_t mask = table->slot_count - 1;
+    uint32_t slot = hash & mask;
+
+    for (;;) {
+        uint32_t entry = table->slots[slot];
+        if (entry == 0) {
+            return slot;
+        }
+
+        const Label* label = &table->labels[entry - 1];
+        if (label->hash == hash && label->name_length == length &&
+            memcmp(label->name, name, length) == 0) {
+            return slot;
+        }
+
+        slot = (slot + 1) & mask;  // Линейное пробирование
+    }
+}
+
+// Удвоение числа слотов с перехешированием по сохранённым хешам
+static int symbol_table_grow_slots(SymbolTable* table) {
+    uint32_t new_count = table->slot_count * 2;
+    uint32_t* new_slots = (uint32_t*)calloc(new_count, sizeof(uint32_t));
+    if (!new_slots) {
+        return SYMBOL_TABLE_NO_MEMORY;
+    }
+
+    uint32_t mask = new_count - 1;
+    for (int i = 0; i < table->count; i++) {
+        uint32_t slot = table->labels[i].hash & mask;
+        while (new_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        new_slots[slot] = (uint32_t)i + 1;
+    }
+
+    free(table->slots);
+    table->slots = new_slots;
+    table->slot_count = new_count;
+
+    return SYMBOL_TABLE_SUCCESS;
+}
+
+// Слот имени в множестве: совпадающий или первый пустой
+static SymbolName* symbol_table_probe_name(SymbolName* slots, uint32_t slot_count,
+                                           const char* name, size_t length, uint32_t hash) {
+    uint32_t mask = slot_count - 1;
+    uint32_t slot = hash & mask;
+
+    while (slots[slot].text &&
+           (slots[slot].hash != hash || slots[slot].length != length ||
+            memcmp(slots[slot].text, name, length) != 0)) {
+        slot = (slot + 1) & mask;
+    }
+
+    return &slots[slot];
+}
+
+const char* symbol_table_intern(SymbolTable* table, const char* name, size_t length, uint32_t hash) {
+    // Коэффициент заполнения не выше 1/2, как и у таблицы меток
+    if ((table->name_count + 1) * 2 > table->name_slot_count) {
+        uint32_t new_count = table->name_slot_count * 2;
+        SymbolName* new_slots = (SymbolName*)calloc(new_count, sizeof(SymbolName));
+        if (!new_slots) {
+            return NULL;
+        }
+
+        for (uint32_t i = 0; i < table->name_slot_count; i++) {
+            const SymbolName* entry = &table->name_slots[i];
+            if (entry->text) {
+                *symbol_table_probe_name(new_slots, new_count, entry->text, entry->length, entry->hash) = *entry;
+            }
+        }
+
+        free(table->name_slots);
+        table->name_slots = new_slots;
+        table->name_slot_count = new_count;
+    }
+
+    SymbolName* entry = symbol_table_probe_name(table->name_slots, table->name_slot_count, name, length, hash);
+    if (entry->text) {
+        return entry->text;
+    }
+
+    char* interned = arena_strndup(&table->names, name, length);
+    if (!interned) {
+        return NULL;
+    }
+
+    entry->text = interned;
+    entry->length = (uint32_t)length;
+    entry->hash = hash;
+    table->name_count++;
+
+    return interned;
+}
+
+int symbol_table_add(SymbolTable* table, const char* name, size_t length, uint32_t hash,
+                     uint16_t address, const Label** out_label) {
+    // Коэффициент заполнения не выше 1/2
+    if ((uint32_t)(table->count + 1) * 2 > table->slot_count) {
+        if (symbol_table_grow_slots(table) != SYMBOL_TABLE_SUCCESS) {
+            return SYMBOL_TABLE_NO_MEMORY;
+        }
+    }
+
+    uint32_t slot = symbol_table_probe(table, name, length, hash);
+    if (table->slots[slot] != 0) {
+        if (out_label) {
+            *out_label = &table->labels[table->slots[slot] - 1];
+        }
+        return SYMBOL_TABLE_DUPLICATE;
+    }
+
+    if (table->count == table->capacity) {
+        int new_capacity = table->capacity ? table->capacity * 2 : SYMBOL_TABLE_INITIAL_SLOTS / 2;
+        Label* new_labels = (Label*)realloc(table->labels, (size_t)new_capacity * sizeof(Label));
+        if (!new_labels) {
+            return SYMBOL_TABLE_NO_MEMORY;
+        }
+        table->labels = new_labels;
+        table->capacity = new_capacity;
+    }
+
+    const char* interned = symbol_table_intern(table, name, length, hash);
+    if (!interned) {
+        return SYMBOL_TABLE_NO_MEMORY;
+    }
+
+    Label* label = &table->labels[table->count];
+    label->name = interned;
+    label->name_length = (uint32_t)length;
+    label->hash = hash;
+    label->address = address;
+    label->line_number = 0;
+
+    table->slots[slot] = (uint32_t)table->count + 1;
+    table->count++;
+
+    if (out_label) {
+        *out_label = label;
+    }
+
+    return SYMBOL_TABLE_SUCCESS;
+}
+
+const Label* symbol_table_find(const SymbolTable* table, const char* name, size_t length, uint32_t hash) {
+    if (!table || !table->slots) {
+        return NULL;
+    }
+
+    uint32_t entry = table->slots[symbol_table_probe(table, name, length, hash)];
+    return entry ? &table->labels[entry - 1] : NULL;
+}
@@ -0,0 +1,31 @@
+#ifndef BENCHMARKHEADER_H
+#define BENCHMARKHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "emulatorHeader.h"
+#include "perfCountersHeader.h"
+
+// Результат замера производительности эмулятора
+typedef struct {
+    int repetitions;                           // Количество выполненных прогонов
+    uint64_t instructions_retired;             // Эмулированные инструкции (сумма по прогонам)
+    double elapsed_seconds;                    // Время выполнения (сумма по прогонам)
+    uint64_t host_counters[PERF_COUNTER_COUNT]; // Аппаратные счётчики хоста (сумма по прогонам)
+    int host_counter_available[PERF_COUNTER_COUNT]; // Флаги доступности счётчиков
+} BenchmarkResult;
+
+// Многократный запуск программы с замером времени и счётчиков хоста.
+// Возвращает код EmulatorErrorCode.
+int benchmark_program(const char* filename, int repetitions, BenchmarkResult* result);
+
+// Запуск уже загруженной программы (каждый прогон начинается с emulator_reset)
+int benchmark_cpu(CPU* cpu, int repetitions, BenchmarkResult* result);
+
+// Эмулированные MIPS
+double benchmark_mips(const BenchmarkResult* result);
+
+// Вывод отчёта: MIPS и счётчики хоста в пересчёте на эмулированную инструкцию
+void benchmark_print_report(const BenchmarkResult* result, FILE* output);
+
+#endif //BENCHMARKHEADER_H
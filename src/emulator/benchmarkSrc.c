@@ -0,0 +1,132 @@
+#include "benchmarkHeader.h"
+#include <time.h>
+
+// Монотонное время в секундах
+static double benchmark_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Один прогон программы без вывода сообщений emulator_run
+static int benchmark_run_once(CPU* cpu) {
+    int result = emulator_execute(cpu);
+    return result == EMULATOR_HALT ? EMULATOR_SUCCESS : result;
+}
+
+int benchmark_cpu(CPU* cpu, int repetitions, BenchmarkResult* result) {
+    if (!cpu || !result || repetitions <= 0) {
+        return EMULATOR_INVALID_INSTRUCTION;
+    }
+
+    memset(result, 0, sizeof(*result));
+
+    // Недоступные счётчики просто не попадают в отчёт
+    PerfCounters counters;
+    perf_counters_open(&counters);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        result->host_counter_available[i] = perf_counter_is_available(&counters, (PerfCounterId)i);
+    }
+
+    int status = EMULATOR_SUCCESS;
+
+    for (int rep = 0; rep < repetitions; rep++) {
+        emulator_reset(cpu);
+
+        perf_counters_start(&counters);
+        double start = benchmark_now();
+
+        status = benchmark_run_once(cpu);
+
+        double end = benchmark_now();
+        perf_counters_stop(&counters);
+
+        if (status != EMULATOR_SUCCESS) {
+            emulator_print_error(status, "Benchmark run failed");
+            break;
+        }
+
+        result->repetitions++;
+        result->instructions_retired += cpu->instructions_retired;
+        result->elapsed_seconds += end - start;
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            result->host_counters[i] += perf_counter_value(&counters, (PerfCounterId)i);
+        }
+    }
+
+    perf_counters_close(&counters);
+
+    return status;
+}
+
+int benchmark_program(const char* filename, int repetitions, BenchmarkResult* result) {
+    if (!filename || !result) {
+        return EMULATOR_INVALID_INSTRUCTION;
+    }
+
+    CPU cpu;
+    int status = emulator_init(&cpu, stdout, 0);
+    if (status != EMULATOR_SUCCESS) {
+        return status;
+    }
+
+    status = emulator_load_program(&cpu, filename);
+    if (status == EMULATOR_SUCCESS) {
+        status = benchmark_cpu(&cpu, repetitions, result);
+    }
+
+    emulator_free(&cpu);
+
+    return status;
+}
+
+double benchmark_mips(const BenchmarkResult* result) {
+    if (!result || result->elapsed_seconds <= 0.0) {
+        return 0.0;
+    }
+    return (double)result->instructions_retired / result->elapsed_seconds / 1e6;
+}
+
+void benchmark_print_report(const BenchmarkResult* result, FILE* output) {
+    if (!result) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+    double emulated = result->instructions_retired > 0 ? (double)result->instructions_retired : 1.0;
+
+    fprintf(out, "Benchmark: %d runs, %llu emulated instructions, %.6f s, %.2f MIPS\n",
+            result->repetitions, (unsigned long long)result->instructions_retired,
+            result->elapsed_seconds, benchmark_mips(result));
+
+    int any_available = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        any_available |= result->host_counter_available[i];
+    }
+
+    if (!any_available) {
+        fprintf(out, "Host counters: unavailable (perf_event_open is not supported or not permitted)\n");
+        return;
+    }
+
+    fprintf(out, "Host counters:                      total   per emulated instr\n");
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (!result->host_counter_available[i]) {
+            fprintf(out, "  %-14s %20s\n", perf_counter_name((PerfCounterId)i), "n/a");
+            continue;
+        }
+        fprintf(out, "  %-14s %20llu   %12.3f\n", perf_counter_name((PerfCounterId)i),
+                (unsigned long long)result->host_counters[i],
+                (double)result->host_counters[i] / emulated);
+    }
+
+    // Производные метрики хоста
+    if (result->host_counter_available[PERF_COUNTER_CYCLES] &&
+        result->host_counter_available[PERF_COUNTER_INSTRUCTIONS] &&
+        result->host_counters[PERF_COUNTER_CYCLES] > 0) {
+        fprintf(out, "  host IPC: %.3f\n",
+                (double)result->host_counters[PERF_COUNTER_INSTRUCTIONS] /
+                (double)result->host_counters[PERF_COUNTER_CYCLES]);
+    }
+}
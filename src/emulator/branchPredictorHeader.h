@@ -0,0 +1,83 @@
+#ifndef BRANCHPREDICTORHEADER_H
+#define BRANCHPREDICTORHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Коды ошибок модели предсказателя
+typedef enum {
+    PREDICTOR_SUCCESS = 0,          // Успешная операция
+    PREDICTOR_INVALID_CONFIG,       // Неверная конфигурация
+    PREDICTOR_ALLOCATION_ERROR,     // Ошибка выделения памяти
+    PREDICTOR_ERROR_COUNT           // Количество кодов ошибок (всегда последний)
+} PredictorErrorCode;
+
+extern const char* PredictorErrorMessages[PREDICTOR_ERROR_COUNT];
+
+// Алгоритмы предсказания направления BNZ
+typedef enum {
+    PREDICTOR_STATIC_NOT_TAKEN = 0, // Всегда "не выполнен"
+    PREDICTOR_STATIC_TAKEN,         // Всегда "выполнен"
+    PREDICTOR_STATIC_BTFN,          // Назад - выполнен, вперёд - не выполнен
+    PREDICTOR_BIMODAL,              // Таблица 2-битных счётчиков по адресу
+    PREDICTOR_GSHARE,               // Счётчики по адресу XOR глобальная история
+    PREDICTOR_TYPE_COUNT            // Количество алгоритмов (всегда последний)
+} PredictorType;
+
+#define PREDICTOR_MAX_TABLE_BITS 16
+
+// Конфигурация предсказателя
+typedef struct {
+    PredictorType type;
+    int table_bits;                 // log2 размера таблицы счётчиков (bimodal, gshare)
+    int history_bits;               // Длина глобальной истории (gshare), <= table_bits
+    int btb_entries;                // Записей в BTB (0 - без BTB, цель известна сразу)
+} PredictorConfig;
+
+// Запись BTB (прямое отображение)
+typedef struct {
+    uint16_t tag;                   // Адрес инструкции перехода
+    uint16_t target;                // Запомненный адрес перехода
+    int valid;
+} BTBEntry;
+
+// Статистика по точке перехода (индекс = адрес BNZ / 4)
+typedef struct {
+    uint64_t executed;
+    uint64_t taken;
+    uint64_t mispredicted;          // Неверно предсказанное направление
+    uint64_t btb_misses;            // Предсказан переход, но цели нет в BTB (или она неверна)
+} BranchSiteStats;
+
+// Состояние предсказателя
+typedef struct BranchPredictor {
+    PredictorConfig config;
+    uint8_t* counters;              // 2-битные насыщающиеся счётчики
+    uint32_t history;               // Глобальная история переходов
+    BTBEntry* btb;
+    uint64_t branches;
+    uint64_t mispredictions;
+    uint64_t btb_misses;
+    BranchSiteStats* per_site;
+    size_t per_site_count;
+} BranchPredictor;
+
+// Конфигурация по умолчанию: gshare, 1024 счётчика, 8 бит истории, BTB на 16 записей
+void predictor_config_default(PredictorConfig* config);
+
+int branch_predictor_init(BranchPredictor* predictor, const PredictorConfig* config, size_t instruction_count);
+void branch_predictor_reset(BranchPredictor* predictor);
+void branch_predictor_free(BranchPredictor* predictor);
+
+// Учёт выполненной инструкции BNZ: предсказание, сравнение с фактом, обучение
+void branch_predictor_observe(BranchPredictor* predictor, uint16_t address, uint16_t target, int taken);
+
+// Имя алгоритма для отчётов
+const char* branch_predictor_type_name(PredictorType type);
+
+// Отчёт: общий процент ошибок и ошибки по точкам перехода
+void branch_predictor_print_report(const BranchPredictor* predictor, FILE* output);
+
+#endif //BRANCHPREDICTORHEADER_H
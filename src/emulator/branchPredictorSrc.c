@@ -0,0 +1,246 @@
+#include "branchPredictorHeader.h"
+
+// Массив строк с сообщениями об ошибках модели предсказателя
+const char* PredictorErrorMessages[PREDICTOR_ERROR_COUNT] = {
+    "Success",                                          // PREDICTOR_SUCCESS
+    "Invalid branch predictor configuration",           // PREDICTOR_INVALID_CONFIG
+    "Branch predictor allocation error"                 // PREDICTOR_ALLOCATION_ERROR
+};
+
+static const char* PredictorTypeNames[PREDICTOR_TYPE_COUNT] = {
+    "static not-taken",                                 // PREDICTOR_STATIC_NOT_TAKEN
+    "static taken",                                     // PREDICTOR_STATIC_TAKEN
+    "static BTFN",                                      // PREDICTOR_STATIC_BTFN
+    "bimodal",                                          // PREDICTOR_BIMODAL
+    "gshare"                                            // PREDICTOR_GSHARE
+};
+
+const char* branch_predictor_type_name(PredictorType type) {
+    if (type < 0 || type >= PREDICTOR_TYPE_COUNT) {
+        return "unknown";
+    }
+    return PredictorTypeNames[type];
+}
+
+void predictor_config_default(PredictorConfig* config) {
+    if (!config) {
+        return;
+    }
+    config->type = PREDICTOR_GSHARE;
+    config->table_bits = 10;
+    config->history_bits = 8;
+    config->btb_entries = 16;
+}
+
+int branch_predictor_init(BranchPredictor* predictor, const PredictorConfig* config, size_t instruction_count) {
+    if (!predictor) {
+        return PREDICTOR_INVALID_CONFIG;
+    }
+
+    memset(predictor, 0, sizeof(*predictor));
+
+    if (config) {
+        predictor->config = *config;
+    } else {
+        predictor_config_default(&predictor->config);
+    }
+
+    PredictorConfig* cfg = &predictor->config;
+    if (cfg->type < 0 || cfg->type >= PREDICTOR_TYPE_COUNT || cfg->btb_entries < 0 ||
+        cfg->table_bits < 0 || cfg->table_bits > PREDICTOR_MAX_TABLE_BITS ||
+        cfg->history_bits < 0 || cfg->history_bits > cfg->table_bits) {
+        return PREDICTOR_INVALID_CONFIG;
+    }
+
+    if (cfg->type == PREDICTOR_BIMODAL || cfg->type == PREDICTOR_GSHARE) {
+        size_t size = (size_t)1 << cfg->table_bits;
+        predictor->counters = (uint8_t*)malloc(size);
+        if (!predictor->counters) {
+            return PREDICTOR_ALLOCATION_ERROR;
+        }
+    }
+
+    if (cfg->btb_entries > 0) {
+        predictor->btb = (BTBEntry*)calloc((size_t)cfg->btb_entries, sizeof(BTBEntry));
+        if (!predictor->btb) {
+            branch_predictor_free(predictor);
+            return PREDICTOR_ALLOCATION_ERROR;
+        }
+    }
+
+    if (instruction_count > 0) {
+        predictor->per_site = (BranchSiteStats*)calloc(instruction_count, sizeof(BranchSiteStats));
+        if (!predictor->per_site) {
+            branch_predictor_free(predictor);
+            return PREDICTOR_ALLOCATION_ERROR;
+        }
+        predictor->per_site_count = instruction_count;
+    }
+
+    branch_predictor_reset(predictor);
+
+    return PREDICTOR_SUCCESS;
+}
+
+void branch_predictor_reset(BranchPredictor* predictor) {
+    if (!predictor) {
+        return;
+    }
+
+    // Счётчики стартуют в состоянии "слабо не выполнен"
+    if (predictor->counters) {
+        memset(predictor->counters, 1, (size_t)1 << predictor->config.table_bits);
+    }
+    if (predictor->btb) {
+        memset(predictor->btb, 0, (size_t)predictor->config.btb_entries * sizeof(BTBEntry));
+    }
+    if (predictor->per_site) {
+        memset(predictor->per_site, 0, predictor->per_site_count * sizeof(BranchSiteStats));
+    }
+
+    predictor->history = 0;
+    predictor->branches = 0;
+    predictor->mispredictions = 0;
+    predictor->btb_misses = 0;
+}
+
+void branch_predictor_free(BranchPredictor* predictor) {
+    if (!predictor) {
+        return;
+    }
+
+    free(predictor->counters);
+    free(predictor->btb);
+    free(predictor->per_site);
+    predictor->counters = NULL;
+    predictor->btb = NULL;
+    predictor->per_site = NULL;
+    predictor->per_site_count = 0;
+}
+
+// Индекс счётчика для адреса перехода
+static size_t predictor_counter_index(const BranchPredictor* predictor, uint16_t address) {
+    size_t mask = ((size_t)1 << predictor->config.table_bits) - 1;
+    size_t index = (size_t)(address >> 2);
+
+    if (predictor->config.type == PREDICTOR_GSHARE) {
+        index ^= predictor->history;
+    }
+
+    return index & mask;
+}
+
+// Предсказание направления
+static int predictor_predict_direction(const BranchPredictor* predictor, uint16_t address, uint16_t target) {
+    switch (predictor->config.type) {
+        case PREDICTOR_STATIC_NOT_TAKEN:
+            return 0;
+        case PREDICTOR_STATIC_TAKEN:
+            return 1;
+        case PREDICTOR_STATIC_BTFN:
+            return target <= address;
+        case PREDICTOR_BIMODAL:
+        case PREDICTOR_GSHARE:
+            return predictor->counters[predictor_counter_index(predictor, address)] >= 2;
+        default:
+            return 0;
+    }
+}
+
+void branch_predictor_observe(BranchPredictor* predictor, uint16_t address, uint16_t target, int taken) {
+    if (!predictor) {
+        return;
+    }
+
+    taken = taken ? 1 : 0;
+    int predicted = predictor_predict_direction(predictor, address, target);
+    int mispredicted = predicted != taken;
+
+    // Выполненный переход требует цели из BTB уже на стадии выборки
+    int btb_miss = 0;
+    BTBEntry* entry = NULL;
+    if (predictor->btb) {
+        entry = &predictor->btb[(address >> 2) % (uint32_t)predictor->config.btb_entries];
+        if (predicted && taken && !(entry->valid && entry->tag == address && entry->target == target)) {
+            btb_miss = 1;
+        }
+    }
+
+    predictor->branches++;
+    predictor->mispredictions += mispredicted;
+    predictor->btb_misses += btb_miss;
+
+    size_t site = address / 4;
+    if (site < predictor->per_site_count) {
+        BranchSiteStats* stats = &predictor->per_site[site];
+        stats->executed++;
+        stats->taken += taken;
+        stats->mispredicted += mispredicted;
+        stats->btb_misses += btb_miss;
+    }
+
+    // Обучение
+    if (predictor->counters) {
+        uint8_t* counter = &predictor->counters[predictor_counter_index(predictor, address)];
+        if (taken && *counter < 3) {
+            (*counter)++;
+        } else if (!taken && *counter > 0) {
+            (*counter)--;
+        }
+    }
+
+    if (predictor->config.type == PREDICTOR_GSHARE && predictor->config.history_bits > 0) {
+        uint32_t history_mask = (1u << predictor->config.history_bits) - 1;
+        predictor->history = ((predictor->history << 1) | (uint32_t)taken) & history_mask;
+    }
+
+    if (entry && taken) {
+        entry->valid = 1;
+        entry->tag = address;
+        entry->target = target;
+    }
+}
+
+void branch_predictor_print_report(const BranchPredictor* predictor, FILE* output) {
+    if (!predictor) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+    double rate = predictor->branches > 0 ?
+                  100.0 * (double)predictor->mispredictions / (double)predictor->branches : 0.0;
+
+    fprintf(out, "Branch predictor: %s", branch_predictor_type_name(predictor->config.type));
+    if (predictor->counters) {
+        fprintf(out, ", %d counters", 1 << predictor->config.table_bits);
+    }
+    if (predictor->config.type == PREDICTOR_GSHARE) {
+        fprintf(out, ", %d history bits", predictor->config.history_bits);
+    }
+    if (predictor->btb) {
+        fprintf(out, ", BTB %d entries", predictor->config.btb_entries);
+    }
+    fprintf(out, "\n");
+
+    fprintf(out, "  branches: %llu, mispredicted: %llu (%.2f%%), BTB misses: %llu\n",
+            (unsigned long long)predictor->branches,
+            (unsigned long long)predictor->mispredictions, rate,
+            (unsigned long long)predictor->btb_misses);
+
+    fprintf(out, "Address | Executed   | Taken      | Mispredicted | Miss %%   | BTB misses\n");
+    fprintf(out, "--------+------------+------------+--------------+----------+-----------\n");
+
+    for (size_t i = 0; i < predictor->per_site_count; i++) {
+        const BranchSiteStats* stats = &predictor->per_site[i];
+        if (stats->executed == 0) {
+            continue;
+        }
+        fprintf(out, "0x%04zX  | %10llu | %10llu | %12llu | %7.2f%% | %10llu\n",
+                i * 4,
+                (unsigned long long)stats->executed,
+                (unsigned long long)stats->taken,
+                (unsigned long long)stats->mispredicted,
+                100.0 * (double)stats->mispredicted / (double)stats->executed,
+                (unsigned long long)stats->btb_misses);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef CACHEHEADER_H
+#define CACHEHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Коды ошибок модели кэша
+typedef enum {
+    CACHE_SUCCESS = 0,              // Успешная операция
+    CACHE_INVALID_CONFIG,           // Неверная конфигурация (размеры должны быть степенями двойки)
+    CACHE_ALLOCATION_ERROR,         // Ошибка выделения памяти
+    CACHE_ERROR_COUNT               // Количество кодов ошибок (всегда последний)
+} CacheErrorCode;
+
+extern const char* CacheErrorMessages[CACHE_ERROR_COUNT];
+
+// Политики замещения
+typedef enum {
+    CACHE_POLICY_LRU = 0,           // Наименее давно использованная строка
+    CACHE_POLICY_FIFO,              // Первая загруженная строка
+    CACHE_POLICY_RANDOM             // Случайная строка (детерминированный генератор)
+} CacheReplacementPolicy;
+
+// Конфигурация уровня кэша (write-back, write-allocate)
+typedef struct {
+    size_t size;                    // Объём в байтах
+    int associativity;              // Количество путей (ways)
+    size_t line_size;               // Размер строки в байтах
+    CacheReplacementPolicy policy;  // Политика замещения
+} CacheConfig;
+
+// Строка кэша
+typedef struct {
+    uint32_t tag;
+    int valid;
+    int dirty;
+    uint64_t stamp;                 // Время последнего обращения (LRU) или загрузки (FIFO)
+} CacheLine;
+
+// Уровень кэша
+typedef struct {
+    CacheConfig config;
+    size_t set_count;
+    int offset_bits;                // log2(line_size)
+    CacheLine* lines;               // set_count * associativity строк
+    uint64_t clock;                 // Счётчик обращений для LRU/FIFO
+    uint32_t random_state;          // Состояние генератора для CACHE_POLICY_RANDOM
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t writebacks;            // Вытеснения изменённых строк
+} CacheLevel;
+
+// Статистика обращений одной инструкции LD/ST (индекс = адрес инструкции / 4)
+typedef struct {
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t l1_misses;
+    uint64_t l2_misses;
+} CacheAccessStats;
+
+// Симулятор кэша данных с необязательным вторым уровнем
+typedef struct CacheSimulator {
+    CacheLevel l1;
+    CacheLevel l2;
+    int has_l2;
+    CacheAccessStats* per_instruction;
+    size_t per_instruction_count;
+} CacheSimulator;
+
+// Конфигурация L1 по умолчанию: 1KB, 2 пути, строка 16 байт, LRU
+void cache_config_default(CacheConfig* config);
+
+// Инициализация (l2_config = NULL - без второго уровня)
+int cache_simulator_init(CacheSimulator* sim, const CacheConfig* l1_config,
+                         const CacheConfig* l2_config, size_t instruction_count);
+void cache_simulator_reset(CacheSimulator* sim);
+void cache_simulator_free(CacheSimulator* sim);
+
+// Обращение к 16-битному слову данных инструкцией по адресу instruction_address
+void cache_simulator_access(CacheSimulator* sim, uint16_t instruction_address,
+                            uint16_t data_address, int is_write);
+
+// Отчёт: общий процент попаданий и промахи по адресам инструкций
+void cache_simulator_print_report(const CacheSimulator* sim, FILE* output);
+
+#endif //CACHEHEADER_H
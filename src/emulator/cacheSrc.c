@@ -0,0 +1,311 @@
+#include "cacheHeader.h"
+
+// Массив строк с сообщениями об ошибках модели кэша
+const char* CacheErrorMessages[CACHE_ERROR_COUNT] = {
+    "Success",                                          // CACHE_SUCCESS
+    "Invalid cache configuration",                      // CACHE_INVALID_CONFIG
+    "Cache allocation error"                            // CACHE_ALLOCATION_ERROR
+};
+
+static const char* CachePolicyNames[] = { "LRU", "FIFO", "random" };
+
+static int is_power_of_two(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+void cache_config_default(CacheConfig* config) {
+    if (!config) {
+        return;
+    }
+    config->size = 1024;
+    config->associativity = 2;
+    config->line_size = 16;
+    config->policy = CACHE_POLICY_LRU;
+}
+
+// Инициализация одного уровня
+static int cache_level_init(CacheLevel* level, const CacheConfig* config) {
+    memset(level, 0, sizeof(*level));
+
+    if (!is_power_of_two(config->size) || !is_power_of_two(config->line_size) ||
+        config->associativity <= 0 || config->line_size < 2 ||
+        config->size < config->line_size * (size_t)config->associativity ||
+        config->policy > CACHE_POLICY_RANDOM) {
+        return CACHE_INVALID_CONFIG;
+    }
+
+    level->config = *config;
+    level->set_count = config->size / (config->line_size * (size_t)config->associativity);
+    if (!is_power_of_two(level->set_count)) {
+        return CACHE_INVALID_CONFIG;
+    }
+
+    while (((size_t)1 << level->offset_bits) < config->line_size) {
+        level->offset_bits++;
+    }
+
+    level->lines = (CacheLine*)calloc(level->set_count * (size_t)config->associativity, sizeof(CacheLine));
+    if (!level->lines) {
+        return CACHE_ALLOCATION_ERROR;
+    }
+
+    level->random_state = 0x2545F491u;
+
+    return CACHE_SUCCESS;
+}
+
+// Обращение к строке уровня. Возвращает 1 при попадании.
+// При вытеснении изменённой строки её адрес записывается в *writeback (если не NULL)
+// и *has_writeback = 1.
+static int cache_level_access(CacheLevel* level, uint32_t address, int is_write,
+                              uint32_t* writeback, int* has_writeback) {
+    uint32_t line_address = address >> level->offset_bits;
+    size_t set = line_address & (level->set_count - 1);
+    uint32_t tag = (uint32_t)(line_address / level->set_count);
+    int ways = level->config.associativity;
+    CacheLine* lines = &level->lines[set * (size_t)ways];
+
+    level->clock++;
+
+    for (int way = 0; way < ways; way++) {
+        if (lines[way].valid && lines[way].tag == tag) {
+            if (level->config.policy == CACHE_POLICY_LRU) {
+                lines[way].stamp = level->clock;
+            }
+            lines[way].dirty |= is_write;
+            level->hits++;
+            return 1;
+        }
+    }
+
+    level->misses++;
+
+    // Выбор строки для замещения: сначала свободная
+    int victim = -1;
+    for (int way = 0; way < ways; way++) {
+        if (!lines[way].valid) {
+            victim = way;
+            break;
+        }
+    }
+
+    if (victim < 0) {
+        if (level->config.policy == CACHE_POLICY_RANDOM) {
+            // xorshift32
+            uint32_t x = level->random_state;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            level->random_state = x;
+            victim = (int)(x % (uint32_t)ways);
+        } else {
+            // LRU и FIFO различаются только моментом обновления stamp
+            victim = 0;
+            for (int way = 1; way < ways; way++) {
+                if (lines[way].stamp < lines[victim].stamp) {
+                    victim = way;
+                }
+            }
+        }
+
+        if (lines[victim].dirty) {
+            level->writebacks++;
+            if (writeback) {
+                uint32_t victim_line = lines[victim].tag * (uint32_t)level->set_count + (uint32_t)set;
+                *writeback = victim_line << level->offset_bits;
+                *has_writeback = 1;
+            }
+        }
+    }
+
+    lines[victim].valid = 1;
+    lines[victim].tag = tag;
+    lines[victim].dirty = is_write;
+    lines[victim].stamp = level->clock;
+
+    return 0;
+}
+
+int cache_simulator_init(CacheSimulator* sim, const CacheConfig* l1_config,
+                         const CacheConfig* l2_config, size_t instruction_count) {
+    if (!sim) {
+        return CACHE_INVALID_CONFIG;
+    }
+
+    memset(sim, 0, sizeof(*sim));
+
+    CacheConfig default_config;
+    cache_config_default(&default_config);
+
+    int result = cache_level_init(&sim->l1, l1_config ? l1_config : &default_config);
+    if (result != CACHE_SUCCESS) {
+        cache_simulator_free(sim);
+        return result;
+    }
+
+    if (l2_config) {
+        result = cache_level_init(&sim->l2, l2_config);
+        if (result != CACHE_SUCCESS) {
+            cache_simulator_free(sim);
+            return result;
+        }
+        sim->has_l2 = 1;
+    }
+
+    if (instruction_count > 0) {
+        sim->per_instruction = (CacheAccessStats*)calloc(instruction_count, sizeof(CacheAccessStats));
+        if (!sim->per_instruction) {
+            cache_simulator_free(sim);
+            return CACHE_ALLOCATION_ERROR;
+        }
+        sim->per_instruction_count = instruction_count;
+    }
+
+    return CACHE_SUCCESS;
+}
+
+// Сброс содержимого кэшей и статистики
+static void cache_level_reset(CacheLevel* level) {
+    if (level->lines) {
+        memset(level->lines, 0, level->set_count * (size_t)level->config.associativity * sizeof(CacheLine));
+    }
+    level->clock = 0;
+    level->hits = 0;
+    level->misses = 0;
+    level->writebacks = 0;
+    level->random_state = 0x2545F491u;
+}
+
+void cache_simulator_reset(CacheSimulator* sim) {
+    if (!sim) {
+        return;
+    }
+
+    cache_level_reset(&sim->l1);
+    if (sim->has_l2) {
+        cache_level_reset(&sim->l2);
+    }
+
+    if (sim->per_instruction) {
+        memset(sim->per_instruction, 0, sim->per_instruction_count * sizeof(CacheAccessStats));
+    }
+}
+
+void cache_simulator_free(CacheSimulator* sim) {
+    if (!sim) {
+        return;
+    }
+
+    free(sim->l1.lines);
+    free(sim->l2.lines);
+    free(sim->per_instruction);
+    sim->l1.lines = NULL;
+    sim->l2.lines = NULL;
+    sim->per_instruction = NULL;
+    sim->per_instruction_count = 0;
+    sim->has_l2 = 0;
+}
+
+// Обращение к одной строке через иерархию
+static void cache_simulator_access_line(CacheSimulator* sim, CacheAccessStats* stats,
+                                        uint32_t address, int is_write) {
+    uint32_t writeback = 0;
+    int has_writeback = 0;
+    if (cache_level_access(&sim->l1, address, is_write, &writeback, &has_writeback)) {
+        return;
+    }
+
+    if (stats) {
+        stats->l1_misses++;
+    }
+
+    // Без L2 вытеснение и загрузка строки идут в память и не моделируются
+    if (!sim->has_l2) {
+        return;
+    }
+
+    // Вытесненная изменённая строка L1 записывается в L2. Это трафик
+    // вытеснения, а не промах инструкции: в stats не учитывается.
+    if (has_writeback) {
+        cache_level_access(&sim->l2, writeback, 1, NULL, NULL);
+    }
+
+    // Промах L1: строка читается из L2
+    if (!cache_level_access(&sim->l2, address, 0, NULL, NULL)) {
+        if (stats) {
+            stats->l2_misses++;
+        }
+    }
+}
+
+void cache_simulator_access(CacheSimulator* sim, uint16_t instruction_address,
+                            uint16_t data_address, int is_write) {
+    if (!sim) {
+        return;
+    }
+
+    CacheAccessStats* stats = NULL;
+    size_t index = instruction_address / 4;
+    if (index < sim->per_instruction_count) {
+        stats = &sim->per_instruction[index];
+        if (is_write) {
+            stats->writes++;
+        } else {
+            stats->reads++;
+        }
+    }
+
+    cache_simulator_access_line(sim, stats, data_address, is_write);
+
+    // Невыровненное слово может пересечь границу строки
+    uint32_t last_byte = (uint32_t)data_address + 1;
+    if ((last_byte >> sim->l1.offset_bits) != ((uint32_t)data_address >> sim->l1.offset_bits)) {
+        cache_simulator_access_line(sim, stats, last_byte, is_write);
+    }
+}
+
+static double cache_hit_rate(uint64_t hits, uint64_t misses) {
+    uint64_t total = hits + misses;
+    return total > 0 ? 100.0 * (double)hits / (double)total : 0.0;
+}
+
+static void cache_level_print(const char* name, const CacheLevel* level, FILE* out) {
+    fprintf(out, "  %s: %zu B, %d-way, %zu B lines, %s: %llu hits, %llu misses (%.2f%% hit rate), %llu writebacks\n",
+            name, level->config.size, level->config.associativity, level->config.line_size,
+            CachePolicyNames[level->config.policy],
+            (unsigned long long)level->hits, (unsigned long long)level->misses,
+            cache_hit_rate(level->hits, level->misses),
+            (unsigned long long)level->writebacks);
+}
+
+void cache_simulator_print_report(const CacheSimulator* sim, FILE* output) {
+    if (!sim) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+
+    fprintf(out, "Data cache:\n");
+    cache_level_print("L1", &sim->l1, out);
+    if (sim->has_l2) {
+        cache_level_print("L2", &sim->l2, out);
+    }
+
+    fprintf(out, "Address | Reads      | Writes     | L1 misses  | L1 miss %%  | L2 misses\n");
+    fprintf(out, "--------+------------+------------+------------+------------+-----------\n");
+
+    for (size_t i = 0; i < sim->per_instruction_count; i++) {
+        const CacheAccessStats* stats = &sim->per_instruction[i];
+        uint64_t accesses = stats->reads + stats->writes;
+        if (accesses == 0) {
+            continue;
+        }
+        fprintf(out, "0x%04zX  | %10llu | %10llu | %10llu | %9.2f%% | %10llu\n",
+                i * 4,
+                (unsigned long long)stats->reads,
+                (unsigned long long)stats->writes,
+                (unsigned long long)stats->l1_misses,
+                100.0 * (double)stats->l1_misses / (double)accesses,
+                (unsigned long long)stats->l2_misses);
+    }
+}
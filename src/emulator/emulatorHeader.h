@@ -7,6 +7,7 @@
 #include <string.h>
 #include "memoryHeader.h"
 #include "../assembler/parserHeader.h"
+#include "../assembler/assemblerHeader.h"
 
 // Размеры и константы
 #define REGISTERFILESIZE 2           // Размер регистра в байтах (16 бит)
@@ -14,6 +15,16 @@
 #define INSTRUCTION_SIZE 4          // Размер инструкции в байтах
 #define INSTR_ADDR_MASK 0x0000FFFC  // Маска для выравнивания адреса инструкции (кратно 4)
 
+// Необязательные модели, наблюдающие за выполнением (см. timingHeader.h)
+struct TimingModel;
+struct CacheSimulator;
+struct BranchPredictor;
+struct DebugMap;                   // Отладочная карта (см. ../assembler/debugMapHeader.h)
+struct ExecutionProfile;           // Профиль выполнения (см. ../assembler/profileHeader.h)
+struct VerifiedProgram;            // Проверенная программа (см. verifierHeader.h)
+struct LoopDetector;               // Обнаружение бесконечного цикла (см. loopDetectorHeader.h)
+struct TieredExecutor;             // Многоуровневое выполнение (см. tieringHeader.h)
+
 // Коды ошибок эмулятора
 typedef enum {
     EMULATOR_SUCCESS = 0,           // Успешная операция
@@ -22,6 +33,7 @@ typedef enum {
     EMULATOR_DIVISION_BY_ZERO,      // Деление на ноль
     EMULATOR_INVALID_REGISTER,      // Неверный регистр
     EMULATOR_HALT,                  // Остановка эмулятора (не ошибка)
+    EMULATOR_NONTERMINATING,        // Состояние повторилось: программа не завершится
     EMULATOR_ERROR_COUNT            // Количество кодов ошибок (всегда последний)
 } EmulatorErrorCode;
 
@@ -36,6 +48,15 @@ typedef struct {
     int running;                   // Флаг работы процессора
     FILE* output_stream;           // Поток вывода для результатов
     int debug_mode;                // Флаг включения отладочного вывода
+    uint64_t instructions_retired; // Количество выполненных инструкций
+    struct TimingModel* timing_model; // Потактовая модель конвейера (NULL - отключена)
+    struct CacheSimulator* data_cache; // Модель кэша данных для LD/ST (NULL - отключена)
+    struct BranchPredictor* branch_predictor; // Модель предсказателя для BNZ (NULL - отключена)
+    const struct DebugMap* debug_map; // Адреса -> строки исходника для сообщений (NULL - нет)
+    struct ExecutionProfile* profile; // Счётчики выполнения для раскладки кода (NULL - не собирать)
+    struct VerifiedProgram* verified_program; // Результат проверки при загрузке (NULL - не проверялась)
+    struct LoopDetector* loop_detector; // Поиск повтора состояния на переходах назад (NULL - отключён)
+    struct TieredExecutor* tiering; // Уровни выполнения по горячести участков (NULL - один уровень)
 } CPU;
 
 // Функции инициализации
@@ -43,6 +64,7 @@ int emulator_init(CPU* cpu, FILE* output_stream, int debug_mode);
 int emulator_init_default(CPU* cpu);
 int emulator_init_with_debug(CPU* cpu, int debug_mode);
 void emulator_free(CPU* cpu);
+void emulator_reset(CPU* cpu);
 
 // Функции для работы с регистрами
 uint16_t emulator_get_register(CPU* cpu, uint8_t reg_num);
@@ -53,10 +75,46 @@ void emulator_dump_registers(CPU* cpu, FILE* output);
 int emulator_decode_instruction(CPU* cpu, uint32_t instruction);
 int emulator_fetch_execute_cycle(CPU* cpu);
 
+// Подключение моделей производительности (NULL отключает модель)
+void emulator_attach_timing_model(CPU* cpu, struct TimingModel* model);
+void emulator_attach_data_cache(CPU* cpu, struct CacheSimulator* cache);
+void emulator_attach_branch_predictor(CPU* cpu, struct BranchPredictor* predictor);
+void emulator_attach_debug_map(CPU* cpu, const struct DebugMap* map);
+// Профиль создаётся profile_init по загруженной памяти инструкций
+void emulator_attach_profile(CPU* cpu, struct ExecutionProfile* profile);
+// Детектор создаётся loop_detector_init по памяти данных CPU; при его
+// подключении emulator_run завершает бесконечный цикл с EMULATOR_NONTERMINATING
+void emulator_attach_loop_detector(CPU* cpu, struct LoopDetector* detector);
+// Исполнитель создаётся tiering_init по проверенной программе; используется
+// emulator_execute, пока программа не перезагружена
+void emulator_attach_tiering(CPU* cpu, struct TieredExecutor* executor);
+
 // Выполнение программы
 int emulator_load_program(CPU* cpu, const char* filename);
+int emulator_load_image(CPU* cpu, const ProgramImage* image);
 int emulator_run(CPU* cpu);
 
+// Проверка загруженной программы (вызывается при загрузке); VERIFIER_SUCCESS -
+// программа выполняется без проверок регистров и адресов переходов, участки
+// готовятся при выполнении (в режиме отладки - сразу, для итогов). Иначе
+// программа выполняется с проверками; причину можно получить по коду
+// и cpu->verified_program->diagnostic, в режиме отладки она выводится.
+int emulator_verify(CPU* cpu);
+
+// Выполнение до остановки или ошибки без итоговых сообщений: EMULATOR_HALT
+// или код ошибки. Проверенная программа без наблюдающих моделей и отладки
+// выполняется по предекодированным инструкциям.
+int emulator_execute(CPU* cpu);
+
+// Выполнение проверенной программы (см. verifierHeader.h) с начала участка
+// *index до остановки или ошибки. Участки, в которые переходит выполнение,
+// подготовлены. chained - оставшиеся переходы по номерам участков (NULL -
+// без ограничений): переход в участок уменьшает его счётчик, при переходе в
+// участок с нулевым счётчиком возвращается EMULATOR_SUCCESS, *index указывает
+// на этот участок. При остановке и ошибке IP и running устанавливаются как
+// в emulator_execute.
+int emulator_execute_verified(CPU* cpu, const struct VerifiedProgram* program, uint32_t* index, uint32_t* chained);
+
 // Вспомогательные функции
 void emulator_print_error(int error_code, const char* custom_message);
 
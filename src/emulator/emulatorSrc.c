@@ -1,4 +1,14 @@
 #include "emulatorHeader.h"
+#include "timingHeader.h"
+#include "cacheHeader.h"
+#include "branchPredictorHeader.h"
+#include "metricsHeader.h"
+#include "verifierHeader.h"
+#include "loopDetectorHeader.h"
+#include "tieringHeader.h"
+#include "packedHeader.h"
+#include "../assembler/debugMapHeader.h"
+#include "../assembler/profileHeader.h"
 
 // Массив строк с сообщениями об ошибках эмулятора
 const char* EmulatorErrorMessages[EMULATOR_ERROR_COUNT] = {
@@ -7,7 +17,8 @@ const char* EmulatorErrorMessages[EMULATOR_ERROR_COUNT] = {
     "Memory error",                   // EMULATOR_MEMORY_ERROR
     "Division by zero",               // EMULATOR_DIVISION_BY_ZERO
     "Invalid register",               // EMULATOR_INVALID_REGISTER
-    "Emulator halted"                 // EMULATOR_HALT
+    "Emulator halted",                // EMULATOR_HALT
+    "Program does not terminate"      // EMULATOR_NONTERMINATING
 };
 
 // Вспомогательные функции для вывода ошибок
@@ -43,6 +54,15 @@ int emulator_init(CPU* cpu, FILE* output_stream, int debug_mode) {
     memset(cpu->RF, 0, sizeof(cpu->RF));
     
     cpu->running = 0;
+    cpu->instructions_retired = 0;
+    cpu->timing_model = NULL;
+    cpu->data_cache = NULL;
+    cpu->branch_predictor = NULL;
+    cpu->debug_map = NULL;
+    cpu->profile = NULL;
+    cpu->verified_program = NULL;
+    cpu->loop_detector = NULL;
+    cpu->tiering = NULL;
     
     // Если поток вывода не указан, используем stdout
     cpu->output_stream = output_stream ? output_stream : stdout;
@@ -71,6 +91,8 @@ void emulator_free(CPU* cpu) {
     
     // Освобождение памяти
     memory_free(&cpu->memory);
+    verified_program_free(cpu->verified_program);
+    cpu->verified_program = NULL;
     
     // Сброс регистров
     cpu->IP = 0;
@@ -80,6 +102,23 @@ void emulator_free(CPU* cpu) {
     cpu->output_stream = NULL;
 }
 
+// Сброс состояния CPU перед повторным запуском программы (память инструкций сохраняется)
+void emulator_reset(CPU* cpu) {
+    if (!cpu) {
+        return;
+    }
+    
+    cpu->IP = 0;
+    memset(cpu->RF, 0, sizeof(cpu->RF));
+    
+    if (cpu->memory.initialized) {
+        memset(cpu->memory.data_memory, 0, cpu->memory.data_size);
+    }
+    
+    cpu->running = 0;
+    cpu->instructions_retired = 0;
+}
+
 // Получение значения регистра
 uint16_t emulator_get_register(CPU* cpu, uint8_t reg_num) {
     if (!cpu || reg_num >= NUM_REGISTERS) {
@@ -121,6 +160,83 @@ void emulator_dump_registers(CPU* cpu, FILE* output) {
     fprintf(out, "\n");
 }
 
+// Подключение потактовой модели конвейера
+void emulator_attach_timing_model(CPU* cpu, struct TimingModel* model) {
+    if (!cpu) {
+        return;
+    }
+    cpu->timing_model = model;
+}
+
+// Подключение модели кэша данных
+void emulator_attach_data_cache(CPU* cpu, struct CacheSimulator* cache) {
+    if (!cpu) {
+        return;
+    }
+    cpu->data_cache = cache;
+}
+
+// Подключение модели предсказателя переходов
+void emulator_attach_branch_predictor(CPU* cpu, struct BranchPredictor* predictor) {
+    if (!cpu) {
+        return;
+    }
+    cpu->branch_predictor = predictor;
+}
+
+void emulator_attach_debug_map(CPU* cpu, const struct DebugMap* map) {
+    if (!cpu) {
+        return;
+    }
+    cpu->debug_map = map;
+}
+
+void emulator_attach_profile(CPU* cpu, struct ExecutionProfile* profile) {
+    if (!cpu) {
+        return;
+    }
+    cpu->profile = profile;
+}
+
+void emulator_attach_loop_detector(CPU* cpu, struct LoopDetector* detector) {
+    if (!cpu) {
+        return;
+    }
+    cpu->loop_detector = detector;
+}
+
+void emulator_attach_tiering(CPU* cpu, struct TieredExecutor* executor) {
+    if (!cpu) {
+        return;
+    }
+    cpu->tiering = executor;
+}
+
+// Проверка загруженной программы; при ошибке программа молча выполняется
+// с проверками (причина выводится только в режиме отладки)
+int emulator_verify(CPU* cpu) {
+    if (!cpu) {
+        return VERIFIER_ERROR_EMPTY;
+    }
+    
+    verified_program_free(cpu->verified_program);
+    cpu->verified_program = NULL;
+    
+    int result = verifier_build(cpu->memory.instruction_memory, cpu->memory.program_size,
+                                cpu->memory.instruction_generation, &cpu->verified_program);
+    if (result != VERIFIER_SUCCESS && result != VERIFIER_ERROR_NO_MEMORY && cpu->debug_mode) {
+        char text[128];
+        verifier_format_diagnostic(&cpu->verified_program->diagnostic, text, sizeof(text));
+        fprintf(cpu->output_stream, "Verification failed: %s; running with runtime checks\n", text);
+    } else if (result == VERIFIER_SUCCESS && cpu->debug_mode) {
+        // Итоги по всей программе; без отладки участки готовятся при выполнении
+        verifier_prepare_all(cpu->verified_program);
+        verifier_print_summary(cpu->verified_program, cpu->output_stream);
+    }
+    
+    return result;
+}
+
 // Загрузка программы из файла
 int emulator_load_program(CPU* cpu, const char* filename) {
     if (!cpu || !filename) {
@@ -135,6 +251,26 @@ int emulator_load_program(CPU* cpu, const char* filename) {
     
     // Сброс указателя команд
     cpu->IP = 0;
+    emulator_verify(cpu);
+    
+    return EMULATOR_SUCCESS;
+}
+
+// Загрузка программы из образа в памяти (см. assemble_buffer)
+int emulator_load_image(CPU* cpu, const ProgramImage* image) {
+    if (!cpu || !image) {
+        return EMULATOR_INVALID_INSTRUCTION;
+    }
+    
+    int result = memory_load_image(&cpu->memory, image->code, image->size);
+    if (result != MEMORY_SUCCESS) {
+        emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to load program image");
+        return EMULATOR_MEMORY_ERROR;
+    }
+    
+    // Сброс указателя команд
+    cpu->IP = 0;
+    emulator_verify(cpu);
     
     return EMULATOR_SUCCESS;
 }
@@ -152,34 +288,32 @@ int emulator_decode_instruction(CPU* cpu, uint32_t instruction) {
     uint8_t dst_or_const_lo_or_src2 = instruction & 0xFF;
     
     if (cpu->debug_mode) {
-        fprintf(cpu->output_stream, "[ОТЛАДКА] IP=0x%04X: Инструкция=0x%08X, опкод=%d, операнды: %d, %d, %d\n",
-               cpu->IP, instruction, opcode, src0, src1_or_const_hi, dst_or_const_lo_or_src2);
-    }
-    
-    // Проверка валидности регистров src0
-    if (src0 >= NUM_REGISTERS && opcode != OPC_SET_CONST && opcode != OPC_READY) {
-        emulator_print_error(EMULATOR_INVALID_REGISTER, "Invalid src0 register");
-        return EMULATOR_INVALID_REGISTER;
-    }
-    
-    // Дополнительная проверка валидности регистров src1/dst в зависимости от формата
-    if ((opcode <= OPC_LD || opcode == OPC_ST) && src1_or_const_hi >= NUM_REGISTERS) {
-        emulator_print_error(EMULATOR_INVALID_REGISTER, "Invalid src1 register");
-        return EMULATOR_INVALID_REGISTER;
-    }
-    
-    if (opcode <= OPC_XOR && dst_or_const_lo_or_src2 >= NUM_REGISTERS) {
-        emulator_print_error(EMULATOR_INVALID_REGISTER, "Invalid dst register");
-        return EMULATOR_INVALID_REGISTER;
+        char text[32];
+        if (isa_disassemble(instruction, text, sizeof(text)) < 0) {
+            strcpy(text, "???");
+        }
+        fprintf(cpu->output_stream, "[ОТЛАДКА] IP=0x%04X: Инструкция=0x%08X (%s), опкод=%d, операнды: %d, %d, %d\n",
+               cpu->IP, instruction, text, opcode, src0, src1_or_const_hi, dst_or_const_lo_or_src2);
+        if (cpu->debug_map) {
+            char location[256];
+            debug_map_format_location(cpu->debug_map, cpu->IP, location, sizeof(location));
+            fprintf(cpu->output_stream, "[ОТЛАДКА] Исходник: %s\n", location);
+        }
     }
     
-    if (opcode == OPC_BNZ && src0 >= NUM_REGISTERS) {
-        emulator_print_error(EMULATOR_INVALID_REGISTER, "Invalid src0 register for BNZ");
-        return EMULATOR_INVALID_REGISTER;
+    // Проверка кода операции и полей-регистров по таблице ISA (без цепочки сравнений)
+    const IsaInstruction* isa = isa_lookup_opcode(opcode);
+    if (!(isa->flags & ISA_FLAG_VALID)) {
+        emulator_print_error(EMULATOR_INVALID_INSTRUCTION, "Unknown opcode");
+        return EMULATOR_INVALID_INSTRUCTION;
     }
     
-    if (opcode == OPC_ST && dst_or_const_lo_or_src2 >= NUM_REGISTERS) {
-        emulator_print_error(EMULATOR_INVALID_REGISTER, "Invalid src2 register for ST");
+    uint8_t invalid_fields = isa_invalid_register_fields(instruction) & isa->register_fields;
+    if (invalid_fields) {
+        static const char* field_messages[] = {
+            "Invalid src0 register", "Invalid src1 register", "Invalid dst/src2 register"
+        };
+        emulator_print_error(EMULATOR_INVALID_REGISTER, field_messages[__builtin_ctz(invalid_fields)]);
         return EMULATOR_INVALID_REGISTER;
     }
     
@@ -259,6 +393,7 @@ int emulator_decode_instruction(CPU* cpu, uint32_t instruction) {
                 uint8_t target_reg = dst_or_const_lo_or_src2;
                 
                 uint16_t addr = cpu->RF[base_reg] + cpu->RF[offset_reg];
+                
                 uint16_t value;
                 int result = memory_read_word(&cpu->memory, addr, &value);
                 
@@ -267,6 +402,11 @@ int emulator_decode_instruction(CPU* cpu, uint32_t instruction) {
                     return EMULATOR_MEMORY_ERROR;
                 }
                 
+                // Кэш видит только состоявшиеся обращения
+                if (cpu->data_cache) {
+                    cache_simulator_access(cpu->data_cache, cpu->IP, addr, 0);
+                }
+                
                 if (cpu->debug_mode) {
                     fprintf(cpu->output_stream, "[ОТЛАДКА LD] IP=0x%04X: Чтение из памяти по адресу 0x%04X (R%d[0x%04X] + R%d[0x%04X]), значение=0x%04X -> R%d\n",
                            cpu->IP, addr, base_reg, cpu->RF[base_reg], offset_reg, cpu->RF[offset_reg], value, target_reg);
@@ -305,12 +445,20 @@ int emulator_decode_instruction(CPU* cpu, uint32_t instruction) {
                            cpu->IP, addr, base_reg, cpu->RF[base_reg], offset_reg, cpu->RF[offset_reg], value_reg, value);
                 }
                 
+                if (cpu->loop_detector) {
+                    loop_detector_observe_store(cpu->loop_detector, cpu->memory.data_memory, addr, value);
+                }
+                
                 int result = memory_write_word(&cpu->memory, addr, value);
                 
                 if (result != MEMORY_SUCCESS) {
                     emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
                     return EMULATOR_MEMORY_ERROR;
                 }
+                
+                if (cpu->data_cache) {
+                    cache_simulator_access(cpu->data_cache, cpu->IP, addr, 1);
+                }
             }
             break;
             
@@ -343,6 +491,95 @@ int emulator_decode_instruction(CPU* cpu, uint32_t instruction) {
             }
             break;
             
+        case OPC_ADDSB:
+            // RF[dst] <- по дорожкам min(RF[src_0] + RF[src_1], 0xFF)
+            cpu->RF[dst_or_const_lo_or_src2] = packed_add_saturate(cpu->RF[src0], cpu->RF[src1_or_const_hi]);
+            break;
+            
+        case OPC_SUBSB:
+            // RF[dst] <- по дорожкам max(RF[src_0] - RF[src_1], 0)
+            cpu->RF[dst_or_const_lo_or_src2] = packed_sub_saturate(cpu->RF[src0], cpu->RF[src1_or_const_hi]);
+            break;
+            
+        case OPC_CMPGEB:
+            // RF[dst] <- по дорожкам (RF[src_0] >= RF[src_1]) ? 0xFF : 0x00
+            cpu->RF[dst_or_const_lo_or_src2] = packed_compare_ge(cpu->RF[src0], cpu->RF[src1_or_const_hi]);
+            break;
+            
+        case OPC_MINB:
+            cpu->RF[dst_or_const_lo_or_src2] = packed_min(cpu->RF[src0], cpu->RF[src1_or_const_hi]);
+            break;
+            
+        case OPC_MAXB:
+            cpu->RF[dst_or_const_lo_or_src2] = packed_max(cpu->RF[src0], cpu->RF[src1_or_const_hi]);
+            break;
+            
+        case OPC_LDM:
+            // RF[group + k] <- MEM[ADDR + 2k], k < ISA_GROUP_SIZE, где ADDR = RF[src_0] + RF[src_1]
+            {
+                uint8_t group = dst_or_const_lo_or_src2;
+                uint16_t addr = cpu->RF[src0] + cpu->RF[src1_or_const_hi];
+                
+                uint16_t values[ISA_GROUP_SIZE];
+                if (memory_read_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+                    emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to read memory");
+                    return EMULATOR_MEMORY_ERROR;
+                }
+                
+                if (cpu->data_cache) {
+                    for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                        cache_simulator_access(cpu->data_cache, cpu->IP, (uint16_t)(addr + 2 * k), 0);
+                    }
+                }
+                
+                if (cpu->debug_mode) {
+                    fprintf(cpu->output_stream, "[ОТЛАДКА LDM] IP=0x%04X: Чтение %d слов с адреса 0x%04X -> R%d..R%d\n",
+                           cpu->IP, ISA_GROUP_SIZE, addr, group, (group + ISA_GROUP_SIZE - 1) & 0x0F);
+                }
+                
+                for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                    cpu->RF[(group + k) & 0x0F] = values[k];
+                }
+            }
+            break;
+            
+        case OPC_STM:
+            // MEM[ADDR + 2k] <- RF[group + k], k < ISA_GROUP_SIZE, где ADDR = RF[src_0] + RF[src_1]
+            {
+                uint8_t group = dst_or_const_lo_or_src2;
+                uint16_t addr = cpu->RF[src0] + cpu->RF[src1_or_const_hi];
+                
+                uint16_t values[ISA_GROUP_SIZE];
+                for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                    values[k] = cpu->RF[(group + k) & 0x0F];
+                }
+                
+                if (cpu->debug_mode) {
+                    fprintf(cpu->output_stream, "[ОТЛАДКА STM] IP=0x%04X: Запись R%d..R%d в %d слов с адреса 0x%04X\n",
+                           cpu->IP, group, (group + ISA_GROUP_SIZE - 1) & 0x0F, ISA_GROUP_SIZE, addr);
+                }
+                
+                // Запись либо выполняется целиком, либо не меняет память
+                if (cpu->loop_detector && (size_t)addr + 2 * ISA_GROUP_SIZE - 1 < cpu->memory.data_size) {
+                    for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                        loop_detector_observe_store(cpu->loop_detector, cpu->memory.data_memory,
+                                                    (uint16_t)(addr + 2 * k), values[k]);
+                    }
+                }
+                
+                if (memory_write_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+                    emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
+                    return EMULATOR_MEMORY_ERROR;
+                }
+                
+                if (cpu->data_cache) {
+                    for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                        cache_simulator_access(cpu->data_cache, cpu->IP, (uint16_t)(addr + 2 * k), 1);
+                    }
+                }
+            }
+            break;
+            
         case OPC_READY:
             // IP<-0; конец работы
             cpu->IP = 0;
@@ -385,11 +622,302 @@ int emulator_fetch_execute_cycle(CPU* cpu) {
     }
     
     // Декодирование и выполнение инструкции
-    return emulator_decode_instruction(cpu, instruction);
+    uint16_t address = cpu->IP;
+    result = emulator_decode_instruction(cpu, instruction);
+    if (result == EMULATOR_SUCCESS || result == EMULATOR_HALT) {
+        cpu->instructions_retired++;
+        
+        if (cpu->timing_model || cpu->branch_predictor || cpu->profile || cpu->loop_detector) {
+            int branch_taken = result == EMULATOR_SUCCESS &&
+                               cpu->IP != (uint16_t)(address + INSTRUCTION_SIZE);
+            
+            if (cpu->timing_model) {
+                timing_model_observe(cpu->timing_model, address, instruction, branch_taken);
+            }
+            
+            if (cpu->branch_predictor && ((instruction >> 24) & 0xFF) == OPC_BNZ) {
+                branch_predictor_observe(cpu->branch_predictor, address,
+                                         (uint16_t)(instruction & 0xFFFF), branch_taken);
+            }
+            
+            if (cpu->profile) {
+                profile_record(cpu->profile, address, branch_taken);
+            }
+            
+            // Повтор состояния проверяется только на переходах назад
+            if (cpu->loop_detector && branch_taken && cpu->IP <= address &&
+                loop_detector_observe_branch(cpu->loop_detector, address, cpu->IP,
+                                             cpu->RF, cpu->memory.data_memory)) {
+                return EMULATOR_NONTERMINATING;
+            }
+        }
+    }
+    
+    return result;
 }
 
-// Запуск программы
-int emulator_run(CPU* cpu) {
+// Выполнение проверенной программы по линейным участкам с начала участка
+// *index_io. Номера регистров, коды операций и цели переходов проверены при
+// загрузке, программа заканчивается ready, поэтому проверки регистров и конца
+// программы не нужны. Адреса ld/st прошедших проверок участка (см.
+// verifierHeader.h) не проверяются, счётные циклы пропускаются за одно
+// вычисление, переходы идут по указателям на участки-преемники. Вычисления
+// совпадают с emulator_decode_instruction, кроме удалённых мёртвых записей.
+// Выполняемые участки подготовлены (verifier_prepare_block).
+int emulator_execute_verified(CPU* cpu, const VerifiedProgram* program, uint32_t* index_io, uint32_t* chained) {
+    const DecodedInstruction* code = program->instructions;
+    uint16_t* RF = cpu->RF;
+    uint8_t* data = cpu->memory.data_memory;
+    size_t data_size = cpu->memory.data_size;
+    const VerifiedBlock* block = &program->blocks[program->block_index[*index_io]];
+    uint32_t index = block->first;
+    uint64_t retired = 0;
+    int result = EMULATOR_SUCCESS;
+    
+    for (;;) {
+        // Счётный цикл без побочных эффектов: сразу состояние на выходе
+        if (block->loop) {
+            uint32_t trips = counted_loop_trip_count(block->loop, RF);
+            if (trips >= COUNTED_LOOP_MIN_TRIPS) {
+                counted_loop_fast_forward(block->loop, RF, trips);
+                retired += (uint64_t)trips * (block->end - block->first);
+                block = block->next;
+                goto next_block;
+            }
+        }
+        
+        // Бит g+1 - проверка g участка пройдена (бит 0 - обращения без проверки участка)
+        uint64_t guards_passed = 0;
+        for (uint32_t g = 0; g < block->guard_count; g++) {
+            if (address_guard_passes(&block->guards[g], RF, data_size)) {
+                guards_passed |= (uint64_t)1 << (g + 1);
+            }
+        }
+        
+        for (index = block->first; index < block->end; index++) {
+            const DecodedInstruction* in = &code[index];
+        
+            switch (in->opcode) {
+                case OPC_NOP:
+                    break;
+                
+                case OPC_ADD:
+                    RF[in->field2] = RF[in->field0] + RF[in->field1];
+                    break;
+                
+                case OPC_SUB:
+                    RF[in->field2] = RF[in->field0] - RF[in->field1];
+                    break;
+                
+                case OPC_MUL:
+                    {
+                        uint32_t product = (uint32_t)RF[in->field0] * (uint32_t)RF[in->field1];
+                        RF[in->field2] = product & 0xFFFF;
+                        // operand != 0 - старшая половина не читается (см. verifierHeader.h)
+                        if (!in->operand) {
+                            RF[(in->field2 + 1) & 0x0F] = (product >> 16) & 0xFFFF;
+                        }
+                    }
+                    break;
+                
+                case OPC_DIV:
+                    if (RF[in->field1] == 0) {
+                        emulator_print_error(EMULATOR_DIVISION_BY_ZERO, "Division by zero");
+                        result = EMULATOR_DIVISION_BY_ZERO;
+                        goto done;
+                    }
+                    RF[in->field2] = RF[in->field0] / RF[in->field1];
+                    break;
+                
+                case OPC_CMPGE:
+                    RF[in->field2] = (RF[in->field0] >= RF[in->field1]) ? 1 : 0;
+                    break;
+                
+                case OPC_RSHFT:
+                    RF[in->field2] = RF[in->field0] >> RF[in->field1];
+                    break;
+                
+                case OPC_LSHFT:
+                    RF[in->field2] = RF[in->field0] << RF[in->field1];
+                    break;
+                
+                case OPC_AND:
+                    RF[in->field2] = RF[in->field0] & RF[in->field1];
+                    break;
+                
+                case OPC_OR:
+                    RF[in->field2] = RF[in->field0] | RF[in->field1];
+                    break;
+                
+                case OPC_XOR:
+                    RF[in->field2] = RF[in->field0] ^ RF[in->field1];
+                    break;
+                
+                case OPC_LD:
+                    if ((guards_passed >> in->operand) & 1) {
+                        uint16_t addr = (uint16_t)(RF[in->field0] + RF[in->field1]);
+                        RF[in->field2] = (uint16_t)((data[addr + 1] << 8) | data[addr]);
+                    } else {
+                        uint16_t value;
+                        if (memory_read_word(&cpu->memory, (uint16_t)(RF[in->field0] + RF[in->field1]),
+                                             &value) != MEMORY_SUCCESS) {
+                            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to read memory");
+                            result = EMULATOR_MEMORY_ERROR;
+                            goto done;
+                        }
+                        RF[in->field2] = value;
+                    }
+                    break;
+                
+                case OPC_SET_CONST:
+                    RF[in->field2] = in->operand;
+                    break;
+                
+                case OPC_ST:
+                    if ((guards_passed >> in->operand) & 1) {
+                        uint16_t addr = (uint16_t)(RF[in->field1] + RF[in->field2]);
+                        data[addr] = RF[in->field0] & 0xFF;
+                        data[addr + 1] = (RF[in->field0] >> 8) & 0xFF;
+                    } else if (memory_write_word(&cpu->memory, (uint16_t)(RF[in->field1] + RF[in->field2]),
+                                                 RF[in->field0]) != MEMORY_SUCCESS) {
+                        emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
+                        result = EMULATOR_MEMORY_ERROR;
+                        goto done;
+                    }
+                    break;
+                
+                case OPC_ADDSB:
+                    RF[in->field2] = packed_add_saturate(RF[in->field0], RF[in->field1]);
+                    break;
+                
+                case OPC_SUBSB:
+                    RF[in->field2] = packed_sub_saturate(RF[in->field0], RF[in->field1]);
+                    break;
+                
+                case OPC_CMPGEB:
+                    RF[in->field2] = packed_compare_ge(RF[in->field0], RF[in->field1]);
+                    break;
+                
+                case OPC_MINB:
+                    RF[in->field2] = packed_min(RF[in->field0], RF[in->field1]);
+                    break;
+                
+                case OPC_MAXB:
+                    RF[in->field2] = packed_max(RF[in->field0], RF[in->field1]);
+                    break;
+                
+                case OPC_LDM:
+                    {
+                        uint16_t addr = (uint16_t)(RF[in->field0] + RF[in->field1]);
+                        uint16_t values[ISA_GROUP_SIZE];
+                        if ((guards_passed >> in->operand) & 1) {
+                            for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                                values[k] = (uint16_t)((data[addr + 2 * k + 1] << 8) | data[addr + 2 * k]);
+                            }
+                        } else if (memory_read_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+                            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to read memory");
+                            result = EMULATOR_MEMORY_ERROR;
+                            goto done;
+                        }
+                        for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                            RF[(in->field2 + k) & 0x0F] = values[k];
+                        }
+                    }
+                    break;
+                
+                case OPC_STM:
+                    {
+                        uint16_t addr = (uint16_t)(RF[in->field0] + RF[in->field1]);
+                        uint16_t values[ISA_GROUP_SIZE];
+                        for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                            values[k] = RF[(in->field2 + k) & 0x0F];
+                        }
+                        if ((guards_passed >> in->operand) & 1) {
+                            for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                                data[addr + 2 * k] = values[k] & 0xFF;
+                                data[addr + 2 * k + 1] = (values[k] >> 8) & 0xFF;
+                            }
+                        } else if (memory_write_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+                            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
+                            result = EMULATOR_MEMORY_ERROR;
+                            goto done;
+                        }
+                    }
+                    break;
+                
+                case OPC_BNZ:
+                    if (RF[in->field0] != 0) {
+                        retired++;
+                        block = block->taken;
+                        goto next_block;
+                    }
+                    break;
+                
+                case OPC_READY:
+                    retired++;
+                    result = EMULATOR_HALT;
+                    goto done;
+                
+                default:
+                    emulator_print_error(EMULATOR_INVALID_INSTRUCTION, "Unknown opcode");
+                    result = EMULATOR_INVALID_INSTRUCTION;
+                    goto done;
+            }
+        
+            retired++;
+        }
+        
+        // Проваливание в следующий участок
+        block = block->next;
+    next_block:
+        if (chained) {
+            uint32_t* remaining = &chained[block - program->blocks];
+            if (*remaining == 0) {
+                *index_io = block->first;
+                break;
+            }
+            (*remaining)--;
+        }
+    }
+    
+done:
+    cpu->instructions_retired += retired;
+    if (result == EMULATOR_HALT) {
+        cpu->IP = 0;
+        cpu->running = 0;
+        *index_io = 0;
+    } else if (result != EMULATOR_SUCCESS) {
+        // IP остаётся на инструкции, вызвавшей ошибку
+        cpu->IP = (uint16_t)(index * INSTRUCTION_SIZE);
+        *index_io = index;
+    }
+    return result;
+}
+
+// Можно ли выполнять без проверок: программа проверена и не менялась,
+// за выполнением не наблюдают модели и отладочный вывод
+static const VerifiedProgram* emulator_fast_path(CPU* cpu) {
+    if (cpu->debug_mode || cpu->timing_model || cpu->data_cache ||
+        cpu->branch_predictor || cpu->profile || cpu->loop_detector) {
+        return NULL;
+    }
+    
+    if (!cpu->verified_program ||
+        cpu->verified_program->generation != cpu->memory.instruction_generation) {
+        emulator_verify(cpu);
+    }
+    
+    const VerifiedProgram* program = cpu->verified_program;
+    if (!program || !program->instructions || cpu->IP % INSTRUCTION_SIZE != 0 ||
+        cpu->IP / INSTRUCTION_SIZE >= program->instruction_count ||
+        program->block_index[cpu->IP / INSTRUCTION_SIZE] == VERIFIER_NO_BLOCK) {
+        return NULL;
+    }
+    
+    return program;
+}
+
+int emulator_execute(CPU* cpu) {
     if (!cpu) {
         return EMULATOR_INVALID_INSTRUCTION;
     }
@@ -397,21 +925,76 @@ int emulator_run(CPU* cpu) {
     // Установка флага работы
     cpu->running = 1;
     
-    // Цикл выполнения программы
+    if (cpu->loop_detector) {
+        loop_detector_reset(cpu->loop_detector, cpu->memory.data_memory);
+    }
+    
+    const VerifiedProgram* program = emulator_fast_path(cpu);
+    if (program) {
+        // Многоуровневое выполнение - только для программы, по которой оно подготовлено
+        if (tiering_is_current(cpu->tiering, program)) {
+            return tiering_run(cpu->tiering);
+        }
+        // Без уровней все участки готовятся до начала выполнения
+        if (verifier_prepare_all(cpu->verified_program) == VERIFIER_SUCCESS) {
+            uint32_t index = cpu->IP / INSTRUCTION_SIZE;
+            return emulator_execute_verified(cpu, program, &index, NULL);
+        }
+    }
+    
+    // Цикл выполнения программы с проверками на каждой инструкции
     while (cpu->running) {
         int result = emulator_fetch_execute_cycle(cpu);
-        
-        // Если произошла ошибка или остановка эмулятора
         if (result != EMULATOR_SUCCESS) {
-            if (result == EMULATOR_HALT) {
-                fprintf(cpu->output_stream, "Program execution completed\n");
-                return EMULATOR_SUCCESS;
-            } else {
-                emulator_print_error(result, "Execution error");
-                return result;
-            }
+            return result;
         }
     }
     
-    return EMULATOR_SUCCESS;
-}
\ No newline at end of file
+    return EMULATOR_HALT;
+}
+
+// Выполнение программы до остановки или ошибки с итоговыми сообщениями
+static int emulator_run_program(CPU* cpu) {
+    int result = emulator_execute(cpu);
+    
+    if (result == EMULATOR_HALT) {
+        fprintf(cpu->output_stream, "Program execution completed: %llu instructions retired\n",
+                (unsigned long long)cpu->instructions_retired);
+        return EMULATOR_SUCCESS;
+    }
+    
+    emulator_print_error(result, "Execution error");
+    if (result == EMULATOR_NONTERMINATING && cpu->loop_detector) {
+        loop_detector_print_report(cpu->loop_detector, stderr);
+    }
+    if (cpu->debug_map) {
+        // IP остаётся на инструкции, вызвавшей ошибку
+        char location[256];
+        debug_map_format_location(cpu->debug_map, cpu->IP, location, sizeof(location));
+        fprintf(stderr, "Faulting instruction at %s\n", location);
+    }
+    return result;
+}
+
+// Запуск программы
+int emulator_run(CPU* cpu) {
+    if (!cpu) {
+        return EMULATOR_INVALID_INSTRUCTION;
+    }
+    
+    // Метрики учитываются один раз за прогон, а не на каждой инструкции
+    if (!metrics_is_enabled()) {
+        return emulator_run_program(cpu);
+    }
+    
+    uint64_t start_instructions = cpu->instructions_retired;
+    uint64_t start_ns = metrics_now_ns();
+    metrics_run_started();
+    
+    int result = emulator_run_program(cpu);
+    
+    metrics_run_finished(result, cpu->instructions_retired - start_instructions,
+                         metrics_now_ns() - start_ns);
+    
+    return result;
+}
@@ -0,0 +1,91 @@
+#ifndef LOOPDETECTORHEADER_H
+#define LOOPDETECTORHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Обнаружение бесконечного цикла по повтору состояния машины.
+//
+// Программа не имеет ввода, поэтому её выполнение детерминировано: если
+// состояние (IP, RF, память данных) повторилось, программа не завершится.
+// Бесконечное выполнение обязано бесконечно часто выполнять переходы назад
+// (bnz с целью не больше своего адреса), поэтому состояние сравнивается
+// только на них. Снимок состояния берётся на переходах с номерами 2^k
+// (алгоритм Брента): цикл из L переходов находится не позже чем через
+// 2 * max(предпериод, L) переходов, снимков - O(log) копий памяти.
+//
+// Хеш памяти данных - сумма хешей (адрес, байт) и обновляется при каждой
+// записи st за O(1). Полное сравнение со снимком выполняется только при
+// совпадении хешей, поэтому ложных срабатываний нет.
+
+// Коды ошибок детектора
+typedef enum {
+    LOOP_DETECTOR_SUCCESS = 0,
+    LOOP_DETECTOR_ERROR_NO_MEMORY,   // Не удалось выделить память для снимка
+    LOOP_DETECTOR_ERROR_COUNT        // Количество кодов ошибок (всегда последний)
+} LoopDetectorErrorCode;
+
+extern const char* LoopDetectorErrorMessages[LOOP_DETECTOR_ERROR_COUNT];
+
+#define LOOP_DETECTOR_REGISTERS 16
+
+typedef struct LoopDetector {
+    size_t data_size;
+    uint64_t memory_hash;            // Хеш текущей памяти данных
+
+    // Снимок состояния на переходе назад
+    int snapshot_valid;
+    uint8_t* snapshot_memory;
+    uint64_t snapshot_hash;          // Хеш всего состояния снимка
+    uint16_t snapshot_IP;
+    uint16_t snapshot_RF[LOOP_DETECTOR_REGISTERS];
+    uint64_t power;                  // Переходов до следующего снимка (2^k)
+    uint64_t distance;               // Переходов назад после снимка
+    uint16_t low_address;            // Наименьшая цель перехода после снимка
+    uint16_t high_address;           // Наибольший адрес перехода после снимка
+
+    // Результат
+    uint64_t branches_observed;      // Всего переходов назад
+    int detected;
+    uint16_t loop_start;             // Адреса инструкций цикла
+    uint16_t loop_end;
+    uint64_t cycle_branches;         // Переходов назад за один период
+} LoopDetector;
+
+// Инициализация для памяти данных data размером data_size
+int loop_detector_init(LoopDetector* detector, const uint8_t* data, size_t data_size);
+void loop_detector_free(LoopDetector* detector);
+
+// Новый прогон: хеш пересчитывается по текущей памяти, снимок сбрасывается
+void loop_detector_reset(LoopDetector* detector, const uint8_t* data);
+
+// Хеш байта памяти в позиции address
+static inline uint64_t loop_detector_byte_hash(uint16_t address, uint8_t value) {
+    uint64_t x = ((uint64_t)address << 8 | value) + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Запись слова value по адресу address (вызывается до записи в data)
+static inline void loop_detector_observe_store(LoopDetector* detector, const uint8_t* data,
+                                               uint16_t address, uint16_t value) {
+    if ((size_t)address + 1 >= detector->data_size) {
+        return;  // Запись завершится ошибкой и память не изменит
+    }
+    uint8_t low = value & 0xFF;
+    uint8_t high = (value >> 8) & 0xFF;
+    detector->memory_hash += loop_detector_byte_hash(address, low) - loop_detector_byte_hash(address, data[address]) +
+                             loop_detector_byte_hash(address + 1, high) - loop_detector_byte_hash(address + 1, data[address + 1]);
+}
+
+// Выполненный переход назад с source на target (RF и data - после перехода);
+// 1 - состояние повторилось, программа не завершится
+int loop_detector_observe_branch(LoopDetector* detector, uint16_t source, uint16_t target,
+                                 const uint16_t* RF, const uint8_t* data);
+
+void loop_detector_print_report(const LoopDetector* detector, FILE* output);
+
+#endif //LOOPDETECTORHEADER_H
@@ -0,0 +1,122 @@
+#include "loopDetectorHeader.h"
+
+// Массив строк с сообщениями об ошибках детектора
+const char* LoopDetectorErrorMessages[LOOP_DETECTOR_ERROR_COUNT] = {
+    "Success",                        // LOOP_DETECTOR_SUCCESS
+    "Out of memory"                   // LOOP_DETECTOR_ERROR_NO_MEMORY
+};
+
+int loop_detector_init(LoopDetector* detector, const uint8_t* data, size_t data_size) {
+    if (!detector) {
+        return LOOP_DETECTOR_ERROR_NO_MEMORY;
+    }
+
+    memset(detector, 0, sizeof(*detector));
+    detector->data_size = data_size;
+    detector->snapshot_memory = (uint8_t*)malloc(data_size ? data_size : 1);
+    if (!detector->snapshot_memory) {
+        return LOOP_DETECTOR_ERROR_NO_MEMORY;
+    }
+
+    loop_detector_reset(detector, data);
+    return LOOP_DETECTOR_SUCCESS;
+}
+
+void loop_detector_free(LoopDetector* detector) {
+    if (!detector) {
+        return;
+    }
+    free(detector->snapshot_memory);
+    detector->snapshot_memory = NULL;
+}
+
+void loop_detector_reset(LoopDetector* detector, const uint8_t* data) {
+    if (!detector) {
+        return;
+    }
+
+    detector->memory_hash = 0;
+    for (size_t i = 0; data && i < detector->data_size; i++) {
+        detector->memory_hash += loop_detector_byte_hash((uint16_t)i, data[i]);
+    }
+
+    detector->snapshot_valid = 0;
+    detector->power = 1;
+    detector->distance = 0;
+    detector->branches_observed = 0;
+    detector->detected = 0;
+    detector->loop_start = 0;
+    detector->loop_end = 0;
+    detector->cycle_branches = 0;
+}
+
+// Хеш состояния: IP, регистры и память данных
+static uint64_t loop_detector_state_hash(const LoopDetector* detector, uint16_t IP, const uint16_t* RF) {
+    uint64_t hash = detector->memory_hash ^ loop_detector_byte_hash(IP, 0xFF);
+    for (int r = 0; r < LOOP_DETECTOR_REGISTERS; r++) {
+        hash = (hash ^ RF[r]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+int loop_detector_observe_branch(LoopDetector* detector, uint16_t source, uint16_t target,
+                                 const uint16_t* RF, const uint8_t* data) {
+    detector->branches_observed++;
+
+    uint64_t hash = loop_detector_state_hash(detector, target, RF);
+
+    if (detector->snapshot_valid) {
+        detector->distance++;
+        if (target < detector->low_address) {
+            detector->low_address = target;
+        }
+        if (source > detector->high_address) {
+            detector->high_address = source;
+        }
+
+        if (hash == detector->snapshot_hash && target == detector->snapshot_IP &&
+            memcmp(RF, detector->snapshot_RF, sizeof(detector->snapshot_RF)) == 0 &&
+            memcmp(data, detector->snapshot_memory, detector->data_size) == 0) {
+            // Все инструкции периода лежат между наименьшей целью и наибольшим
+            // адресом перехода назад: вернуться ниже можно только переходом назад
+            detector->detected = 1;
+            detector->loop_start = detector->low_address;
+            detector->loop_end = detector->high_address;
+            detector->cycle_branches = detector->distance;
+            return 1;
+        }
+    }
+
+    if (!detector->snapshot_valid || detector->distance == detector->power) {
+        detector->snapshot_valid = 1;
+        detector->snapshot_hash = hash;
+        detector->snapshot_IP = target;
+        memcpy(detector->snapshot_RF, RF, sizeof(detector->snapshot_RF));
+        memcpy(detector->snapshot_memory, data, detector->data_size);
+        detector->power *= 2;
+        detector->distance = 0;
+        detector->low_address = 0xFFFF;
+        detector->high_address = 0;
+    }
+
+    return 0;
+}
+
+void loop_detector_print_report(const LoopDetector* detector, FILE* output) {
+    if (!detector) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+
+    if (detector->detected) {
+        fprintf(out, "Nonterminating loop at 0x%04X-0x%04X: state repeats every %llu backward branches "
+                "(detected after %llu)\n",
+                detector->loop_start, detector->loop_end,
+                (unsigned long long)detector->cycle_branches,
+                (unsigned long long)detector->branches_observed);
+    } else {
+        fprintf(out, "No repeated state after %llu backward branches\n",
+                (unsigned long long)detector->branches_observed);
+    }
+}
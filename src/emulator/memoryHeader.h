@@ -31,6 +31,9 @@ typedef struct {
     uint8_t* data_memory;         // Память для хранения данных
     size_t data_size;             // Размер памяти данных
     
+    size_t program_size;          // Размер загруженной программы в байтах
+    uint32_t instruction_generation; // Счётчик изменений памяти инструкций
+    
     int initialized;              // Флаг инициализации памяти
 } Memory;
 
@@ -57,6 +60,14 @@ int memory_write_byte(Memory* memory, uint16_t address, uint8_t value);
 // Запись 16-битного значения в память данных
 int memory_write_word(Memory* memory, uint16_t address, uint16_t value);
 
+// Считывание count последовательных 16-битных слов с адреса address; при
+// выходе за границы не читается ни одно слово
+int memory_read_words(Memory* memory, uint16_t address, uint16_t* values, size_t count);
+
+// Запись count последовательных 16-битных слов; при выходе за границы
+// память не изменяется
+int memory_write_words(Memory* memory, uint16_t address, const uint16_t* values, size_t count);
+
 // Считывание 32-битной инструкции из памяти инструкций
 int memory_read_instruction(Memory* memory, uint16_t address, uint32_t* instruction);
 
@@ -66,6 +77,9 @@ int memory_write_instruction(Memory* memory, uint16_t address, uint32_t instruct
 // Загрузка программы (машинного кода) из файла в память инструкций
 int memory_load_program(Memory* memory, const char* filename);
 
+// Загрузка машинного кода из буфера в память инструкций (остаток памяти обнуляется)
+int memory_load_image(Memory* memory, const uint8_t* code, size_t size);
+
 // Очистка памяти (заполнение нулями)
 void memory_clear(Memory* memory);
 
@@ -32,6 +32,8 @@ int memory_init(Memory* memory, size_t instruction_size, size_t data_size) {
     // Инициализация параметров памяти
     memory->instruction_size = instruction_size;
     memory->data_size = data_size;
+    memory->program_size = 0;
+    memory->instruction_generation = 0;
     memory->initialized = 1;
     
     // Очистка памяти
@@ -61,6 +63,8 @@ void memory_free(Memory* memory) {
     memory->data_memory = NULL;
     memory->instruction_size = 0;
     memory->data_size = 0;
+    memory->program_size = 0;
+    memory->instruction_generation++;
     memory->initialized = 0;
 }
 
@@ -165,6 +169,54 @@ int memory_write_word(Memory* memory, uint16_t address, uint16_t value) {
     return MEMORY_SUCCESS;
 }
 
+// Считывание последовательных 16-битных слов из памяти данных
+int memory_read_words(Memory* memory, uint16_t address, uint16_t* values, size_t count) {
+    int result = check_memory_initialized(memory);
+    if (result != MEMORY_SUCCESS) {
+        return result;
+    }
+    
+    // Диапазон проверяется целиком (без переноса через конец адресного пространства)
+    if (count == 0 || (size_t)address + 2 * count - 1 >= memory->data_size) {
+        return MEMORY_OUT_OF_BOUNDS;
+    }
+    
+    if (address % 2 != 0) {
+        fprintf(stderr, "ВНИМАНИЕ: Чтение слова по невыровненному адресу 0x%04X\n", address);
+    }
+    
+    const uint8_t* bytes = memory->data_memory + address;
+    for (size_t i = 0; i < count; i++) {
+        values[i] = (uint16_t)((bytes[2 * i + 1] << 8) | bytes[2 * i]);
+    }
+    
+    return MEMORY_SUCCESS;
+}
+
+// Запись последовательных 16-битных слов в память данных
+int memory_write_words(Memory* memory, uint16_t address, const uint16_t* values, size_t count) {
+    int result = check_memory_initialized(memory);
+    if (result != MEMORY_SUCCESS) {
+        return result;
+    }
+    
+    if (count == 0 || (size_t)address + 2 * count - 1 >= memory->data_size) {
+        return MEMORY_OUT_OF_BOUNDS;
+    }
+    
+    if (address % 2 != 0) {
+        fprintf(stderr, "ВНИМАНИЕ: Запись слова по невыровненному адресу 0x%04X\n", address);
+    }
+    
+    uint8_t* bytes = memory->data_memory + address;
+    for (size_t i = 0; i < count; i++) {
+        bytes[2 * i] = values[i] & 0xFF;
+        bytes[2 * i + 1] = (values[i] >> 8) & 0xFF;
+    }
+    
+    return MEMORY_SUCCESS;
+}
+
 // Считывание 32-битной инструкции из памяти инструкций
 int memory_read_instruction(Memory* memory, uint16_t address, uint32_t* instruction) {
     int result = check_memory_initialized(memory);
@@ -222,6 +274,11 @@ int memory_write_instruction(Memory* memory, uint16_t address, uint32_t instruct
     memory->instruction_memory[byte_address + 2] = byte2;
     memory->instruction_memory[byte_address + 3] = byte3;
     
+    if ((size_t)byte_address + 4 > memory->program_size) {
+        memory->program_size = (size_t)byte_address + 4;
+    }
+    memory->instruction_generation++;
+    
     return MEMORY_SUCCESS;
 }
 
@@ -258,6 +315,38 @@ int memory_load_program(Memory* memory, const char* filename) {
         return MEMORY_INVALID_ADDRESS; // Ошибка чтения файла
     }
     
+    memory->program_size = (size_t)file_size;
+    memory->instruction_generation++;
+    
+    return MEMORY_SUCCESS;
+}
+
+// Загрузка машинного кода из буфера в память инструкций
+int memory_load_image(Memory* memory, const uint8_t* code, size_t size) {
+    int result = check_memory_initialized(memory);
+    if (result != MEMORY_SUCCESS) {
+        return result;
+    }
+    
+    if (!code && size > 0) {
+        return MEMORY_INVALID_ADDRESS;
+    }
+    
+    // Проверка, что образ помещается в память инструкций
+    if (size > memory->instruction_size) {
+        return MEMORY_OUT_OF_BOUNDS;
+    }
+    
+    if (size > 0) {
+        memcpy(memory->instruction_memory, code, size);
+    }
+    
+    // Инструкции предыдущей программы не должны остаться за концом новой
+    memset(memory->instruction_memory + size, 0, memory->instruction_size - size);
+    
+    memory->program_size = size;
+    memory->instruction_generation++;
+    
     return MEMORY_SUCCESS;
 }
 
@@ -271,6 +360,8 @@ void memory_clear(Memory* memory) {
     // Очистка памяти инструкций и данных
     memset(memory->instruction_memory, 0, memory->instruction_size);
     memset(memory->data_memory, 0, memory->data_size);
+    memory->program_size = 0;
+    memory->instruction_generation++;
 }
 
 // Дамп содержимого памяти инструкций для отладки
@@ -0,0 +1,53 @@
+#ifndef METRICSHEADER_H
+#define METRICSHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "emulatorHeader.h"
+
+// Коды ошибок экспорта метрик
+typedef enum {
+    METRICS_SUCCESS = 0,            // Успешная операция
+    METRICS_ALREADY_RUNNING,        // Экспорт уже запущен
+    METRICS_INVALID_ARGUMENT,       // Неверный путь или интервал
+    METRICS_IO_ERROR,               // Ошибка файла или сокета
+    METRICS_THREAD_ERROR,           // Не удалось запустить поток экспорта
+    METRICS_ERROR_COUNT             // Количество кодов ошибок (всегда последний)
+} MetricsErrorCode;
+
+extern const char* MetricsErrorMessages[METRICS_ERROR_COUNT];
+
+// Гистограмма задержек: 4 поддиапазона на каждую степень двойки наносекунд
+#define METRICS_LATENCY_SUB_BUCKETS 4
+#define METRICS_LATENCY_BUCKETS (64 * METRICS_LATENCY_SUB_BUCKETS)
+
+// Период обновления файла по умолчанию
+#define METRICS_DEFAULT_INTERVAL_MS 1000
+
+// Запуск фонового экспорта в формате Prometheus:
+// в текстовый файл (атомарная замена раз в interval_ms) или в Unix-сокет
+// (каждое подключение получает текущий снимок; на запрос GET отвечает по HTTP)
+int metrics_start_file_exporter(const char* path, int interval_ms);
+int metrics_start_socket_exporter(const char* socket_path);
+
+// Остановка экспорта (счётчики сохраняются)
+void metrics_stop(void);
+
+// Включён ли сбор метрик (проверяется emulator_run один раз за прогон)
+int metrics_is_enabled(void);
+
+// Учёт прогона. Счётчики пишутся только в структуру текущего потока,
+// суммирование выполняет поток экспорта.
+void metrics_run_started(void);
+void metrics_run_finished(int status, uint64_t instructions_retired, uint64_t elapsed_ns);
+
+// Монотонное время для замера длительности прогона
+uint64_t metrics_now_ns(void);
+
+// Формирование текущего снимка в формате Prometheus. Возвращает длину текста
+// (как snprintf) - при нехватке места текст обрезается.
+size_t metrics_format(char* buffer, size_t size);
+
+#endif //METRICSHEADER_H
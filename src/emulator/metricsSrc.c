@@ -0,0 +1,502 @@
+#include "metricsHeader.h"
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+// Массив строк с сообщениями об ошибках экспорта метрик
+const char* MetricsErrorMessages[METRICS_ERROR_COUNT] = {
+    "Success",                                          // METRICS_SUCCESS
+    "Metrics exporter is already running",              // METRICS_ALREADY_RUNNING
+    "Invalid metrics exporter argument",                // METRICS_INVALID_ARGUMENT
+    "Metrics I/O error",                                // METRICS_IO_ERROR
+    "Failed to start metrics exporter thread"           // METRICS_THREAD_ERROR
+};
+
+// Значения метки code для кодов EmulatorErrorCode
+static const char* MetricsCodeLabels[EMULATOR_ERROR_COUNT] = {
+    [EMULATOR_SUCCESS] = "success",
+    [EMULATOR_INVALID_INSTRUCTION] = "invalid_instruction",
+    [EMULATOR_MEMORY_ERROR] = "memory_error",
+    [EMULATOR_DIVISION_BY_ZERO] = "division_by_zero",
+    [EMULATOR_INVALID_REGISTER] = "invalid_register",
+    [EMULATOR_HALT] = "halt",
+    [EMULATOR_NONTERMINATING] = "nonterminating"
+};
+
+// Слот для кодов вне EmulatorErrorCode
+#define METRICS_UNKNOWN_CODE EMULATOR_ERROR_COUNT
+
+// Счётчики одного потока. Пишет только поток-владелец (без атомарных RMW),
+// читает поток экспорта.
+typedef struct MetricsThreadCounters {
+    _Atomic uint64_t instructions_retired;
+    _Atomic uint64_t runs[EMULATOR_ERROR_COUNT + 1];
+    _Atomic uint64_t latency_sum_ns;
+    _Atomic uint64_t latency[METRICS_LATENCY_BUCKETS];
+    struct MetricsThreadCounters* next;
+} MetricsThreadCounters;
+
+// Суммарный снимок
+typedef struct {
+    uint64_t instructions_retired;
+    uint64_t runs[EMULATOR_ERROR_COUNT + 1];
+    uint64_t latency_sum_ns;
+    uint64_t latency[METRICS_LATENCY_BUCKETS];
+} MetricsSnapshot;
+
+typedef enum {
+    METRICS_EXPORT_NONE = 0,
+    METRICS_EXPORT_FILE,
+    METRICS_EXPORT_SOCKET
+} MetricsExportMode;
+
+static pthread_mutex_t metrics_list_mutex = PTHREAD_MUTEX_INITIALIZER;
+static MetricsThreadCounters* metrics_thread_list = NULL;
+static _Thread_local MetricsThreadCounters* metrics_local = NULL;
+
+// Счётчики завершившихся потоков (под metrics_list_mutex). При выходе потока
+// его структура прибавляется сюда, исключается из списка и освобождается,
+// поэтому список не растёт при смене рабочих потоков.
+static MetricsSnapshot metrics_retired;
+static pthread_key_t metrics_thread_key;
+static pthread_once_t metrics_key_once = PTHREAD_ONCE_INIT;
+
+static atomic_int metrics_enabled = 0;
+static _Atomic int64_t metrics_instances_running = 0;
+
+// Состояние потока экспорта (запуск и остановка - из одного управляющего потока)
+static pthread_t metrics_thread;
+static MetricsExportMode metrics_mode = METRICS_EXPORT_NONE;
+static atomic_int metrics_stop_requested = 0;
+static char metrics_path[4096];
+static int metrics_interval_ms = METRICS_DEFAULT_INTERVAL_MS;
+static int metrics_socket_fd = -1;
+
+uint64_t metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int metrics_is_enabled(void) {
+    return atomic_load_explicit(&metrics_enabled, memory_order_relaxed);
+}
+
+// Прибавление к счётчику своего потока: единственный писатель, поэтому без lock-префикса
+static inline void metrics_add(_Atomic uint64_t* counter, uint64_t value) {
+    uint64_t current = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, current + value, memory_order_relaxed);
+}
+
+// Прибавление счётчиков потока к снимку (под metrics_list_mutex)
+static void metrics_accumulate(MetricsSnapshot* snapshot, MetricsThreadCounters* c) {
+    snapshot->instructions_retired += atomic_load_explicit(&c->instructions_retired, memory_order_relaxed);
+    snapshot->latency_sum_ns += atomic_load_explicit(&c->latency_sum_ns, memory_order_relaxed);
+    for (int i = 0; i <= EMULATOR_ERROR_COUNT; i++) {
+        snapshot->runs[i] += atomic_load_explicit(&c->runs[i], memory_order_relaxed);
+    }
+    for (int i = 0; i < METRICS_LATENCY_BUCKETS; i++) {
+        snapshot->latency[i] += atomic_load_explicit(&c->latency[i], memory_order_relaxed);
+    }
+}
+
+// Деструктор ключа потока: перенос счётчиков в metrics_retired
+static void metrics_thread_exit(void* value) {
+    MetricsThreadCounters* counters = (MetricsThreadCounters*)value;
+
+    pthread_mutex_lock(&metrics_list_mutex);
+    metrics_accumulate(&metrics_retired, counters);
+    for (MetricsThreadCounters** link = &metrics_thread_list; *link; link = &(*link)->next) {
+        if (*link == counters) {
+            *link = counters->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&metrics_list_mutex);
+
+    metrics_local = NULL;
+    free(counters);
+}
+
+static void metrics_create_key(void) {
+    pthread_key_create(&metrics_thread_key, metrics_thread_exit);
+}
+
+// Счётчики текущего потока (создаются при первом прогоне)
+static MetricsThreadCounters* metrics_thread_counters(void) {
+    if (metrics_local) {
+        return metrics_local;
+    }
+
+    pthread_once(&metrics_key_once, metrics_create_key);
+
+    MetricsThreadCounters* counters = (MetricsThreadCounters*)calloc(1, sizeof(MetricsThreadCounters));
+    if (!counters) {
+        return NULL;
+    }
+
+    if (pthread_setspecific(metrics_thread_key, counters) != 0) {
+        free(counters);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&metrics_list_mutex);
+    counters->next = metrics_thread_list;
+    metrics_thread_list = counters;
+    pthread_mutex_unlock(&metrics_list_mutex);
+
+    metrics_local = counters;
+    return counters;
+}
+
+// Индекс корзины гистограммы для задержки в наносекундах
+static int metrics_latency_bucket(uint64_t ns) {
+    if (ns < METRICS_LATENCY_SUB_BUCKETS) {
+        return (int)ns;
+    }
+
+    int exponent = 63 - __builtin_clzll(ns);
+    int sub = (int)((ns >> (exponent - 2)) & (METRICS_LATENCY_SUB_BUCKETS - 1));
+    return exponent * METRICS_LATENCY_SUB_BUCKETS + sub;
+}
+
+// Середина корзины в наносекундах
+static double metrics_bucket_midpoint(int bucket) {
+    if (bucket < METRICS_LATENCY_SUB_BUCKETS) {
+        return (double)bucket + 0.5;
+    }
+
+    int exponent = bucket / METRICS_LATENCY_SUB_BUCKETS;
+    int sub = bucket % METRICS_LATENCY_SUB_BUCKETS;
+    double step = (double)(1ull << (exponent - 2));
+    return ((double)(METRICS_LATENCY_SUB_BUCKETS + sub) + 0.5) * step;
+}
+
+void metrics_run_started(void) {
+    atomic_fetch_add_explicit(&metrics_instances_running, 1, memory_order_relaxed);
+}
+
+void metrics_run_finished(int status, uint64_t instructions_retired, uint64_t elapsed_ns) {
+    atomic_fetch_sub_explicit(&metrics_instances_running, 1, memory_order_relaxed);
+
+    MetricsThreadCounters* counters = metrics_thread_counters();
+    if (!counters) {
+        return;
+    }
+
+    int slot = (status >= 0 && status < EMULATOR_ERROR_COUNT) ? status : METRICS_UNKNOWN_CODE;
+
+    metrics_add(&counters->instructions_retired, instructions_retired);
+    metrics_add(&counters->runs[slot], 1);
+    metrics_add(&counters->latency_sum_ns, elapsed_ns);
+    metrics_add(&counters->latency[metrics_latency_bucket(elapsed_ns)], 1);
+}
+
+// Суммирование счётчиков всех потоков
+static void metrics_collect(MetricsSnapshot* snapshot) {
+    pthread_mutex_lock(&metrics_list_mutex);
+    *snapshot = metrics_retired;
+    for (MetricsThreadCounters* c = metrics_thread_list; c; c = c->next) {
+        metrics_accumulate(snapshot, c);
+    }
+    pthread_mutex_unlock(&metrics_list_mutex);
+}
+
+// Квантиль задержки в секундах по гистограмме
+static double metrics_quantile(const MetricsSnapshot* snapshot, double quantile, uint64_t total) {
+    if (total == 0) {
+        return 0.0;
+    }
+
+    uint64_t rank = (uint64_t)(quantile * (double)total);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < METRICS_LATENCY_BUCKETS; i++) {
+        seen += snapshot->latency[i];
+        if (seen >= rank) {
+            return metrics_bucket_midpoint(i) * 1e-9;
+        }
+    }
+
+    return 0.0;
+}
+
+// Дописывание в буфер с учётом обрезки
+static void metrics_append(char* buffer, size_t size, size_t* length, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    size_t offset = *length < size ? *length : size;
+    int written = vsnprintf(buffer ? buffer + offset : NULL, buffer ? size - offset : 0, format, args);
+
+    va_end(args);
+
+    if (written > 0) {
+        *length += (size_t)written;
+    }
+}
+
+size_t metrics_format(char* buffer, size_t size) {
+    MetricsSnapshot snapshot;
+    metrics_collect(&snapshot);
+
+    size_t length = 0;
+    uint64_t total_runs = 0;
+    for (int i = 0; i <= EMULATOR_ERROR_COUNT; i++) {
+        total_runs += snapshot.runs[i];
+    }
+
+    if (buffer && size > 0) {
+        buffer[0] = '\0';
+    }
+
+    metrics_append(buffer, size, &length,
+                   "# HELP cpu_emulator_instructions_retired_total Emulated instructions retired.\n"
+                   "# TYPE cpu_emulator_instructions_retired_total counter\n"
+                   "cpu_emulator_instructions_retired_total %llu\n",
+                   (unsigned long long)snapshot.instructions_retired);
+
+    metrics_append(buffer, size, &length,
+                   "# HELP cpu_emulator_instances_running Programs currently executing in emulator_run.\n"
+                   "# TYPE cpu_emulator_instances_running gauge\n"
+                   "cpu_emulator_instances_running %lld\n",
+                   (long long)atomic_load_explicit(&metrics_instances_running, memory_order_relaxed));
+
+    metrics_append(buffer, size, &length,
+                   "# HELP cpu_emulator_runs_total Finished runs by EmulatorErrorCode.\n"
+                   "# TYPE cpu_emulator_runs_total counter\n");
+    for (int i = 0; i <= EMULATOR_ERROR_COUNT; i++) {
+        const char* label = i < EMULATOR_ERROR_COUNT ? MetricsCodeLabels[i] : "unknown";
+        if (label) {
+            metrics_append(buffer, size, &length, "cpu_emulator_runs_total{code=\"%s\"} %llu\n",
+                           label, (unsigned long long)snapshot.runs[i]);
+        } else {
+            metrics_append(buffer, size, &length, "cpu_emulator_runs_total{code=\"%d\"} %llu\n",
+                           i, (unsigned long long)snapshot.runs[i]);
+        }
+    }
+
+    metrics_append(buffer, size, &length,
+                   "# HELP cpu_emulator_run_latency_seconds Wall time of emulator_run.\n"
+                   "# TYPE cpu_emulator_run_latency_seconds summary\n"
+                   "cpu_emulator_run_latency_seconds{quantile=\"0.5\"} %.9f\n"
+                   "cpu_emulator_run_latency_seconds{quantile=\"0.99\"} %.9f\n"
+                   "cpu_emulator_run_latency_seconds_sum %.9f\n"
+                   "cpu_emulator_run_latency_seconds_count %llu\n",
+                   metrics_quantile(&snapshot, 0.5, total_runs),
+                   metrics_quantile(&snapshot, 0.99, total_runs),
+                   (double)snapshot.latency_sum_ns * 1e-9,
+                   (unsigned long long)total_runs);
+
+    return length;
+}
+
+// Снимок в динамическом буфере
+static char* metrics_format_alloc(size_t* length) {
+    // Между двумя вызовами могут вырасти только числа, резерва хватает на их удлинение
+    size_t size = metrics_format(NULL, 0) + 256;
+    char* buffer = (char*)malloc(size);
+    if (!buffer) {
+        return NULL;
+    }
+
+    *length = metrics_format(buffer, size);
+    if (*length >= size) {
+        *length = size - 1;
+    }
+    return buffer;
+}
+
+// Атомарная замена файла со снимком
+static int metrics_write_file(const char* path) {
+    size_t length;
+    char* text = metrics_format_alloc(&length);
+    if (!text) {
+        return METRICS_IO_ERROR;
+    }
+
+    char temp_path[sizeof(metrics_path) + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE* file = fopen(temp_path, "w");
+    if (!file) {
+        free(text);
+        return METRICS_IO_ERROR;
+    }
+
+    size_t written = fwrite(text, 1, length, file);
+    int close_result = fclose(file);
+    free(text);
+
+    if (written != length || close_result != 0 || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return METRICS_IO_ERROR;
+    }
+
+    return METRICS_SUCCESS;
+}
+
+// Ответ подключившемуся клиенту сокета
+static void metrics_serve_client(int client_fd) {
+    // Клиент может сразу прислать HTTP-запрос (например, Prometheus через unix-прокси)
+    char request[512];
+    int is_http = 0;
+    struct pollfd pfd = { client_fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 100) > 0) {
+        ssize_t received = recv(client_fd, request, sizeof(request) - 1, MSG_DONTWAIT);
+        if (received >= 3 && strncmp(request, "GET", 3) == 0) {
+            is_http = 1;
+        }
+    }
+
+    size_t length;
+    char* text = metrics_format_alloc(&length);
+    if (!text) {
+        return;
+    }
+
+    if (is_http) {
+        char header[160];
+        int header_length = snprintf(header, sizeof(header),
+                                     "HTTP/1.0 200 OK\r\n"
+                                     "Content-Type: text/plain; version=0.0.4\r\n"
+                                     "Content-Length: %zu\r\n\r\n", length);
+        send(client_fd, header, (size_t)header_length, MSG_NOSIGNAL);
+    }
+
+    size_t sent = 0;
+    while (sent < length) {
+        ssize_t n = send(client_fd, text + sent, length - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += (size_t)n;
+    }
+
+    free(text);
+}
+
+// Поток экспорта
+static void* metrics_exporter_main(void* arg) {
+    (void)arg;
+
+    while (!atomic_load(&metrics_stop_requested)) {
+        if (metrics_mode == METRICS_EXPORT_FILE) {
+            metrics_write_file(metrics_path);
+
+            // Ожидание интервала короткими шагами, чтобы быстро реагировать на остановку
+            int waited = 0;
+            while (waited < metrics_interval_ms && !atomic_load(&metrics_stop_requested)) {
+                int step = metrics_interval_ms - waited < 50 ? metrics_interval_ms - waited : 50;
+                struct timespec ts = { 0, (long)step * 1000000L };
+                nanosleep(&ts, NULL);
+                waited += step;
+            }
+        } else {
+            struct pollfd pfd = { metrics_socket_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 100) > 0) {
+                int client_fd = accept(metrics_socket_fd, NULL, NULL);
+                if (client_fd >= 0) {
+                    metrics_serve_client(client_fd);
+                    close(client_fd);
+                }
+            }
+        }
+    }
+
+    // Последний снимок при остановке
+    if (metrics_mode == METRICS_EXPORT_FILE) {
+        metrics_write_file(metrics_path);
+    }
+
+    return NULL;
+}
+
+// Общий запуск потока экспорта
+static int metrics_start_exporter(MetricsExportMode mode, const char* path, int interval_ms) {
+    if (!path || path[0] == '\0' || strlen(path) >= sizeof(metrics_path) || interval_ms <= 0) {
+        return METRICS_INVALID_ARGUMENT;
+    }
+
+    if (metrics_mode != METRICS_EXPORT_NONE) {
+        return METRICS_ALREADY_RUNNING;
+    }
+
+    strcpy(metrics_path, path);
+    metrics_interval_ms = interval_ms;
+
+    if (mode == METRICS_EXPORT_SOCKET) {
+        struct sockaddr_un address;
+        if (strlen(path) >= sizeof(address.sun_path)) {
+            return METRICS_INVALID_ARGUMENT;
+        }
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return METRICS_IO_ERROR;
+        }
+
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, path);
+        unlink(path);
+
+        if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 8) != 0) {
+            close(fd);
+            return METRICS_IO_ERROR;
+        }
+
+        metrics_socket_fd = fd;
+    }
+
+    metrics_mode = mode;
+    atomic_store(&metrics_stop_requested, 0);
+    atomic_store(&metrics_enabled, 1);
+
+    if (pthread_create(&metrics_thread, NULL, metrics_exporter_main, NULL) != 0) {
+        atomic_store(&metrics_enabled, 0);
+        metrics_mode = METRICS_EXPORT_NONE;
+        if (metrics_socket_fd >= 0) {
+            close(metrics_socket_fd);
+            unlink(metrics_path);
+            metrics_socket_fd = -1;
+        }
+        return METRICS_THREAD_ERROR;
+    }
+
+    return METRICS_SUCCESS;
+}
+
+int metrics_start_file_exporter(const char* path, int interval_ms) {
+    return metrics_start_exporter(METRICS_EXPORT_FILE, path, interval_ms);
+}
+
+int metrics_start_socket_exporter(const char* socket_path) {
+    return metrics_start_exporter(METRICS_EXPORT_SOCKET, socket_path, METRICS_DEFAULT_INTERVAL_MS);
+}
+
+void metrics_stop(void) {
+    if (metrics_mode == METRICS_EXPORT_NONE) {
+        return;
+    }
+
+    atomic_store(&metrics_stop_requested, 1);
+    pthread_join(metrics_thread, NULL);
+
+    if (metrics_mode == METRICS_EXPORT_SOCKET && metrics_socket_fd >= 0) {
+        close(metrics_socket_fd);
+        unlink(metrics_path);
+        metrics_socket_fd = -1;
+    }
+
+    metrics_mode = METRICS_EXPORT_NONE;
+    atomic_store(&metrics_enabled, 0);
+}
@@ -0,0 +1,103 @@
+#ifndef PACKEDHEADER_H
+#define PACKEDHEADER_H
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Упакованные операции над двумя 8-битными дорожками без знака 16-битного
+// регистра (команды addsb, subsb, cmpgeb, minb, maxb, см. isaHeader.h).
+// С SSE2 используются байтовые команды хоста (насыщение, min/max), иначе -
+// поразрядный расчёт по дорожкам. Результаты обоих вариантов совпадают.
+
+#if defined(__SSE2__)
+
+#define PACKED_SSE2_OP(a, b, op) \
+    ((uint16_t)_mm_cvtsi128_si32(op(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b))))
+
+static inline uint16_t packed_add_saturate(uint16_t a, uint16_t b) {
+    return PACKED_SSE2_OP(a, b, _mm_adds_epu8);
+}
+
+static inline uint16_t packed_sub_saturate(uint16_t a, uint16_t b) {
+    return PACKED_SSE2_OP(a, b, _mm_subs_epu8);
+}
+
+static inline uint16_t packed_min(uint16_t a, uint16_t b) {
+    return PACKED_SSE2_OP(a, b, _mm_min_epu8);
+}
+
+static inline uint16_t packed_max(uint16_t a, uint16_t b) {
+    return PACKED_SSE2_OP(a, b, _mm_max_epu8);
+}
+
+// a >= b  <=>  max(a, b) == a
+static inline uint16_t packed_compare_ge(uint16_t a, uint16_t b) {
+    __m128i va = _mm_cvtsi32_si128(a);
+    __m128i vb = _mm_cvtsi32_si128(b);
+    return (uint16_t)_mm_cvtsi128_si32(_mm_cmpeq_epi8(_mm_max_epu8(va, vb), va));
+}
+
+#undef PACKED_SSE2_OP
+
+#else
+
+// Дорожка lane (0 - биты 7:0, 1 - биты 15:8)
+#define PACKED_LANE(value, lane) (((value) >> (8 * (lane))) & 0xFF)
+
+static inline uint16_t packed_add_saturate(uint16_t a, uint16_t b) {
+    uint16_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        unsigned sum = PACKED_LANE(a, lane) + PACKED_LANE(b, lane);
+        result |= (uint16_t)((sum > 0xFF ? 0xFF : sum) << (8 * lane));
+    }
+    return result;
+}
+
+static inline uint16_t packed_sub_saturate(uint16_t a, uint16_t b) {
+    uint16_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        unsigned x = PACKED_LANE(a, lane);
+        unsigned y = PACKED_LANE(b, lane);
+        result |= (uint16_t)((x > y ? x - y : 0) << (8 * lane));
+    }
+    return result;
+}
+
+static inline uint16_t packed_min(uint16_t a, uint16_t b) {
+    uint16_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        unsigned x = PACKED_LANE(a, lane);
+        unsigned y = PACKED_LANE(b, lane);
+        result |= (uint16_t)((x < y ? x : y) << (8 * lane));
+    }
+    return result;
+}
+
+static inline uint16_t packed_max(uint16_t a, uint16_t b) {
+    uint16_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        unsigned x = PACKED_LANE(a, lane);
+        unsigned y = PACKED_LANE(b, lane);
+        result |= (uint16_t)((x > y ? x : y) << (8 * lane));
+    }
+    return result;
+}
+
+static inline uint16_t packed_compare_ge(uint16_t a, uint16_t b) {
+    uint16_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        if (PACKED_LANE(a, lane) >= PACKED_LANE(b, lane)) {
+            result |= (uint16_t)(0xFF << (8 * lane));
+        }
+    }
+    return result;
+}
+
+#undef PACKED_LANE
+
+#endif
+
+#endif //PACKEDHEADER_H
@@ -0,0 +1,46 @@
+#ifndef PERFCOUNTERSHEADER_H
+#define PERFCOUNTERSHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Аппаратные счётчики хоста (Linux perf_event_open)
+typedef enum {
+    PERF_COUNTER_CYCLES = 0,        // Такты процессора хоста
+    PERF_COUNTER_INSTRUCTIONS,      // Выполненные инструкции хоста
+    PERF_COUNTER_BRANCH_MISSES,     // Ошибки предсказания переходов
+    PERF_COUNTER_L1D_MISSES,        // Промахи L1 кэша данных (чтение)
+    PERF_COUNTER_LLC_MISSES,        // Промахи кэша последнего уровня
+    PERF_COUNTER_ITLB_MISSES,       // Промахи iTLB
+    PERF_COUNTER_COUNT              // Количество счётчиков (всегда последний)
+} PerfCounterId;
+
+// Набор счётчиков. Каждый счётчик открывается отдельно, поэтому недоступность
+// одного из них (например, в контейнере без PMU) не отключает остальные.
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];          // Дескрипторы perf_event (-1, если недоступен)
+    uint64_t values[PERF_COUNTER_COUNT];  // Значения после perf_counters_stop
+    int available_count;                  // Количество успешно открытых счётчиков
+} PerfCounters;
+
+// Открытие счётчиков для текущего потока. Возвращает количество доступных счётчиков
+// (0, если perf_event_open не поддерживается или запрещён).
+int perf_counters_open(PerfCounters* counters);
+
+// Сброс и запуск / остановка и чтение счётчиков
+void perf_counters_start(PerfCounters* counters);
+void perf_counters_stop(PerfCounters* counters);
+
+// Закрытие дескрипторов
+void perf_counters_close(PerfCounters* counters);
+
+// Доступность и значение отдельного счётчика
+int perf_counter_is_available(const PerfCounters* counters, PerfCounterId id);
+uint64_t perf_counter_value(const PerfCounters* counters, PerfCounterId id);
+
+// Имя счётчика для отчётов
+const char* perf_counter_name(PerfCounterId id);
+
+#endif //PERFCOUNTERSHEADER_H
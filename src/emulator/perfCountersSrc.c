@@ -0,0 +1,195 @@
+#include "perfCountersHeader.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Имена счётчиков для отчётов
+static const char* PerfCounterNames[PERF_COUNTER_COUNT] = {
+    "cycles",                          // PERF_COUNTER_CYCLES
+    "instructions",                    // PERF_COUNTER_INSTRUCTIONS
+    "branch-misses",                   // PERF_COUNTER_BRANCH_MISSES
+    "L1d-misses",                      // PERF_COUNTER_L1D_MISSES
+    "LLC-misses",                      // PERF_COUNTER_LLC_MISSES
+    "iTLB-misses"                      // PERF_COUNTER_ITLB_MISSES
+};
+
+const char* perf_counter_name(PerfCounterId id) {
+    if (id < 0 || id >= PERF_COUNTER_COUNT) {
+        return "unknown";
+    }
+    return PerfCounterNames[id];
+}
+
+#ifdef __linux__
+
+// Описание события perf для каждого счётчика
+static void perf_counter_fill_attr(PerfCounterId id, struct perf_event_attr* attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->disabled = 1;
+    attr->exclude_kernel = 1;   // Работает при perf_event_paranoid <= 2
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (id) {
+        case PERF_COUNTER_CYCLES:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_COUNTER_INSTRUCTIONS:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_COUNTER_BRANCH_MISSES:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PERF_COUNTER_L1D_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_L1D |
+                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_COUNTER_LLC_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_LL |
+                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_COUNTER_ITLB_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_ITLB |
+                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            break;
+    }
+}
+
+int perf_counters_open(PerfCounters* counters) {
+    if (!counters) {
+        return 0;
+    }
+
+    memset(counters->values, 0, sizeof(counters->values));
+    counters->available_count = 0;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        perf_counter_fill_attr((PerfCounterId)i, &attr);
+
+        // pid = 0, cpu = -1: текущий поток на любом ядре
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        counters->fds[i] = (int)fd;
+
+        if (fd >= 0) {
+            counters->available_count++;
+        }
+    }
+
+    return counters->available_count;
+}
+
+void perf_counters_start(PerfCounters* counters) {
+    if (!counters) {
+        return;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void perf_counters_stop(PerfCounters* counters) {
+    if (!counters) {
+        return;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->values[i] = 0;
+        if (counters->fds[i] < 0) {
+            continue;
+        }
+
+        ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // value, time_enabled, time_running
+        uint64_t data[3] = {0};
+        if (read(counters->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+
+        // Масштабирование при мультиплексировании счётчиков ядром
+        if (data[2] > 0 && data[2] < data[1]) {
+            data[0] = (uint64_t)((double)data[0] * (double)data[1] / (double)data[2]);
+        }
+        counters->values[i] = data[0];
+    }
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    if (!counters) {
+        return;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            close(counters->fds[i]);
+        }
+        counters->fds[i] = -1;
+    }
+    counters->available_count = 0;
+}
+
+#else // !__linux__
+
+// На других платформах счётчики недоступны
+int perf_counters_open(PerfCounters* counters) {
+    if (!counters) {
+        return 0;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+        counters->values[i] = 0;
+    }
+    counters->available_count = 0;
+
+    return 0;
+}
+
+void perf_counters_start(PerfCounters* counters) {
+    (void)counters;
+}
+
+void perf_counters_stop(PerfCounters* counters) {
+    (void)counters;
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    (void)counters;
+}
+
+#endif // __linux__
+
+int perf_counter_is_available(const PerfCounters* counters, PerfCounterId id) {
+    if (!counters || id < 0 || id >= PERF_COUNTER_COUNT) {
+        return 0;
+    }
+    return counters->fds[id] >= 0;
+}
+
+uint64_t perf_counter_value(const PerfCounters* counters, PerfCounterId id) {
+    if (!perf_counter_is_available(counters, id)) {
+        return 0;
+    }
+    return counters->values[id];
+}
@@ -0,0 +1,91 @@
+#ifndef SUPEROPTIMIZERHEADER_H
+#define SUPEROPTIMIZERHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "emulatorHeader.h"
+
+// Супероптимизатор коротких линейных участков (офлайн-инструмент).
+//
+// Окно - подряд идущие инструкции без переходов, меток и обращений к памяти
+// (add, sub, mul, cmpge, rshft, lshft, and, or, xor, set_const, nop). Для окна
+// перебираются все более короткие последовательности из регистров и констант
+// окна; замена принимается, если на выходе окна совпадают все живые регистры.
+// Оракул - emulator_decode_instruction, поэтому эквивалентность понимается
+// в смысле эмулятора (включая сдвиги на 16 и более разрядов).
+//
+// Проверка кандидата: сначала SUPEROPT_TEST_COUNT случайных и граничных
+// входов, затем полный перебор 16-битных значений: всех входных регистров
+// сразу, если их суммарная разрядность не больше exhaustive_bits, иначе
+// каждого входа по отдельности плюс SUPEROPT_RANDOM_SAMPLES случайных входов.
+// Перебор кандидатов делится между потоками; при нескольких находках
+// выбирается первая в порядке перебора, поэтому результат не зависит от
+// числа потоков.
+#define SUPEROPT_MAX_WINDOW 8
+#define SUPEROPT_MAX_REPLACEMENT 3
+#define SUPEROPT_DEFAULT_WINDOW 5
+#define SUPEROPT_DEFAULT_REPLACEMENT 2
+#define SUPEROPT_DEFAULT_EXHAUSTIVE_BITS 16
+#define SUPEROPT_MAX_CONSTANTS 16
+#define SUPEROPT_TEST_COUNT 32
+#define SUPEROPT_RANDOM_SAMPLES (1 << 20)
+#define SUPEROPT_MAX_THREADS 64
+
+// Коды ошибок супероптимизатора
+typedef enum {
+    SUPEROPT_SUCCESS = 0,
+    SUPEROPT_ERROR_IO,               // Ошибка чтения или записи файла
+    SUPEROPT_ERROR_PARSE,            // Исходный текст не ассемблируется
+    SUPEROPT_ERROR_NO_MEMORY,        // Не удалось выделить память
+    SUPEROPT_ERROR_UNSAFE_TARGET,    // Цель bnz вне программы: живые регистры неизвестны
+    SUPEROPT_ERROR_INVALID_CONFIG,   // Неверные параметры поиска
+    SUPEROPT_ERROR_COUNT             // Количество кодов ошибок (всегда последний)
+} SuperoptErrorCode;
+
+extern const char* SuperoptErrorMessages[SUPEROPT_ERROR_COUNT];
+
+// Параметры поиска
+typedef struct {
+    int max_window;                  // Наибольшая длина окна (<= SUPEROPT_MAX_WINDOW)
+    int max_replacement;             // Наибольшая длина замены (<= SUPEROPT_MAX_REPLACEMENT)
+    int thread_count;                // 0 - по числу процессоров
+    int exhaustive_bits;             // Полный перебор входов до этой разрядности (16..32)
+    uint32_t seed;                   // Начальное значение генератора тестов
+} SuperoptConfig;
+
+// Найденная замена
+typedef struct {
+    int start;                       // Первая инструкция окна
+    int length;                      // Длина окна
+    int replacement_length;
+    uint32_t replacement[SUPEROPT_MAX_REPLACEMENT];
+    int exhaustive;                  // Проверено полным перебором всех входов
+} SuperoptSuggestion;
+
+typedef struct {
+    SuperoptSuggestion* suggestions; // По возрастанию start, окна не пересекаются
+    int count;
+    int capacity;
+    int windows_searched;
+    uint64_t candidates_tested;
+} SuperoptResult;
+
+void superopt_config_default(SuperoptConfig* config);
+
+// Поиск замен во всех окнах программы
+int superopt_program(const ParseResult* program, const SuperoptConfig* config, SuperoptResult* result);
+void superopt_result_free(SuperoptResult* result);
+
+// Вывод замен: "строка: старые инструкции -> новые"
+void superopt_print_suggestions(const ParseResult* program, const SuperoptResult* result, FILE* output);
+
+// Исходный текст с заменами: метки сохраняются, заменённые строки остаются комментариями.
+// Применяются только замены, проверенные полным перебором (exhaustive); выборочно
+// проверенные (sampled) остаются предложениями в superopt_print_suggestions.
+int superopt_rewrite_source(const char* source, size_t size, const ParseResult* program,
+                            const SuperoptResult* result, FILE* output);
+
+// Разбор .asm, поиск, вывод замен в stdout; output_filename = NULL - без переписанного .asm
+int superopt_file(const char* input_filename, const char* output_filename, const SuperoptConfig* config);
+
+#endif //SUPEROPTIMIZERHEADER_H
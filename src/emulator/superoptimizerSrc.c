@@ -0,0 +1,693 @@
+#include "superoptimizerHeader.h"
+#include "../assembler/flowAnalysisHeader.h"
+#include <pthread.h>
+#include <unistd.h>
+
+const char* SuperoptErrorMessages[SUPEROPT_ERROR_COUNT] = {
+    "Success",                           // SUPEROPT_SUCCESS
+    "Input/output error",                // SUPEROPT_ERROR_IO
+    "Source does not assemble",          // SUPEROPT_ERROR_PARSE
+    "Out of memory",                     // SUPEROPT_ERROR_NO_MEMORY
+    "Branch target outside the program", // SUPEROPT_ERROR_UNSAFE_TARGET
+    "Invalid search parameters"          // SUPEROPT_ERROR_INVALID_CONFIG
+};
+
+// Пространство поиска одной длины больше этого не перебирается
+#define SEARCH_SPACE_LIMIT (1ull << 34)
+#define NOT_FOUND UINT64_MAX
+#define SWEEP_BACKGROUNDS 4
+
+// Проверка кандидата
+typedef enum {
+    VERIFY_FAILED = 0,
+    VERIFY_SAMPLED,                  // Перебор по каждому входу и случайные входы
+    VERIFY_EXHAUSTIVE                // Перебор всех сочетаний входов
+} VerifyLevel;
+
+// Окно и общее состояние поиска
+typedef struct {
+    uint32_t code[SUPEROPT_MAX_WINDOW];
+    int length;
+    uint32_t live_out;               // Регистры, сравниваемые на выходе
+    uint32_t inputs;                 // Регистры, читаемые окном до записи
+    uint32_t* slots;                 // Инструкции-кандидаты для одной позиции
+    uint32_t* slot_reads;
+    uint32_t* slot_writes;
+    int slot_count;
+    uint16_t tests[SUPEROPT_TEST_COUNT][ISA_REGISTER_COUNT];
+    uint16_t expected[SUPEROPT_TEST_COUNT][ISA_REGISTER_COUNT];
+    const SuperoptConfig* config;
+    uint64_t best;                   // Наименьший принятый номер кандидата (атомарно)
+} SearchWindow;
+
+// Задание потока: кандидаты с номерами first, first + step, ...
+typedef struct {
+    SearchWindow* window;
+    int length;
+    uint64_t first;
+    uint64_t step;
+    uint64_t found;
+    VerifyLevel level;
+    uint64_t tested;
+} SearchTask;
+
+static const OpCode AluOpcodes[] = {
+    OPC_ADD, OPC_SUB, OPC_MUL, OPC_CMPGE, OPC_RSHFT, OPC_LSHFT, OPC_AND, OPC_OR, OPC_XOR
+};
+
+void superopt_config_default(SuperoptConfig* config) {
+    config->max_window = SUPEROPT_DEFAULT_WINDOW;
+    config->max_replacement = SUPEROPT_DEFAULT_REPLACEMENT;
+    config->thread_count = 0;
+    config->exhaustive_bits = SUPEROPT_DEFAULT_EXHAUSTIVE_BITS;
+    config->seed = 0x5EED1234u;
+}
+
+static uint32_t next_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static int is_window_opcode(OpCode opcode) {
+    switch (opcode) {
+        case OPC_NOP: case OPC_ADD: case OPC_SUB: case OPC_MUL: case OPC_CMPGE:
+        case OPC_RSHFT: case OPC_LSHFT: case OPC_AND: case OPC_OR: case OPC_XOR:
+        case OPC_SET_CONST:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_commutative(OpCode opcode) {
+    return opcode == OPC_ADD || opcode == OPC_MUL || opcode == OPC_AND ||
+           opcode == OPC_OR || opcode == OPC_XOR;
+}
+
+// Регистры, читаемые последовательностью до записи
+static uint32_t sequence_inputs(const uint32_t* code, int length) {
+    uint32_t inputs = 0;
+    uint32_t written = 0;
+
+    for (int i = 0; i < length; i++) {
+        uint32_t reads;
+        uint32_t writes;
+        isa_register_usage(code[i], &reads, &writes);
+        inputs |= reads & ~written;
+        written |= writes;
+    }
+    return inputs;
+}
+
+// Выполнение последовательности оракулом
+static void execute(CPU* cpu, const uint16_t* input, const uint32_t* code, int length, uint16_t* output) {
+    memcpy(cpu->RF, input, sizeof(cpu->RF));
+    for (int i = 0; i < length; i++) {
+        emulator_decode_instruction(cpu, code[i]);
+    }
+    memcpy(output, cpu->RF, sizeof(cpu->RF));
+}
+
+static int same_outputs(uint32_t live_out, const uint16_t* left, const uint16_t* right) {
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        if ((live_out & (1u << r)) && left[r] != right[r]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int agrees_on(const SearchWindow* window, CPU* cpu, const uint16_t* input,
+                     const uint32_t* candidate, int length) {
+    uint16_t expected[ISA_REGISTER_COUNT];
+    uint16_t actual[ISA_REGISTER_COUNT];
+
+    execute(cpu, input, window->code, window->length, expected);
+    execute(cpu, input, candidate, length, actual);
+    return same_outputs(window->live_out, expected, actual);
+}
+
+// Полный перебор 16-битных значений входов
+static VerifyLevel verify(const SearchWindow* window, CPU* cpu, const uint32_t* candidate, int length,
+                          uint32_t seed) {
+    uint32_t inputs = window->inputs | sequence_inputs(candidate, length);
+    int registers[ISA_REGISTER_COUNT];
+    int input_count = 0;
+    uint16_t vector[ISA_REGISTER_COUNT];
+
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        if (inputs & (1u << r)) {
+            registers[input_count++] = r;
+        }
+        vector[r] = (uint16_t)next_random(&seed);
+    }
+
+    if (input_count * 16 <= window->config->exhaustive_bits) {
+        uint64_t combinations = 1ull << (16 * input_count);
+        for (uint64_t value = 0; value < combinations; value++) {
+            for (int k = 0; k < input_count; k++) {
+                vector[registers[k]] = (uint16_t)(value >> (16 * k));
+            }
+            if (!agrees_on(window, cpu, vector, candidate, length)) {
+                return VERIFY_FAILED;
+            }
+        }
+        return VERIFY_EXHAUSTIVE;
+    }
+
+    // Каждый вход по отдельности на нескольких случайных фонах
+    for (int k = 0; k < input_count; k++) {
+        for (int background = 0; background < SWEEP_BACKGROUNDS; background++) {
+            for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+                vector[r] = (uint16_t)next_random(&seed);
+            }
+            for (uint32_t value = 0; value <= 0xFFFF; value++) {
+                vector[registers[k]] = (uint16_t)value;
+                if (!agrees_on(window, cpu, vector, candidate, length)) {
+                    return VERIFY_FAILED;
+                }
+            }
+        }
+    }
+
+    for (int sample = 0; sample < SUPEROPT_RANDOM_SAMPLES; sample++) {
+        for (int k = 0; k < input_count; k++) {
+            vector[registers[k]] = (uint16_t)next_random(&seed);
+        }
+        if (!agrees_on(window, cpu, vector, candidate, length)) {
+            return VERIFY_FAILED;
+        }
+    }
+    return VERIFY_SAMPLED;
+}
+
+// Каждая инструкция кандидата должна писать регистр, который читается дальше
+// или живой на выходе; иначе кандидат сводится к более короткому
+static int is_useful(const SearchWindow* window, const int* digits, int length) {
+    uint32_t needed = window->live_out;
+
+    for (int i = length - 1; i >= 0; i--) {
+        if (!(window->slot_writes[digits[i]] & needed)) {
+            return 0;
+        }
+        needed |= window->slot_reads[digits[i]];
+    }
+    return 1;
+}
+
+static void* search_worker(void* argument) {
+    SearchTask* task = (SearchTask*)argument;
+    SearchWindow* window = task->window;
+    uint64_t total = 1;
+    CPU cpu;
+
+    memset(&cpu, 0, sizeof(CPU));
+    cpu.output_stream = stderr;
+
+    for (int i = 0; i < task->length; i++) {
+        total *= (uint64_t)window->slot_count;
+    }
+
+    for (uint64_t index = task->first; index < total; index += task->step) {
+        if (index >= __atomic_load_n(&window->best, __ATOMIC_RELAXED)) {
+            break;
+        }
+
+        int digits[SUPEROPT_MAX_REPLACEMENT];
+        uint32_t candidate[SUPEROPT_MAX_REPLACEMENT];
+        uint64_t rest = index;
+        for (int i = task->length - 1; i >= 0; i--) {
+            digits[i] = (int)(rest % (uint64_t)window->slot_count);
+            rest /= (uint64_t)window->slot_count;
+            candidate[i] = window->slots[digits[i]];
+        }
+
+        if (!is_useful(window, digits, task->length)) {
+            continue;
+        }
+        task->tested++;
+
+        int passed = 1;
+        for (int t = 0; t < SUPEROPT_TEST_COUNT && passed; t++) {
+            uint16_t actual[ISA_REGISTER_COUNT];
+            execute(&cpu, window->tests[t], candidate, task->length, actual);
+            passed = same_outputs(window->live_out, window->expected[t], actual);
+        }
+        if (!passed) {
+            continue;
+        }
+
+        VerifyLevel level = verify(window, &cpu, candidate, task->length, window->config->seed ^ (uint32_t)index);
+        if (level != VERIFY_FAILED) {
+            task->found = index;
+            task->level = level;
+
+            uint64_t best = __atomic_load_n(&window->best, __ATOMIC_RELAXED);
+            while (index < best &&
+                   !__atomic_compare_exchange_n(&window->best, &best, index, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            }
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static int choose_thread_count(int thread_count) {
+    if (thread_count <= 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = processors > 0 ? (int)processors : 1;
+    }
+    return thread_count > SUPEROPT_MAX_THREADS ? SUPEROPT_MAX_THREADS : thread_count;
+}
+
+// Поиск замены заданной длины; NOT_FOUND - нет
+static uint64_t search_length(SearchWindow* window, int length, VerifyLevel* level, uint64_t* tested) {
+    int thread_count = choose_thread_count(window->config->thread_count);
+    SearchTask tasks[SUPEROPT_MAX_THREADS];
+    pthread_t threads[SUPEROPT_MAX_THREADS];
+    int started[SUPEROPT_MAX_THREADS];
+
+    window->best = NOT_FOUND;
+
+    for (int i = 0; i < thread_count; i++) {
+        tasks[i] = (SearchTask){window, length, (uint64_t)i, (uint64_t)thread_count, NOT_FOUND, VERIFY_FAILED, 0};
+        started[i] = thread_count > 1 && pthread_create(&threads[i], NULL, search_worker, &tasks[i]) == 0;
+        if (!started[i]) {
+            search_worker(&tasks[i]);
+        }
+    }
+
+    uint64_t best = NOT_FOUND;
+    for (int i = 0; i < thread_count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+        *tested += tasks[i].tested;
+        if (tasks[i].found < best) {
+            best = tasks[i].found;
+            *level = tasks[i].level;
+        }
+    }
+
+    return best;
+}
+
+// Кандидаты для одной позиции: операции над регистрами окна и set_const с константами окна
+static int build_slots(SearchWindow* window) {
+    static const uint16_t DefaultConstants[] = {0, 1, 2, 15, 16, 0xFFFF};
+    uint16_t constants[SUPEROPT_MAX_CONSTANTS];
+    int constant_count = 0;
+    uint32_t registers = 0;
+
+    for (int i = 0; i < window->length; i++) {
+        uint32_t reads;
+        uint32_t writes;
+        isa_register_usage(window->code[i], &reads, &writes);
+        registers |= reads | writes;
+
+        if ((window->code[i] >> 24) == OPC_SET_CONST && constant_count < SUPEROPT_MAX_CONSTANTS) {
+            constants[constant_count++] = (uint16_t)(window->code[i] >> 8);
+        }
+    }
+    for (size_t i = 0; i < sizeof(DefaultConstants) / sizeof(DefaultConstants[0]) &&
+                       constant_count < SUPEROPT_MAX_CONSTANTS; i++) {
+        int present = 0;
+        for (int k = 0; k < constant_count; k++) {
+            present |= constants[k] == DefaultConstants[i];
+        }
+        if (!present) {
+            constants[constant_count++] = DefaultConstants[i];
+        }
+    }
+
+    int register_count = __builtin_popcount(registers);
+    size_t capacity = sizeof(AluOpcodes) / sizeof(AluOpcodes[0]) * (size_t)register_count * register_count *
+                      register_count + (size_t)constant_count * register_count + 1;
+
+    window->slots = (uint32_t*)malloc(capacity * 3 * sizeof(uint32_t));
+    if (!window->slots) {
+        return SUPEROPT_ERROR_NO_MEMORY;
+    }
+    window->slot_reads = window->slots + capacity;
+    window->slot_writes = window->slots + capacity * 2;
+    window->slot_count = 0;
+
+    for (int c = 0; c < constant_count; c++) {
+        for (int d = 0; d < ISA_REGISTER_COUNT; d++) {
+            if (registers & (1u << d)) {
+                uint16_t values[ISA_MAX_OPERANDS] = {constants[c], (uint16_t)d};
+                window->slots[window->slot_count++] = isa_encode(isa_lookup_opcode(OPC_SET_CONST), values, 2);
+            }
+        }
+    }
+
+    for (size_t op = 0; op < sizeof(AluOpcodes) / sizeof(AluOpcodes[0]); op++) {
+        const IsaInstruction* isa = isa_lookup_opcode(AluOpcodes[op]);
+        for (int a = 0; a < ISA_REGISTER_COUNT; a++) {
+            for (int b = 0; b < ISA_REGISTER_COUNT; b++) {
+                if (!(registers & (1u << a)) || !(registers & (1u << b)) ||
+                    (is_commutative(AluOpcodes[op]) && a > b)) {
+                    continue;
+                }
+                for (int d = 0; d < ISA_REGISTER_COUNT; d++) {
+                    if (registers & (1u << d)) {
+                        uint16_t values[ISA_MAX_OPERANDS] = {(uint16_t)a, (uint16_t)b, (uint16_t)d};
+                        window->slots[window->slot_count++] = isa_encode(isa, values, 3);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < window->slot_count; i++) {
+        isa_register_usage(window->slots[i], &window->slot_reads[i], &window->slot_writes[i]);
+    }
+    return SUPEROPT_SUCCESS;
+}
+
+// Граничные значения в первых тестах, затем случайные
+static void build_tests(SearchWindow* window) {
+    static const uint16_t Corners[] = {0x0000, 0xFFFF, 0x0001, 0x8000, 0x7FFF, 0x0010};
+    const int corner_count = (int)(sizeof(Corners) / sizeof(Corners[0]));
+    uint32_t state = window->config->seed | 1u;
+    CPU cpu;
+
+    memset(&cpu, 0, sizeof(CPU));
+    cpu.output_stream = stderr;
+
+    for (int t = 0; t < SUPEROPT_TEST_COUNT; t++) {
+        for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+            window->tests[t][r] = t < corner_count ? Corners[(t + r) % corner_count]
+                                                   : (uint16_t)next_random(&state);
+        }
+        execute(&cpu, window->tests[t], window->code, window->length, window->expected[t]);
+    }
+}
+
+static int add_suggestion(SuperoptResult* result, const SuperoptSuggestion* suggestion) {
+    if (result->count == result->capacity) {
+        int capacity = result->capacity ? result->capacity * 2 : 16;
+        SuperoptSuggestion* grown = (SuperoptSuggestion*)realloc(result->suggestions,
+                                                                 (size_t)capacity * sizeof(SuperoptSuggestion));
+        if (!grown) {
+            return SUPEROPT_ERROR_NO_MEMORY;
+        }
+        result->suggestions = grown;
+        result->capacity = capacity;
+    }
+    result->suggestions[result->count++] = *suggestion;
+    return SUPEROPT_SUCCESS;
+}
+
+// Поиск замены для окна [start, start + length); found = 1 - замена записана в result
+static int search_window(const ParseResult* program, const FlowAnalysis* flow, const SuperoptConfig* config,
+                         int start, int length, SuperoptResult* result, int* found) {
+    SearchWindow window;
+    memset(&window, 0, sizeof(SearchWindow));
+    window.config = config;
+    window.length = length;
+    window.live_out = flow->live_out[start + length - 1];
+    for (int i = 0; i < length; i++) {
+        window.code[i] = program->instructions[start + i].machine_code;
+    }
+    window.inputs = sequence_inputs(window.code, length);
+
+    *found = 0;
+    result->windows_searched++;
+
+    int status = build_slots(&window);
+    if (status != SUPEROPT_SUCCESS) {
+        return status;
+    }
+    build_tests(&window);
+
+    int max_length = config->max_replacement < length - 1 ? config->max_replacement : length - 1;
+    uint64_t space = 1;
+
+    for (int candidate_length = 0; candidate_length <= max_length && !*found; candidate_length++) {
+        if (candidate_length > 0) {
+            space *= (uint64_t)window.slot_count;
+        }
+        if (space > SEARCH_SPACE_LIMIT) {
+            break;
+        }
+
+        VerifyLevel level = VERIFY_FAILED;
+        uint64_t index = search_length(&window, candidate_length, &level, &result->candidates_tested);
+        if (index == NOT_FOUND) {
+            continue;
+        }
+
+        SuperoptSuggestion suggestion;
+        memset(&suggestion, 0, sizeof(SuperoptSuggestion));
+        suggestion.start = start;
+        suggestion.length = length;
+        suggestion.replacement_length = candidate_length;
+        suggestion.exhaustive = level == VERIFY_EXHAUSTIVE;
+        for (int i = candidate_length - 1; i >= 0; i--) {
+            suggestion.replacement[i] = window.slots[index % (uint64_t)window.slot_count];
+            index /= (uint64_t)window.slot_count;
+        }
+
+        status = add_suggestion(result, &suggestion);
+        *found = status == SUPEROPT_SUCCESS;
+    }
+
+    free(window.slots);
+    return status;
+}
+
+// Инструкции с метками - границы окон: на них могут переходить другие модули
+static uint8_t* mark_boundaries(const ParseResult* program, const FlowAnalysis* flow) {
+    uint8_t* boundary = (uint8_t*)calloc((size_t)program->instruction_count + 1, sizeof(uint8_t));
+    if (!boundary) {
+        return NULL;
+    }
+
+    for (int i = 0; i < program->instruction_count; i++) {
+        boundary[i] = flow->leader[i];
+    }
+    for (int i = 0; i < program->labels.count; i++) {
+        uint32_t index = program->labels.labels[i].address / 4u;
+        if (index < (uint32_t)program->instruction_count) {
+            boundary[index] = 1;
+        }
+    }
+    return boundary;
+}
+
+int superopt_program(const ParseResult* program, const SuperoptConfig* config, SuperoptResult* result) {
+    SuperoptConfig defaults;
+    if (!config) {
+        superopt_config_default(&defaults);
+        config = &defaults;
+    }
+    if (!program || !result || config->max_window < 2 || config->max_window > SUPEROPT_MAX_WINDOW ||
+        config->max_replacement < 0 || config->max_replacement > SUPEROPT_MAX_REPLACEMENT ||
+        config->exhaustive_bits < 16 || config->exhaustive_bits > 32) {
+        return SUPEROPT_ERROR_INVALID_CONFIG;
+    }
+    memset(result, 0, sizeof(SuperoptResult));
+
+    FlowAnalysis flow;
+    int status = flow_analysis_build(&flow, program);
+    if (status != FLOW_SUCCESS) {
+        return status == FLOW_ERROR_UNSAFE_TARGET ? SUPEROPT_ERROR_UNSAFE_TARGET : SUPEROPT_ERROR_NO_MEMORY;
+    }
+
+    uint8_t* boundary = mark_boundaries(program, &flow);
+    if (!boundary) {
+        flow_analysis_free(&flow);
+        return SUPEROPT_ERROR_NO_MEMORY;
+    }
+
+    status = SUPEROPT_SUCCESS;
+    int count = program->instruction_count;
+
+    for (int i = 0; i < count && status == SUPEROPT_SUCCESS; ) {
+        if (!is_window_opcode(program->instructions[i].opcode)) {
+            i++;
+            continue;
+        }
+
+        // Линейный участок без переходов, меток и памяти
+        int end = i + 1;
+        while (end < count && !boundary[end] && is_window_opcode(program->instructions[end].opcode)) {
+            end++;
+        }
+
+        // Сначала самое длинное окно с каждой позиции; найденные окна не пересекаются
+        int position = i;
+        while (position + 1 < end && status == SUPEROPT_SUCCESS) {
+            int found = 0;
+            int longest = end - position < config->max_window ? end - position : config->max_window;
+
+            for (int length = longest; length >= 2 && !found && status == SUPEROPT_SUCCESS; length--) {
+                status = search_window(program, &flow, config, position, length, result, &found);
+                if (found) {
+                    position += length;
+                }
+            }
+            if (!found) {
+                position++;
+            }
+        }
+
+        i = end;
+    }
+
+    free(boundary);
+    flow_analysis_free(&flow);
+    if (status != SUPEROPT_SUCCESS) {
+        superopt_result_free(result);
+    }
+    return status;
+}
+
+void superopt_result_free(SuperoptResult* result) {
+    if (!result) {
+        return;
+    }
+    free(result->suggestions);
+    memset(result, 0, sizeof(SuperoptResult));
+}
+
+static void print_sequence(const uint32_t* code, int length, FILE* output) {
+    if (length == 0) {
+        fprintf(output, "(nothing)");
+    }
+    for (int i = 0; i < length; i++) {
+        char text[32];
+        isa_disassemble(code[i], text, sizeof(text));
+        fprintf(output, "%s%s", i > 0 ? "; " : "", text);
+    }
+}
+
+void superopt_print_suggestions(const ParseResult* program, const SuperoptResult* result, FILE* output) {
+    for (int i = 0; i < result->count; i++) {
+        const SuperoptSuggestion* suggestion = &result->suggestions[i];
+        uint32_t original[SUPEROPT_MAX_WINDOW];
+
+        for (int k = 0; k < suggestion->length; k++) {
+            original[k] = program->instructions[suggestion->start + k].machine_code;
+        }
+
+        fprintf(output, "line %d: ", program->instructions[suggestion->start].line_number);
+        print_sequence(original, suggestion->length, output);
+        fprintf(output, " -> ");
+        print_sequence(suggestion->replacement, suggestion->replacement_length, output);
+        fprintf(output, " (%s)\n", suggestion->exhaustive ? "exhaustive" : "sampled");
+    }
+
+    fprintf(output, "Superoptimizer: %d windows, %llu candidates, %d replacements\n",
+            result->windows_searched, (unsigned long long)result->candidates_tested, result->count);
+}
+
+// Длина меток "имя:" в начале строки (0 - меток нет)
+static size_t label_prefix_length(const char* line, size_t length) {
+    size_t prefix = 0;
+    size_t p = 0;
+
+    for (;;) {
+        while (p < length && (line[p] == ' ' || line[p] == '\t')) {
+            p++;
+        }
+        size_t name = p;
+        while (p < length && (isalnum((unsigned char)line[p]) || line[p] == '_' || line[p] == '.')) {
+            p++;
+        }
+        if (p == name || p >= length || line[p] != ':') {
+            return prefix;
+        }
+        prefix = ++p;
+    }
+}
+
+int superopt_rewrite_source(const char* source, size_t size, const ParseResult* program,
+                            const SuperoptResult* result, FILE* output) {
+    const char* line = source;
+    const char* end = source + size;
+    int line_number = 1;
+    int next = 0;                    // Следующая замена
+
+    while (line < end) {
+        const char* line_end = memchr(line, '\n', (size_t)(end - line));
+        size_t length = line_end ? (size_t)(line_end - line) : (size_t)(end - line);
+
+        // Замены, проверенные только выборочно, в текст не попадают
+        while (next < result->count && !result->suggestions[next].exhaustive) {
+            next++;
+        }
+
+        const SuperoptSuggestion* suggestion = next < result->count ? &result->suggestions[next] : NULL;
+        int first_line = suggestion ? program->instructions[suggestion->start].line_number : 0;
+        int last_line = suggestion ? program->instructions[suggestion->start + suggestion->length - 1].line_number : 0;
+
+        if (suggestion && line_number >= first_line && line_number <= last_line) {
+            size_t prefix = label_prefix_length(line, length);
+            if (prefix > 0) {
+                fprintf(output, "%.*s\n", (int)prefix, line);
+            }
+            while (prefix < length && (line[prefix] == ' ' || line[prefix] == '\t')) {
+                prefix++;
+            }
+            fprintf(output, "    ; superopt: %.*s\n", (int)(length - prefix), line + prefix);
+
+            if (line_number == last_line) {
+                for (int k = 0; k < suggestion->replacement_length; k++) {
+                    char text[32];
+                    isa_disassemble(suggestion->replacement[k], text, sizeof(text));
+                    fprintf(output, "    %s\n", text);
+                }
+                next++;
+            }
+        } else {
+            fprintf(output, "%.*s\n", (int)length, line);
+        }
+
+        line += length + 1;
+        line_number++;
+    }
+
+    return ferror(output) ? SUPEROPT_ERROR_IO : SUPEROPT_SUCCESS;
+}
+
+int superopt_file(const char* input_filename, const char* output_filename, const SuperoptConfig* config) {
+    SourceBuffer source;
+    if (!input_filename || source_buffer_open_file(&source, input_filename) != 0) {
+        return SUPEROPT_ERROR_IO;
+    }
+
+    ParseResult* program = parse_buffer(source.data, source.size);
+    if (!program || program->instruction_count <= 0) {
+        parse_result_free(program);
+        source_buffer_close(&source);
+        return SUPEROPT_ERROR_PARSE;
+    }
+
+    SuperoptResult result;
+    int status = superopt_program(program, config, &result);
+
+    if (status == SUPEROPT_SUCCESS) {
+        superopt_print_suggestions(program, &result, stdout);
+
+        if (output_filename) {
+            FILE* output = fopen(output_filename, "w");
+            status = output ? superopt_rewrite_source(source.data, source.size, program, &result, output)
+                            : SUPEROPT_ERROR_IO;
+            if (output && fclose(output) != 0) {
+                status = SUPEROPT_ERROR_IO;
+            }
+        }
+        superopt_result_free(&result);
+    }
+
+    parse_result_free(program);
+    source_buffer_close(&source);
+    return status;
+}
@@ -0,0 +1,126 @@
+#ifndef TIERINGHEADER_H
+#define TIERINGHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "emulatorHeader.h"
+#include "verifierHeader.h"
+
+// Многоуровневое выполнение проверенной программы (см. verifierHeader.h).
+//
+// Для каждого линейного участка считается число входов:
+//   - интерпретатор: emulator_fetch_execute_cycle, участок не подготовлен;
+//   - предекодированный: emulator_execute_verified (проверки адресов на
+//     входе в участок, счётные циклы, без мёртвых записей) после
+//     decoded_threshold входов и подготовки участка (verifier_prepare_block);
+//   - шитый код: после threaded_threshold входов участок переводится в
+//     массив операций с адресами обработчиков и указателями на регистры.
+//     Каждый обработчик сам переходит к следующему (computed goto GCC/Clang,
+//     иначе switch), счётчик инструкций обновляется один раз на участок.
+// Подготовка и перевод выполняются в фоновом потоке (asynchronous): пока
+// результат не опубликован, участок остаётся на прежнем уровне. Поток
+// создаётся при первом запросе, поэтому короткие прогоны, не дошедшие до
+// порогов, не платят ни за поток, ни за анализ участков. Участки одного
+// уровня выполняются цепочкой без возврата в диспетчер; предекодированный
+// участок возвращается в него после оставшихся до порога входов (или
+// TIERING_POLL_ENTRIES, пока перевод не опубликован), чтобы горячий цикл
+// внутри цепочки дошёл до шитого кода. Генерации машинного кода хоста нет:
+// шитый код - самый быстрый переносимый уровень.
+
+// Уровни выполнения
+typedef enum {
+    TIER_INTERPRETER = 0,
+    TIER_DECODED,
+    TIER_THREADED,
+    TIER_COUNT
+} ExecutionTier;
+
+extern const char* TierNames[TIER_COUNT];
+
+// Коды ошибок
+typedef enum {
+    TIERING_SUCCESS = 0,
+    TIERING_ERROR_NOT_VERIFIED,      // Программа не прошла проверку при загрузке
+    TIERING_ERROR_NO_MEMORY,         // Не удалось выделить память
+    TIERING_ERROR_COUNT              // Количество кодов ошибок (всегда последний)
+} TieringErrorCode;
+
+extern const char* TieringErrorMessages[TIERING_ERROR_COUNT];
+
+#define TIERING_DEFAULT_DECODED_THRESHOLD 16
+#define TIERING_DEFAULT_THREADED_THRESHOLD 256
+#define TIERING_POLL_ENTRIES 1024    // Входов по цепочке между проверками публикации перевода
+
+typedef struct {
+    uint32_t decoded_threshold;      // Входов в участок до предекодированного уровня
+    uint32_t threaded_threshold;     // Входов до шитого кода (0 - не переводить)
+    int asynchronous;                // Подготовка и перевод в фоновом потоке
+} TieringConfig;
+
+struct ThreadedBlock;                // Участок в шитом коде (tieringSrc.c)
+
+// Фоновая работа над участком
+#define TIERING_REQUEST_PREPARE 1    // verifier_prepare_block
+#define TIERING_REQUEST_TRANSLATE 2  // Перевод в шитый код
+
+// Состояние участка
+typedef struct {
+    uint32_t entries;                // Входов в участок (насыщается)
+    uint32_t chain_budget;           // Выданные предекодированной цепочке входы
+    uint8_t tier;                    // Уровень (меняет только выполняющий поток)
+    uint8_t requested;               // Запрошенная фоновая работа (биты TIERING_REQUEST_*)
+    _Atomic(struct ThreadedBlock*) threaded; // Публикуется фоновым потоком
+} TieredBlock;
+
+// Счётчики по уровням
+typedef struct {
+    uint64_t instructions[TIER_COUNT];
+    uint64_t block_entries[TIER_COUNT]; // Передач управления уровню из диспетчера
+    uint64_t time_ns[TIER_COUNT];    // Время выполнения на уровне
+    uint32_t promotions[TIER_COUNT]; // Участков, поднятых на уровень
+} TieringStats;
+
+typedef struct TieredExecutor {
+    CPU* cpu;
+    VerifiedProgram* program;
+    uint32_t generation;             // Поколение программы при подготовке
+    TieringConfig config;
+    TieredBlock* blocks;             // По участкам program
+    uint32_t* chained;               // Оставшиеся входы по цепочке (emulator_execute_verified)
+    const void* const* labels;       // Адреса обработчиков шитого кода (NULL - switch)
+    TieringStats stats;
+
+    // Очередь фоновой работы: каждый запрос ставится в неё не более одного раза
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+    int thread_started;
+    int stopping;
+    uint32_t* queue;
+    uint32_t queue_head;
+    uint32_t queue_tail;
+    _Atomic uint64_t background_time_ns; // Время подготовки и перевода
+    _Atomic uint32_t prepared_blocks;
+    _Atomic uint32_t translated_blocks;
+} TieredExecutor;
+
+void tiering_config_default(TieringConfig* config);
+
+// Подготовка по проверенной программе, загруженной в cpu; config = NULL - по умолчанию.
+// Исполнитель освобождается до перезагрузки программы: фоновый поток читает её участки.
+int tiering_init(TieredExecutor* executor, CPU* cpu, const TieringConfig* config);
+void tiering_free(TieredExecutor* executor);
+
+// Подходит ли подготовленное состояние для текущей программы cpu
+int tiering_is_current(const TieredExecutor* executor, const VerifiedProgram* program);
+
+// Выполнение с IP (начало участка) до остановки или ошибки; результат как у emulator_execute
+int tiering_run(TieredExecutor* executor);
+
+void tiering_print_report(const TieredExecutor* executor, FILE* output);
+
+#endif //TIERINGHEADER_H
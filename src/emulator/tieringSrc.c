@@ -0,0 +1,715 @@
+#include "tieringHeader.h"
+#include "metricsHeader.h"
+#include "packedHeader.h"
+
+const char* TierNames[TIER_COUNT] = {
+    "interpreter",                    // TIER_INTERPRETER
+    "decoded",                        // TIER_DECODED
+    "threaded"                        // TIER_THREADED
+};
+
+// Массив строк с сообщениями об ошибках
+const char* TieringErrorMessages[TIERING_ERROR_COUNT] = {
+    "Success",                        // TIERING_SUCCESS
+    "Program is not verified",        // TIERING_ERROR_NOT_VERIFIED
+    "Out of memory"                   // TIERING_ERROR_NO_MEMORY
+};
+
+// Переход по адресу метки (расширение GCC/Clang); иначе - switch по виду операции
+#if defined(__GNUC__)
+#define TIERING_COMPUTED_GOTO 1
+#else
+#define TIERING_COMPUTED_GOTO 0
+#endif
+
+// Операции шитого кода: инструкции участка без nop и завершение участка
+#define THREADED_KINDS(X) \
+    X(ADD) X(SUB) X(MUL) X(MUL_LOW) X(DIV) X(CMPGE) X(RSHFT) X(LSHFT) \
+    X(AND) X(OR) X(XOR) X(SET_CONST) X(LD) X(ST) \
+    X(ADDSB) X(SUBSB) X(CMPGEB) X(MINB) X(MAXB) X(LDM) X(STM) \
+    X(FALL_THROUGH) X(BRANCH) X(HALT)
+
+typedef enum {
+#define X(name) THREADED_##name,
+    THREADED_KINDS(X)
+#undef X
+    THREADED_KIND_COUNT
+} ThreadedKind;
+
+typedef struct {
+    const void* label;               // Адрес обработчика (TIERING_COMPUTED_GOTO)
+    uint16_t* dst;
+    const uint16_t* a;               // bnz - регистр условия
+    const uint16_t* b;
+    uint16_t* dst_high;              // mul: RF[(dst + 1) & 15]
+    uint16_t value;                  // set_const - константа, ld/st/ldm/stm - бит проверки участка
+    uint8_t kind;                    // ThreadedKind
+    uint8_t group;                   // ldm/stm: первый регистр группы
+    uint32_t index;                  // Номер инструкции (для ошибок)
+} ThreadedOp;
+
+typedef struct ThreadedBlock {
+    const VerifiedBlock* block;
+    uint32_t taken_block;            // Номер участка цели bnz (VERIFIER_NO_BLOCK - нет)
+    uint32_t next_block;             // Номер участка с инструкции end
+    uint32_t count;
+    ThreadedOp ops[];                // Последняя операция завершает участок
+} ThreadedBlock;
+
+// Выполнение шитого кода с участка threaded до перехода в участок другого
+// уровня, остановки или ошибки; правила как у emulator_execute_verified.
+// Вызов с labels != NULL только возвращает адреса обработчиков.
+static int tiering_threaded_execute(TieredExecutor* executor, const ThreadedBlock* threaded,
+                                    uint32_t* index, const void* const** labels) {
+#if TIERING_COMPUTED_GOTO
+    static const void* const handlers[THREADED_KIND_COUNT] = {
+#define X(name) &&threaded_##name,
+        THREADED_KINDS(X)
+#undef X
+    };
+#define THREADED_DISPATCH() goto *op->label
+#else
+    static const void* const handlers[THREADED_KIND_COUNT] = {NULL};
+#define THREADED_DISPATCH() goto threaded_dispatch
+#endif
+    if (labels) {
+        *labels = TIERING_COMPUTED_GOTO ? handlers : NULL;
+        return EMULATOR_SUCCESS;
+    }
+
+    CPU* cpu = executor->cpu;
+    uint16_t* RF = cpu->RF;
+    uint8_t* data = cpu->memory.data_memory;
+    size_t data_size = cpu->memory.data_size;
+    const VerifiedBlock* block;
+    const ThreadedOp* op;
+    uint64_t guards_passed;
+    uint64_t retired = 0;
+    uint32_t successor;
+    int result;
+
+threaded_enter:
+    block = threaded->block;
+
+    // Счётный цикл без побочных эффектов: сразу состояние на выходе
+    if (block->loop) {
+        uint32_t trips = counted_loop_trip_count(block->loop, RF);
+        if (trips >= COUNTED_LOOP_MIN_TRIPS) {
+            counted_loop_fast_forward(block->loop, RF, trips);
+            retired += (uint64_t)trips * (block->end - block->first);
+            successor = threaded->next_block;
+            goto threaded_successor;
+        }
+    }
+
+    // Бит g+1 - проверка g участка пройдена (бит 0 - обращения без проверки участка)
+    guards_passed = 0;
+    for (uint32_t g = 0; g < block->guard_count; g++) {
+        if (address_guard_passes(&block->guards[g], RF, data_size)) {
+            guards_passed |= (uint64_t)1 << (g + 1);
+        }
+    }
+
+    op = threaded->ops;
+    THREADED_DISPATCH();
+
+threaded_ADD:
+    *op->dst = *op->a + *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_SUB:
+    *op->dst = *op->a - *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_MUL:
+    {
+        uint32_t product = (uint32_t)*op->a * (uint32_t)*op->b;
+        *op->dst = product & 0xFFFF;
+        *op->dst_high = (product >> 16) & 0xFFFF;
+    }
+    op++;
+    THREADED_DISPATCH();
+
+// Старшая половина не читается (см. verifierHeader.h)
+threaded_MUL_LOW:
+    *op->dst = (uint16_t)((uint32_t)*op->a * (uint32_t)*op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_DIV:
+    if (*op->b == 0) {
+        emulator_print_error(EMULATOR_DIVISION_BY_ZERO, "Division by zero");
+        result = EMULATOR_DIVISION_BY_ZERO;
+        goto threaded_error;
+    }
+    *op->dst = *op->a / *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_CMPGE:
+    *op->dst = (*op->a >= *op->b) ? 1 : 0;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_RSHFT:
+    *op->dst = *op->a >> *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_LSHFT:
+    *op->dst = *op->a << *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_AND:
+    *op->dst = *op->a & *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_OR:
+    *op->dst = *op->a | *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_XOR:
+    *op->dst = *op->a ^ *op->b;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_SET_CONST:
+    *op->dst = op->value;
+    op++;
+    THREADED_DISPATCH();
+
+threaded_LD:
+    {
+        uint16_t addr = (uint16_t)(*op->a + *op->b);
+        if ((guards_passed >> op->value) & 1) {
+            *op->dst = (uint16_t)((data[addr + 1] << 8) | data[addr]);
+        } else {
+            uint16_t value;
+            if (memory_read_word(&cpu->memory, addr, &value) != MEMORY_SUCCESS) {
+                emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to read memory");
+                result = EMULATOR_MEMORY_ERROR;
+                goto threaded_error;
+            }
+            *op->dst = value;
+        }
+    }
+    op++;
+    THREADED_DISPATCH();
+
+// st: a, b - регистры адреса, dst - регистр значения
+threaded_ST:
+    {
+        uint16_t addr = (uint16_t)(*op->a + *op->b);
+        if ((guards_passed >> op->value) & 1) {
+            data[addr] = *op->dst & 0xFF;
+            data[addr + 1] = (*op->dst >> 8) & 0xFF;
+        } else if (memory_write_word(&cpu->memory, addr, *op->dst) != MEMORY_SUCCESS) {
+            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
+            result = EMULATOR_MEMORY_ERROR;
+            goto threaded_error;
+        }
+    }
+    op++;
+    THREADED_DISPATCH();
+
+threaded_ADDSB:
+    *op->dst = packed_add_saturate(*op->a, *op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_SUBSB:
+    *op->dst = packed_sub_saturate(*op->a, *op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_CMPGEB:
+    *op->dst = packed_compare_ge(*op->a, *op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_MINB:
+    *op->dst = packed_min(*op->a, *op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_MAXB:
+    *op->dst = packed_max(*op->a, *op->b);
+    op++;
+    THREADED_DISPATCH();
+
+threaded_LDM:
+    {
+        uint16_t addr = (uint16_t)(*op->a + *op->b);
+        uint16_t values[ISA_GROUP_SIZE];
+        if ((guards_passed >> op->value) & 1) {
+            for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                values[k] = (uint16_t)((data[addr + 2 * k + 1] << 8) | data[addr + 2 * k]);
+            }
+        } else if (memory_read_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to read memory");
+            result = EMULATOR_MEMORY_ERROR;
+            goto threaded_error;
+        }
+        for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+            RF[(op->group + k) & 0x0F] = values[k];
+        }
+    }
+    op++;
+    THREADED_DISPATCH();
+
+threaded_STM:
+    {
+        uint16_t addr = (uint16_t)(*op->a + *op->b);
+        uint16_t values[ISA_GROUP_SIZE];
+        for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+            values[k] = RF[(op->group + k) & 0x0F];
+        }
+        if ((guards_passed >> op->value) & 1) {
+            for (int k = 0; k < ISA_GROUP_SIZE; k++) {
+                data[addr + 2 * k] = values[k] & 0xFF;
+                data[addr + 2 * k + 1] = (values[k] >> 8) & 0xFF;
+            }
+        } else if (memory_write_words(&cpu->memory, addr, values, ISA_GROUP_SIZE) != MEMORY_SUCCESS) {
+            emulator_print_error(EMULATOR_MEMORY_ERROR, "Failed to write memory");
+            result = EMULATOR_MEMORY_ERROR;
+            goto threaded_error;
+        }
+    }
+    op++;
+    THREADED_DISPATCH();
+
+threaded_FALL_THROUGH:
+    retired += block->end - block->first;
+    successor = threaded->next_block;
+    goto threaded_successor;
+
+threaded_BRANCH:
+    retired += block->end - block->first;
+    successor = *op->a != 0 ? threaded->taken_block : threaded->next_block;
+    goto threaded_successor;
+
+threaded_HALT:
+    cpu->instructions_retired += retired + (block->end - block->first);
+    cpu->IP = 0;
+    cpu->running = 0;
+    *index = 0;
+    return EMULATOR_HALT;
+
+threaded_successor:
+    // Цепочка продолжается только по участкам, поднятым на этот уровень
+    if (executor->blocks[successor].tier == TIER_THREADED) {
+        threaded = atomic_load_explicit(&executor->blocks[successor].threaded, memory_order_relaxed);
+        goto threaded_enter;
+    }
+    cpu->instructions_retired += retired;
+    *index = executor->program->blocks[successor].first;
+    return EMULATOR_SUCCESS;
+
+threaded_error:
+    // IP остаётся на инструкции, вызвавшей ошибку
+    cpu->instructions_retired += retired + (op->index - block->first);
+    cpu->IP = (uint16_t)(op->index * INSTRUCTION_SIZE);
+    *index = op->index;
+    return result;
+
+#if !TIERING_COMPUTED_GOTO
+threaded_dispatch:
+    switch (op->kind) {
+#define X(name) case THREADED_##name: goto threaded_##name;
+        THREADED_KINDS(X)
+#undef X
+        default:
+            break;
+    }
+    emulator_print_error(EMULATOR_INVALID_INSTRUCTION, "Unknown opcode");
+    result = EMULATOR_INVALID_INSTRUCTION;
+    goto threaded_error;
+#endif
+#undef THREADED_DISPATCH
+}
+
+// Перевод подготовленного участка в шитый код; NULL - не хватило памяти
+static ThreadedBlock* tiering_translate(const TieredExecutor* executor, uint32_t b) {
+    const VerifiedProgram* program = executor->program;
+    const VerifiedBlock* block = &program->blocks[b];
+    uint32_t length = block->end - block->first;
+    ThreadedBlock* threaded = (ThreadedBlock*)malloc(sizeof(ThreadedBlock) + (length + 1) * sizeof(ThreadedOp));
+    if (!threaded) {
+        return NULL;
+    }
+
+    threaded->block = block;
+    threaded->taken_block = block->taken ? (uint32_t)(block->taken - program->blocks) : VERIFIER_NO_BLOCK;
+    threaded->next_block = block->next ? (uint32_t)(block->next - program->blocks) : VERIFIER_NO_BLOCK;
+    threaded->count = 0;
+
+    uint16_t* RF = executor->cpu->RF;
+    ThreadedOp* op = threaded->ops;
+    for (uint32_t i = block->first; i < block->end; i++) {
+        const DecodedInstruction* in = &program->instructions[i];
+        memset(op, 0, sizeof(*op));
+        op->index = i;
+        op->dst = &RF[in->field2];
+        op->a = &RF[in->field0];
+        op->b = &RF[in->field1];
+        op->value = in->operand;
+        op->group = in->field2;
+
+        switch (in->opcode) {
+            case OPC_NOP: continue;
+            case OPC_ADD: op->kind = THREADED_ADD; break;
+            case OPC_SUB: op->kind = THREADED_SUB; break;
+            case OPC_MUL:
+                op->kind = in->operand ? THREADED_MUL_LOW : THREADED_MUL;
+                op->dst_high = &RF[(in->field2 + 1) & 0x0F];
+                break;
+            case OPC_DIV: op->kind = THREADED_DIV; break;
+            case OPC_CMPGE: op->kind = THREADED_CMPGE; break;
+            case OPC_RSHFT: op->kind = THREADED_RSHFT; break;
+            case OPC_LSHFT: op->kind = THREADED_LSHFT; break;
+            case OPC_AND: op->kind = THREADED_AND; break;
+            case OPC_OR: op->kind = THREADED_OR; break;
+            case OPC_XOR: op->kind = THREADED_XOR; break;
+            case OPC_SET_CONST: op->kind = THREADED_SET_CONST; break;
+            case OPC_LD: op->kind = THREADED_LD; break;
+            case OPC_ADDSB: op->kind = THREADED_ADDSB; break;
+            case OPC_SUBSB: op->kind = THREADED_SUBSB; break;
+            case OPC_CMPGEB: op->kind = THREADED_CMPGEB; break;
+            case OPC_MINB: op->kind = THREADED_MINB; break;
+            case OPC_MAXB: op->kind = THREADED_MAXB; break;
+            case OPC_LDM: op->kind = THREADED_LDM; break;
+            case OPC_STM: op->kind = THREADED_STM; break;
+            case OPC_ST:
+                // st R_value, R_base, R_offset
+                op->kind = THREADED_ST;
+                op->dst = &RF[in->field0];
+                op->a = &RF[in->field1];
+                op->b = &RF[in->field2];
+                break;
+            case OPC_BNZ: op->kind = THREADED_BRANCH; break;
+            case OPC_READY: op->kind = THREADED_HALT; break;
+            default:
+                free(threaded);
+                return NULL;
+        }
+
+        op->label = executor->labels ? executor->labels[op->kind] : NULL;
+        op++;
+        threaded->count++;
+    }
+
+    // Участок без bnz и ready в конце проваливается в следующий
+    if (threaded->count == 0 ||
+        (op[-1].kind != THREADED_BRANCH && op[-1].kind != THREADED_HALT)) {
+        memset(op, 0, sizeof(*op));
+        op->kind = THREADED_FALL_THROUGH;
+        op->index = block->end;
+        op->label = executor->labels ? executor->labels[op->kind] : NULL;
+        threaded->count++;
+    }
+
+    return threaded;
+}
+
+// Фоновая работа над участком: подготовка или перевод в шитый код
+static void tiering_process_request(TieredExecutor* executor, uint32_t b, int request) {
+    uint64_t start = metrics_now_ns();
+
+    if (request == TIERING_REQUEST_PREPARE) {
+        if (verifier_prepare_block(executor->program, b) == VERIFIER_SUCCESS) {
+            atomic_fetch_add_explicit(&executor->prepared_blocks, 1, memory_order_relaxed);
+        }
+    } else {
+        ThreadedBlock* threaded = tiering_translate(executor, b);
+        if (threaded) {
+            atomic_store_explicit(&executor->blocks[b].threaded, threaded, memory_order_release);
+            atomic_fetch_add_explicit(&executor->translated_blocks, 1, memory_order_relaxed);
+        }
+    }
+
+    atomic_fetch_add_explicit(&executor->background_time_ns, metrics_now_ns() - start, memory_order_relaxed);
+}
+
+// Фоновый поток: берёт запросы из очереди (участок * 2 + перевод)
+static void* tiering_worker(void* argument) {
+    TieredExecutor* executor = (TieredExecutor*)argument;
+
+    pthread_mutex_lock(&executor->lock);
+    for (;;) {
+        while (!executor->stopping && executor->queue_head == executor->queue_tail) {
+            pthread_cond_wait(&executor->wake, &executor->lock);
+        }
+        if (executor->stopping) {
+            break;
+        }
+
+        uint32_t item = executor->queue[executor->queue_head++];
+        pthread_mutex_unlock(&executor->lock);
+
+        tiering_process_request(executor, item / 2,
+                                (item & 1) ? TIERING_REQUEST_TRANSLATE : TIERING_REQUEST_PREPARE);
+
+        pthread_mutex_lock(&executor->lock);
+    }
+    pthread_mutex_unlock(&executor->lock);
+
+    return NULL;
+}
+
+// Постановка запроса в очередь; без потока работа выполняется сразу
+static void tiering_request(TieredExecutor* executor, uint32_t b, int request) {
+    executor->blocks[b].requested |= (uint8_t)request;
+
+    if (executor->config.asynchronous) {
+        pthread_mutex_lock(&executor->lock);
+        if (!executor->thread_started) {
+            executor->thread_started =
+                pthread_create(&executor->thread, NULL, tiering_worker, executor) == 0;
+        }
+        if (executor->thread_started) {
+            executor->queue[executor->queue_tail++] = b * 2 + (request == TIERING_REQUEST_TRANSLATE);
+            pthread_cond_signal(&executor->wake);
+            pthread_mutex_unlock(&executor->lock);
+            return;
+        }
+        pthread_mutex_unlock(&executor->lock);
+    }
+
+    tiering_process_request(executor, b, request);
+}
+
+// Подъём участка по числу входов, когда фоновая работа опубликована.
+// Предекодированный участок проверяется, только когда его цепочка исчерпала
+// выданные входы (chained[b] == 0).
+static void tiering_promote(TieredExecutor* executor, uint32_t b) {
+    TieredBlock* state = &executor->blocks[b];
+    uint32_t* chained = &executor->chained[b];
+
+    if (state->tier == TIER_INTERPRETER) {
+        if (state->entries < executor->config.decoded_threshold) {
+            return;
+        }
+        if (!(state->requested & TIERING_REQUEST_PREPARE)) {
+            tiering_request(executor, b, TIERING_REQUEST_PREPARE);
+        }
+        if (!verified_block_is_prepared(&executor->program->blocks[b])) {
+            return;
+        }
+        state->tier = TIER_DECODED;
+        executor->stats.promotions[TIER_DECODED]++;
+    }
+
+    if (state->tier != TIER_DECODED || *chained != 0) {
+        return;
+    }
+
+    // Выданные входы израсходованы цепочкой
+    state->entries = state->chain_budget > UINT32_MAX - state->entries
+                         ? UINT32_MAX : state->entries + state->chain_budget;
+
+    uint32_t budget;
+    uint32_t threshold = executor->config.threaded_threshold;
+    if (threshold == 0) {
+        budget = UINT32_MAX;
+    } else if (state->entries < threshold) {
+        budget = threshold - state->entries;
+    } else {
+        if (!(state->requested & TIERING_REQUEST_TRANSLATE)) {
+            tiering_request(executor, b, TIERING_REQUEST_TRANSLATE);
+        }
+        if (atomic_load_explicit(&state->threaded, memory_order_acquire)) {
+            state->tier = TIER_THREADED;
+            state->chain_budget = 0;
+            executor->stats.promotions[TIER_THREADED]++;
+            return;
+        }
+        budget = TIERING_POLL_ENTRIES;
+    }
+    state->chain_budget = budget;
+    *chained = budget;
+}
+
+// Интерпретация участка до входа в следующий участок
+static int tiering_interpret_block(CPU* cpu, const VerifiedProgram* program, uint32_t* index) {
+    // Другие уровни не обновляют IP между участками
+    cpu->IP = (uint16_t)(*index * INSTRUCTION_SIZE);
+    for (;;) {
+        int result = emulator_fetch_execute_cycle(cpu);
+        if (result != EMULATOR_SUCCESS) {
+            *index = cpu->IP / INSTRUCTION_SIZE;
+            return result;
+        }
+        *index = cpu->IP / INSTRUCTION_SIZE;
+        if (program->block_index[*index] != VERIFIER_NO_BLOCK) {
+            return EMULATOR_SUCCESS;
+        }
+    }
+}
+
+void tiering_config_default(TieringConfig* config) {
+    if (!config) {
+        return;
+    }
+    config->decoded_threshold = TIERING_DEFAULT_DECODED_THRESHOLD;
+    config->threaded_threshold = TIERING_DEFAULT_THREADED_THRESHOLD;
+    config->asynchronous = 1;
+}
+
+int tiering_init(TieredExecutor* executor, CPU* cpu, const TieringConfig* config) {
+    if (!executor || !cpu) {
+        return TIERING_ERROR_NOT_VERIFIED;
+    }
+
+    memset(executor, 0, sizeof(*executor));
+    if (config) {
+        executor->config = *config;
+    } else {
+        tiering_config_default(&executor->config);
+    }
+
+    VerifiedProgram* program = cpu->verified_program;
+    if (!program || !program->instructions ||
+        program->generation != cpu->memory.instruction_generation) {
+        return TIERING_ERROR_NOT_VERIFIED;
+    }
+
+    executor->cpu = cpu;
+    executor->program = program;
+    executor->generation = program->generation;
+    executor->blocks = (TieredBlock*)calloc(program->block_count, sizeof(TieredBlock));
+    executor->chained = (uint32_t*)calloc(program->block_count, sizeof(uint32_t));
+    // Каждый участок запрашивается не более одного раза на каждый вид работы
+    executor->queue = (uint32_t*)malloc(2 * program->block_count * sizeof(uint32_t));
+    if (!executor->blocks || !executor->chained || !executor->queue) {
+        free(executor->blocks);
+        free(executor->chained);
+        free(executor->queue);
+        executor->blocks = NULL;
+        executor->chained = NULL;
+        executor->queue = NULL;
+        return TIERING_ERROR_NO_MEMORY;
+    }
+
+    tiering_threaded_execute(executor, NULL, NULL, &executor->labels);
+    pthread_mutex_init(&executor->lock, NULL);
+    pthread_cond_init(&executor->wake, NULL);
+    return TIERING_SUCCESS;
+}
+
+void tiering_free(TieredExecutor* executor) {
+    if (!executor || !executor->blocks) {
+        return;
+    }
+
+    if (executor->thread_started) {
+        pthread_mutex_lock(&executor->lock);
+        executor->stopping = 1;
+        pthread_cond_signal(&executor->wake);
+        pthread_mutex_unlock(&executor->lock);
+        pthread_join(executor->thread, NULL);
+        executor->thread_started = 0;
+    }
+    pthread_mutex_destroy(&executor->lock);
+    pthread_cond_destroy(&executor->wake);
+
+    for (uint32_t b = 0; b < executor->program->block_count; b++) {
+        free(atomic_load_explicit(&executor->blocks[b].threaded, memory_order_relaxed));
+    }
+    free(executor->blocks);
+    free(executor->chained);
+    free(executor->queue);
+    executor->blocks = NULL;
+    executor->chained = NULL;
+    executor->queue = NULL;
+}
+
+int tiering_is_current(const TieredExecutor* executor, const VerifiedProgram* program) {
+    return executor && executor->blocks && program &&
+           executor->program == program && executor->generation == program->generation;
+}
+
+int tiering_run(TieredExecutor* executor) {
+    CPU* cpu = executor->cpu;
+    const VerifiedProgram* program = executor->program;
+    TieringStats* stats = &executor->stats;
+    uint32_t index = cpu->IP / INSTRUCTION_SIZE;
+    int result;
+
+    // Время учитывается только при смене уровня
+    int current_tier = TIER_INTERPRETER;
+    uint64_t tier_start = metrics_now_ns();
+
+    cpu->running = 1;
+
+    do {
+        uint32_t b = program->block_index[index];
+        TieredBlock* state = &executor->blocks[b];
+        if (state->entries != UINT32_MAX) {
+            state->entries++;
+        }
+        if (state->tier != TIER_THREADED) {
+            tiering_promote(executor, b);
+        }
+        int tier = state->tier;
+
+        if (tier != current_tier) {
+            uint64_t now = metrics_now_ns();
+            stats->time_ns[current_tier] += now - tier_start;
+            tier_start = now;
+            current_tier = tier;
+        }
+
+        uint64_t retired = cpu->instructions_retired;
+        switch (tier) {
+            case TIER_THREADED:
+                result = tiering_threaded_execute(executor,
+                                                  atomic_load_explicit(&state->threaded, memory_order_relaxed),
+                                                  &index, NULL);
+                break;
+
+            case TIER_DECODED:
+                // Цепочка предекодированных участков до участка другого уровня
+                // или участка, исчерпавшего выданные входы
+                result = emulator_execute_verified(cpu, program, &index, executor->chained);
+                break;
+
+            default:
+                result = tiering_interpret_block(cpu, program, &index);
+                break;
+        }
+        stats->instructions[tier] += cpu->instructions_retired - retired;
+        stats->block_entries[tier]++;
+    } while (result == EMULATOR_SUCCESS);
+
+    stats->time_ns[current_tier] += metrics_now_ns() - tier_start;
+    return result;
+}
+
+void tiering_print_report(const TieredExecutor* executor, FILE* output) {
+    if (!executor) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+    const TieringStats* stats = &executor->stats;
+
+    fprintf(out, "Tiered execution:\n");
+    for (int tier = 0; tier < TIER_COUNT; tier++) {
+        fprintf(out, "  %-12s instructions %12llu  block entries %10llu  time %10.3f ms  promoted %u\n",
+                TierNames[tier],
+                (unsigned long long)stats->instructions[tier],
+                (unsigned long long)stats->block_entries[tier],
+                stats->time_ns[tier] / 1e6,
+                stats->promotions[tier]);
+    }
+    fprintf(out, "  background: prepared %u blocks, translated %u blocks, time %.3f ms (%s)\n",
+            atomic_load_explicit(&executor->prepared_blocks, memory_order_relaxed),
+            atomic_load_explicit(&executor->translated_blocks, memory_order_relaxed),
+            atomic_load_explicit(&executor->background_time_ns, memory_order_relaxed) / 1e6,
+            executor->config.asynchronous ? "background thread" : "inline");
+}
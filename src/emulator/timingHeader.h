@@ -0,0 +1,68 @@
+#ifndef TIMINGHEADER_H
+#define TIMINGHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Модель не зависит от CPU: регистры и коды операций те же, что в эмуляторе
+#define TIMING_NUM_REGISTERS 16
+#define TIMING_OPCODE_COUNT 256
+
+// Параметры конвейера по умолчанию
+#define TIMING_DEFAULT_PIPELINE_DEPTH 5   // IF, ID, EX, MEM, WB
+#define TIMING_DEFAULT_BRANCH_PENALTY 2   // Тактов потеряно на выполненном переходе BNZ
+#define TIMING_DEFAULT_ALU_LATENCY    1   // Результат доступен следующей инструкции без задержки
+#define TIMING_DEFAULT_LOAD_LATENCY   2   // load-use: один такт простоя
+#define TIMING_DEFAULT_MUL_LATENCY    3
+#define TIMING_DEFAULT_DIV_LATENCY    12
+
+// Конфигурация упорядоченного (in-order) скалярного конвейера
+typedef struct {
+    int pipeline_depth;                   // Количество стадий (стоимость заполнения и слива)
+    int branch_penalty;                   // Штраф за выполненный переход BNZ
+    int latency[TIMING_OPCODE_COUNT];     // Задержка результата по коду операции (в тактах)
+} TimingConfig;
+
+// Статистика по одной инструкции программы (индекс = адрес / 4)
+typedef struct {
+    uint64_t executed;        // Количество выполнений
+    uint64_t cycles;          // Такты между выдачей предыдущей и этой инструкции (с простоями)
+    uint64_t raw_stalls;      // Простои из-за зависимостей RAW по RF
+    uint64_t branch_stalls;   // Простои после выполненного перехода (штраф BNZ)
+} TimingInstructionStats;
+
+// Состояние модели
+typedef struct TimingModel {
+    TimingConfig config;
+    uint64_t reg_ready[TIMING_NUM_REGISTERS]; // Такт, с которого результат регистра доступен
+    uint64_t issue_cycle;                     // Такт выдачи последней инструкции
+    uint64_t pending_branch_penalty;          // Штраф, который получит следующая инструкция
+    uint64_t instructions;                    // Всего выдано инструкций
+    uint64_t raw_stall_cycles;                // Сумма простоев RAW
+    uint64_t branch_stall_cycles;             // Сумма простоев из-за переходов
+    TimingInstructionStats* per_instruction;  // Статистика по адресам
+    size_t per_instruction_count;
+} TimingModel;
+
+// Конфигурация по умолчанию (латентности MUL/DIV/LD больше одного такта)
+void timing_config_default(TimingConfig* config);
+void timing_config_set_latency(TimingConfig* config, uint8_t opcode, int cycles);
+
+// Инициализация модели для памяти инструкций заданного размера (в инструкциях)
+int timing_model_init(TimingModel* model, const TimingConfig* config, size_t instruction_count);
+void timing_model_reset(TimingModel* model);
+void timing_model_free(TimingModel* model);
+
+// Учёт выполненной инструкции: адрес, машинный код, выполнен ли переход
+void timing_model_observe(TimingModel* model, uint16_t address, uint32_t instruction, int branch_taken);
+
+// Итоговые показатели
+uint64_t timing_model_total_cycles(const TimingModel* model);
+double timing_model_cpi(const TimingModel* model);
+
+// Отчёт: такты, CPI и разбивка простоев по инструкциям
+void timing_model_print_report(const TimingModel* model, FILE* output);
+
+#endif //TIMINGHEADER_H
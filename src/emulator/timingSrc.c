@@ -0,0 +1,189 @@
+#include "timingHeader.h"
+#include "../assembler/parserHeader.h"
+
+// Конфигурация по умолчанию
+void timing_config_default(TimingConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->pipeline_depth = TIMING_DEFAULT_PIPELINE_DEPTH;
+    config->branch_penalty = TIMING_DEFAULT_BRANCH_PENALTY;
+
+    for (int i = 0; i < TIMING_OPCODE_COUNT; i++) {
+        config->latency[i] = TIMING_DEFAULT_ALU_LATENCY;
+    }
+
+    config->latency[OPC_LD] = TIMING_DEFAULT_LOAD_LATENCY;
+    config->latency[OPC_LDM] = TIMING_DEFAULT_LOAD_LATENCY;
+    config->latency[OPC_MUL] = TIMING_DEFAULT_MUL_LATENCY;
+    config->latency[OPC_DIV] = TIMING_DEFAULT_DIV_LATENCY;
+}
+
+void timing_config_set_latency(TimingConfig* config, uint8_t opcode, int cycles) {
+    if (!config || cycles < 1) {
+        return;
+    }
+    config->latency[opcode] = cycles;
+}
+
+// Инициализация модели
+int timing_model_init(TimingModel* model, const TimingConfig* config, size_t instruction_count) {
+    if (!model) {
+        return -1;
+    }
+
+    memset(model, 0, sizeof(*model));
+
+    if (config) {
+        model->config = *config;
+    } else {
+        timing_config_default(&model->config);
+    }
+
+    if (model->config.pipeline_depth < 1) {
+        model->config.pipeline_depth = 1;
+    }
+
+    if (instruction_count > 0) {
+        model->per_instruction = (TimingInstructionStats*)calloc(instruction_count, sizeof(TimingInstructionStats));
+        if (!model->per_instruction) {
+            return -1;
+        }
+        model->per_instruction_count = instruction_count;
+    }
+
+    return 0;
+}
+
+// Сброс счётчиков без изменения конфигурации
+void timing_model_reset(TimingModel* model) {
+    if (!model) {
+        return;
+    }
+
+    memset(model->reg_ready, 0, sizeof(model->reg_ready));
+    model->issue_cycle = 0;
+    model->pending_branch_penalty = 0;
+    model->instructions = 0;
+    model->raw_stall_cycles = 0;
+    model->branch_stall_cycles = 0;
+
+    if (model->per_instruction) {
+        memset(model->per_instruction, 0, model->per_instruction_count * sizeof(TimingInstructionStats));
+    }
+}
+
+void timing_model_free(TimingModel* model) {
+    if (!model) {
+        return;
+    }
+
+    free(model->per_instruction);
+    model->per_instruction = NULL;
+    model->per_instruction_count = 0;
+}
+
+// Учёт выполненной инструкции
+void timing_model_observe(TimingModel* model, uint16_t address, uint32_t instruction, int branch_taken) {
+    if (!model) {
+        return;
+    }
+
+    uint8_t opcode = (instruction >> 24) & 0xFF;
+    uint32_t reads, writes;
+    isa_register_usage(instruction, &reads, &writes);
+
+    // Самый ранний такт выдачи без учёта зависимостей
+    uint64_t earliest = model->instructions == 0 ? 0 : model->issue_cycle + 1;
+    uint64_t branch_stall = model->pending_branch_penalty;
+    earliest += branch_stall;
+
+    // Ожидание готовности операндов (RAW)
+    uint64_t issue = earliest;
+    for (int r = 0; r < TIMING_NUM_REGISTERS; r++) {
+        if ((reads & (1u << r)) && model->reg_ready[r] > issue) {
+            issue = model->reg_ready[r];
+        }
+    }
+    uint64_t raw_stall = issue - earliest;
+
+    uint64_t previous_issue = model->issue_cycle;
+    model->issue_cycle = issue;
+
+    // Результат доступен через latency тактов после выдачи
+    uint64_t ready = issue + (uint64_t)model->config.latency[opcode];
+    for (int r = 0; r < TIMING_NUM_REGISTERS; r++) {
+        if (writes & (1u << r)) {
+            model->reg_ready[r] = ready;
+        }
+    }
+
+    model->pending_branch_penalty = (opcode == OPC_BNZ && branch_taken) ? (uint64_t)model->config.branch_penalty : 0;
+
+    model->raw_stall_cycles += raw_stall;
+    model->branch_stall_cycles += branch_stall;
+
+    size_t index = address / 4;
+    if (index < model->per_instruction_count) {
+        TimingInstructionStats* stats = &model->per_instruction[index];
+        stats->executed++;
+        stats->cycles += model->instructions == 0 ? 1 : issue - previous_issue;
+        stats->raw_stalls += raw_stall;
+        stats->branch_stalls += branch_stall;
+    }
+
+    model->instructions++;
+}
+
+// Общее число тактов: выдача последней инструкции плюс слив конвейера
+uint64_t timing_model_total_cycles(const TimingModel* model) {
+    if (!model || model->instructions == 0) {
+        return 0;
+    }
+    return model->issue_cycle + (uint64_t)model->config.pipeline_depth;
+}
+
+double timing_model_cpi(const TimingModel* model) {
+    if (!model || model->instructions == 0) {
+        return 0.0;
+    }
+    return (double)timing_model_total_cycles(model) / (double)model->instructions;
+}
+
+// Отчёт по модели
+void timing_model_print_report(const TimingModel* model, FILE* output) {
+    if (!model) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+    uint64_t total = timing_model_total_cycles(model);
+    uint64_t fill = model->instructions > 0 ? (uint64_t)model->config.pipeline_depth - 1 : 0;
+
+    fprintf(out, "Pipeline timing (depth %d, branch penalty %d):\n",
+            model->config.pipeline_depth, model->config.branch_penalty);
+    fprintf(out, "  instructions:  %llu\n", (unsigned long long)model->instructions);
+    fprintf(out, "  total cycles:  %llu\n", (unsigned long long)total);
+    fprintf(out, "  CPI:           %.3f\n", timing_model_cpi(model));
+    fprintf(out, "  RAW stalls:    %llu\n", (unsigned long long)model->raw_stall_cycles);
+    fprintf(out, "  branch stalls: %llu\n", (unsigned long long)model->branch_stall_cycles);
+    fprintf(out, "  fill/drain:    %llu\n", (unsigned long long)fill);
+
+    fprintf(out, "Address | Executed   | Cycles     | RAW stalls | Branch stalls | CPI\n");
+    fprintf(out, "--------+------------+------------+------------+---------------+-------\n");
+
+    for (size_t i = 0; i < model->per_instruction_count; i++) {
+        const TimingInstructionStats* stats = &model->per_instruction[i];
+        if (stats->executed == 0) {
+            continue;
+        }
+        fprintf(out, "0x%04zX  | %10llu | %10llu | %10llu | %13llu | %.3f\n",
+                i * 4,
+                (unsigned long long)stats->executed,
+                (unsigned long long)stats->cycles,
+                (unsigned long long)stats->raw_stalls,
+                (unsigned long long)stats->branch_stalls,
+                (double)stats->cycles / (double)stats->executed);
+    }
+}
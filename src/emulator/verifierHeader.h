@@ -0,0 +1,203 @@
+#ifndef VERIFIERHEADER_H
+#define VERIFIERHEADER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../assembler/isaHeader.h"
+
+// Статическая проверка программы при загрузке.
+//
+// Программа проверена, если:
+//   - размер кратен 4 и не равен нулю;
+//   - каждый код операции определён в ISA;
+//   - каждое поле-регистр содержит номер R0-R15;
+//   - каждая цель bnz выровнена на 4 и указывает на инструкцию программы;
+//   - последняя инструкция - ready (выполнение не выходит за конец программы).
+// Для проверенной программы IP всегда указывает на инструкцию программы,
+// поэтому эмулятор выполняет её без проверок регистров, выравнивания и
+// конца программы (см. emulator_execute). Проверки адресов ld/st и деления
+// на ноль зависят от данных и остаются.
+//
+// Проверки адресов ld/st выносятся на вход линейного участка. Внутри участка
+// значения регистров отслеживаются как "значение на входе + константа" или
+// константа; адрес ld/st, выраженный через не более чем два регистра на входе,
+// попадает в группу с общей базой RF[base0] + RF[base1] и одной чётностью
+// смещения. На входе в участок для каждой группы один раз проверяется, что
+// база + [min_offset, max_offset] лежит в памяти данных без переполнения
+// и адреса чётны; обращения прошедших групп выполняются без проверок,
+// остальные - через memory_read_word/memory_write_word. Для ldm/stm в
+// диапазон входят все ISA_GROUP_SIZE слов.
+//
+// Счётные циклы. Участок, который заканчивается bnz на своё начало и состоит
+// только из add, sub, set_const и nop, не имеет побочных эффектов. За одну
+// итерацию каждый регистр получает линейную комбинацию значений на входе
+// в итерацию. Если каждый регистр - инвариант (не меняется), константа
+// итерации (зависит только от инвариантов), индукция (r += шаг из
+// инвариантов) или накопитель (r += индукции и инварианты), то состояние
+// после n итераций вычисляется в замкнутом виде, а n - из сравнения
+// c + n * шаг = 0 (mod 2^16) для регистра условия bnz.
+//
+// Участки связаны указателями на преемников (переход и проваливание), поэтому
+// при выполнении bnz номер инструкции цели не переводится в участок.
+//
+// Мёртвые записи. Обратный анализ живости регистров по участкам удаляет
+// записи, результат которых перезаписывается раньше, чем читается: такие
+// инструкции без побочных эффектов становятся nop, а у mul с неиспользуемой
+// старшей половиной запись в dst+1 пропускается. Регистры видны после
+// остановки и после ошибки, поэтому на ready, div и обращениях к памяти все
+// регистры живы.
+//
+// Подготовка по участкам. При загрузке выполняются только проверки выше,
+// разбиение на участки и связывание преемников. Декодирование, проверки
+// адресов, поиск счётного цикла и удаление мёртвых записей выполняются для
+// участка при подготовке (verifier_prepare_block), первая подготовка
+// анализирует живость всей программы. Поэтому короткие прогоны, которые
+// многоуровневое выполнение (tieringHeader.h) оставляет в интерпретаторе,
+// не платят за анализ. Выполнение без уровней готовит все участки перед
+// первым запуском (verifier_prepare_all).
+
+// Коды результата проверки
+typedef enum {
+    VERIFIER_SUCCESS = 0,
+    VERIFIER_ERROR_EMPTY,            // Программа пуста
+    VERIFIER_ERROR_TRUNCATED,        // Размер не кратен размеру инструкции
+    VERIFIER_ERROR_INVALID_OPCODE,   // Неизвестный код операции
+    VERIFIER_ERROR_INVALID_REGISTER, // Номер регистра >= 16
+    VERIFIER_ERROR_MISALIGNED_TARGET, // Цель bnz не кратна 4
+    VERIFIER_ERROR_TARGET_OUT_OF_RANGE, // Цель bnz за концом программы
+    VERIFIER_ERROR_NO_READY,         // Последняя инструкция - не ready
+    VERIFIER_ERROR_NO_MEMORY,        // Не удалось выделить память
+    VERIFIER_ERROR_COUNT             // Количество кодов ошибок (всегда последний)
+} VerifierErrorCode;
+
+extern const char* VerifierErrorMessages[VERIFIER_ERROR_COUNT];
+
+// Первая найденная ошибка
+typedef struct {
+    int error;
+    uint16_t address;                // Адрес инструкции
+    uint32_t instruction;            // Машинный код инструкции
+} VerifierDiagnostic;
+
+// Предекодированная инструкция проверенной программы
+typedef struct {
+    uint8_t opcode;
+    uint8_t field0;                  // Биты 23:16
+    uint8_t field1;                  // Биты 15:8
+    uint8_t field2;                  // Биты 7:0
+    uint16_t operand;                // set_const - константа, bnz - номер инструкции цели,
+                                     // ld/st/ldm/stm - номер проверки участка + 1 (0 - проверка на месте),
+                                     // mul - 1, если старшая половина не записывается
+} DecodedInstruction;
+
+#define VERIFIER_NO_REGISTER 0xFF      // Нет регистра в базе адреса
+#define VERIFIER_NO_BLOCK 0xFFFFFFFFu  // Инструкция не начинает участок
+#define VERIFIER_MAX_BLOCK_GUARDS 32   // Проверок на участок (битовая маска)
+
+// Проверка диапазона адресов группы ld/st на входе в участок
+typedef struct {
+    uint8_t base0;                   // Регистры базы (VERIFIER_NO_REGISTER - нет)
+    uint8_t base1;
+    int32_t min_offset;              // Смещения от базы со знаком
+    int32_t max_offset;
+} AddressGuard;
+
+#define COUNTED_LOOP_MIN_TRIPS 8     // Короткие циклы выполняются обычным образом
+
+// Вид регистра в счётном цикле
+typedef enum {
+    LOOP_REGISTER_INVARIANT = 0,     // r' = r
+    LOOP_REGISTER_CONSTANT,          // r' = f(инварианты)
+    LOOP_REGISTER_INDUCTION,         // r' = r + f(инварианты)
+    LOOP_REGISTER_ACCUMULATOR        // r' = r + f(инварианты, индукции)
+} LoopRegisterKind;
+
+// Счётный цикл: r' = sum(coefficients[r][j] * RF[j]) + constants[r] (mod 2^16)
+typedef struct {
+    uint8_t counter;                 // Регистр условия bnz (индукция)
+    uint8_t kind[ISA_REGISTER_COUNT];
+    uint16_t coefficients[ISA_REGISTER_COUNT][ISA_REGISTER_COUNT];
+    uint16_t constants[ISA_REGISTER_COUNT];
+} CountedLoop;
+
+// Линейный участок проверенной программы
+typedef struct VerifiedBlock {
+    uint32_t first;                  // Первая инструкция
+    uint32_t end;                    // За последней инструкцией
+    const struct VerifiedBlock* taken; // Цель bnz в конце участка (NULL - нет)
+    const struct VerifiedBlock* next;  // Участок с инструкции end (NULL - после ready)
+
+    // Заполняется при подготовке участка
+    AddressGuard* guards;            // Проверки адресов участка
+    uint32_t guard_count;
+    CountedLoop* loop;               // Счётный цикл (NULL - нет)
+    uint16_t live_in;                // Регистры, читаемые до записи (бит r - Rr)
+    _Atomic uint8_t prepared;        // Публикуется после заполнения полей выше
+} VerifiedBlock;
+
+typedef struct VerifiedProgram {
+    uint32_t generation;             // Memory.instruction_generation на момент проверки
+    VerifierDiagnostic diagnostic;   // VERIFIER_SUCCESS - программа проверена
+    uint32_t instruction_count;
+    uint8_t* code;                   // Копия машинного кода для подготовки участков
+    DecodedInstruction* instructions; // По участкам после подготовки; NULL, если проверка не пройдена
+    uint32_t block_count;
+    VerifiedBlock* blocks;
+    uint32_t* block_index;           // Номер участка по первой инструкции (иначе VERIFIER_NO_BLOCK)
+
+    // Подготовка участков (verifier_prepare_block) под блокировкой
+    pthread_mutex_t lock;
+    int liveness_ready;              // Живость регистров вычислена для всех участков
+    uint32_t prepared_blocks;
+    uint32_t guarded_accesses;       // ld/st, проверяемых на входе в участок
+    uint32_t loop_count;
+    uint32_t eliminated_writes;      // Удалённые мёртвые записи регистров
+} VerifiedProgram;
+
+// Проверка машинного кода (Big Endian); diagnostic может быть NULL
+int verifier_check(const uint8_t* code, size_t size, VerifierDiagnostic* diagnostic);
+
+// Проверка и разбиение на участки без подготовки; при ошибке проверки
+// *program создаётся с диагностикой и без инструкций. Возвращает код проверки.
+int verifier_build(const uint8_t* code, size_t size, uint32_t generation, VerifiedProgram** program);
+void verified_program_free(VerifiedProgram* program);
+
+// Подготовка участка к предекодированному выполнению; повторный вызов для
+// подготовленного участка ничего не делает. Можно вызывать из любого потока.
+// VERIFIER_SUCCESS или VERIFIER_ERROR_NO_MEMORY (участок не подготовлен).
+int verifier_prepare_block(VerifiedProgram* program, uint32_t block);
+int verifier_prepare_all(VerifiedProgram* program);
+
+// Подготовлен ли участок: после 1 его инструкции, проверки и цикл можно читать
+static inline int verified_block_is_prepared(const VerifiedBlock* block) {
+    return atomic_load_explicit(&block->prepared, memory_order_acquire);
+}
+
+// Число итераций счётного цикла от входа с регистрами RF; 0 - цикл не
+// завершается (выполняется обычным образом)
+uint32_t counted_loop_trip_count(const CountedLoop* loop, const uint16_t* RF);
+
+// Состояние регистров после trips итераций
+void counted_loop_fast_forward(const CountedLoop* loop, uint16_t* RF, uint32_t trips);
+
+// Проверка группы адресов на входе в участок (RF - регистры на входе)
+static inline int address_guard_passes(const AddressGuard* guard, const uint16_t* RF, size_t data_size) {
+    uint16_t base = (uint16_t)((guard->base0 != VERIFIER_NO_REGISTER ? RF[guard->base0] : 0) +
+                               (guard->base1 != VERIFIER_NO_REGISTER ? RF[guard->base1] : 0));
+    int32_t low = (int32_t)base + guard->min_offset;
+    int32_t high = (int32_t)base + guard->max_offset;
+    return low >= 0 && (low & 1) == 0 && (size_t)high + 1 < data_size;
+}
+
+// Итоги подготовки: участки, проверки адресов, счётные циклы, мёртвые записи
+// (по подготовленным участкам)
+void verifier_print_summary(const VerifiedProgram* program, FILE* output);
+
+// Текст "Invalid register at 0x0010 (add R1, R2, R20)"; возвращает длину (как snprintf)
+int verifier_format_diagnostic(const VerifierDiagnostic* diagnostic, char* buffer, size_t size);
+
+#endif //VERIFIERHEADER_H
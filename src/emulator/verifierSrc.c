@@ -0,0 +1,714 @@
+#include "verifierHeader.h"
+
+// Массив строк с сообщениями об ошибках проверки
+const char* VerifierErrorMessages[VERIFIER_ERROR_COUNT] = {
+    "Success",                                  // VERIFIER_SUCCESS
+    "Empty program",                            // VERIFIER_ERROR_EMPTY
+    "Program size is not a multiple of 4",      // VERIFIER_ERROR_TRUNCATED
+    "Invalid opcode",                           // VERIFIER_ERROR_INVALID_OPCODE
+    "Invalid register",                         // VERIFIER_ERROR_INVALID_REGISTER
+    "Branch target is not aligned to 4",        // VERIFIER_ERROR_MISALIGNED_TARGET
+    "Branch target is outside the program",     // VERIFIER_ERROR_TARGET_OUT_OF_RANGE
+    "Program does not end with ready",          // VERIFIER_ERROR_NO_READY
+    "Out of memory"                             // VERIFIER_ERROR_NO_MEMORY
+};
+
+static int verifier_fail(VerifierDiagnostic* diagnostic, int error, size_t address, uint32_t instruction) {
+    if (diagnostic) {
+        diagnostic->error = error;
+        diagnostic->address = (uint16_t)address;
+        diagnostic->instruction = instruction;
+    }
+    return error;
+}
+
+// Машинное слово инструкции index (Big Endian)
+static uint32_t verifier_word(const uint8_t* code, size_t index) {
+    const uint8_t* bytes = &code[index * 4];
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+           ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+// Декодирование проверенной инструкции
+static DecodedInstruction verifier_decode(const uint8_t* code, size_t index) {
+    uint32_t instruction = verifier_word(code, index);
+    const IsaInstruction* isa = isa_lookup_opcode(instruction >> 24);
+
+    DecodedInstruction decoded;
+    decoded.opcode = (uint8_t)(instruction >> 24);
+    decoded.field0 = (uint8_t)(instruction >> 16);
+    decoded.field1 = (uint8_t)(instruction >> 8);
+    decoded.field2 = (uint8_t)instruction;
+    decoded.operand = 0;
+    if (isa->flags & ISA_FLAG_BRANCH) {
+        decoded.operand = (uint16_t)((instruction & 0xFFFF) / 4);
+    } else if (isa->operand_count > 0 && isa->operands[0].slot == ISA_SLOT_CONST16) {
+        decoded.operand = (uint16_t)((instruction >> 8) & 0xFFFF);
+    }
+    return decoded;
+}
+
+// Проход по программе без декодирования
+static int verifier_scan(const uint8_t* code, size_t size, VerifierDiagnostic* diagnostic) {
+    if (!code || size == 0) {
+        return verifier_fail(diagnostic, VERIFIER_ERROR_EMPTY, 0, 0);
+    }
+    if (size % 4 != 0) {
+        return verifier_fail(diagnostic, VERIFIER_ERROR_TRUNCATED, size & ~(size_t)3, 0);
+    }
+
+    for (size_t address = 0; address < size; address += 4) {
+        uint32_t instruction = verifier_word(code, address / 4);
+
+        const IsaInstruction* isa = isa_lookup_opcode(instruction >> 24);
+        if (!(isa->flags & ISA_FLAG_VALID)) {
+            return verifier_fail(diagnostic, VERIFIER_ERROR_INVALID_OPCODE, address, instruction);
+        }
+        if (isa_invalid_register_fields(instruction) & isa->register_fields) {
+            return verifier_fail(diagnostic, VERIFIER_ERROR_INVALID_REGISTER, address, instruction);
+        }
+
+        if (isa->flags & ISA_FLAG_BRANCH) {
+            uint16_t target = (uint16_t)(instruction & 0xFFFF);
+            if (target % 4 != 0) {
+                return verifier_fail(diagnostic, VERIFIER_ERROR_MISALIGNED_TARGET, address, instruction);
+            }
+            if (target >= size) {
+                return verifier_fail(diagnostic, VERIFIER_ERROR_TARGET_OUT_OF_RANGE, address, instruction);
+            }
+        }
+
+        // Выполнение не должно продолжаться за последней инструкцией
+        if (address + 4 == size && !(isa->flags & ISA_FLAG_HALT)) {
+            return verifier_fail(diagnostic, VERIFIER_ERROR_NO_READY, address, instruction);
+        }
+    }
+
+    return verifier_fail(diagnostic, VERIFIER_SUCCESS, 0, 0);
+}
+
+// Значение регистра внутри участка: RF[reg] на входе + offset или константа
+typedef struct {
+    uint8_t known;
+    uint8_t reg;                     // VERIFIER_NO_REGISTER - константа
+    uint16_t offset;
+} SymbolicValue;
+
+// Адрес ld/st: RF[base0] + RF[base1] на входе + offset
+typedef struct {
+    uint8_t known;
+    uint8_t base0;
+    uint8_t base1;
+    uint16_t offset;
+} SymbolicAddress;
+
+static SymbolicAddress verifier_address(SymbolicValue a, SymbolicValue b) {
+    SymbolicAddress address = {0, VERIFIER_NO_REGISTER, VERIFIER_NO_REGISTER, 0};
+    if (!a.known || !b.known) {
+        return address;
+    }
+    address.known = 1;
+    address.base0 = a.reg < b.reg ? a.reg : b.reg;
+    address.base1 = a.reg < b.reg ? b.reg : a.reg;
+    address.offset = (uint16_t)(a.offset + b.offset);
+    return address;
+}
+
+// Результат операции над значениями участка; неизвестен, если не сводится к форме
+static SymbolicValue verifier_combine(uint8_t opcode, SymbolicValue a, SymbolicValue b) {
+    SymbolicValue result = {0, VERIFIER_NO_REGISTER, 0};
+    if (!a.known || !b.known) {
+        return result;
+    }
+    if (opcode == OPC_ADD && (a.reg == VERIFIER_NO_REGISTER || b.reg == VERIFIER_NO_REGISTER)) {
+        result.known = 1;
+        result.reg = a.reg == VERIFIER_NO_REGISTER ? b.reg : a.reg;
+        result.offset = (uint16_t)(a.offset + b.offset);
+    } else if (opcode == OPC_SUB && b.reg == VERIFIER_NO_REGISTER) {
+        result = a;
+        result.offset = (uint16_t)(a.offset - b.offset);
+    }
+    return result;
+}
+
+// Проверки адресов одного участка; instructions[i].operand для ld/st
+// получает номер проверки + 1
+static int verifier_block_guards(VerifiedProgram* program, VerifiedBlock* block) {
+    SymbolicValue values[ISA_REGISTER_COUNT];
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        values[r].known = 1;
+        values[r].reg = (uint8_t)r;
+        values[r].offset = 0;
+    }
+
+    AddressGuard guards[VERIFIER_MAX_BLOCK_GUARDS];
+    uint32_t guard_count = 0;
+    uint32_t guarded_accesses = 0;
+
+    for (uint32_t i = block->first; i < block->end; i++) {
+        DecodedInstruction* in = &program->instructions[i];
+        const IsaInstruction* isa = isa_lookup_opcode(in->opcode);
+
+        if (isa->flags & (ISA_FLAG_READS_MEMORY | ISA_FLAG_WRITES_MEMORY)) {
+            SymbolicAddress address = in->opcode == OPC_ST
+                                    ? verifier_address(values[in->field1], values[in->field2])
+                                    : verifier_address(values[in->field0], values[in->field1]);
+            // ldm/stm обращаются к словам offset .. offset + 2 * (ISA_GROUP_SIZE - 1)
+            int32_t span = (isa->flags & ISA_FLAG_GROUP) ? 2 * (ISA_GROUP_SIZE - 1) : 0;
+            in->operand = 0;
+            if (address.known) {
+                int32_t offset = (int16_t)address.offset;
+                uint32_t g = 0;
+                AddressGuard* guard = NULL;
+                for (; g < guard_count; g++) {
+                    guard = &guards[g];
+                    if (guard->base0 == address.base0 && guard->base1 == address.base1 &&
+                        ((guard->min_offset ^ offset) & 1) == 0) {
+                        break;
+                    }
+                }
+                if (g == guard_count && g < VERIFIER_MAX_BLOCK_GUARDS) {
+                    guard = &guards[guard_count++];
+                    guard->base0 = address.base0;
+                    guard->base1 = address.base1;
+                    guard->min_offset = offset;
+                    guard->max_offset = offset + span;
+                }
+                if (g < guard_count) {
+                    if (offset < guard->min_offset) {
+                        guard->min_offset = offset;
+                    }
+                    if (offset + span > guard->max_offset) {
+                        guard->max_offset = offset + span;
+                    }
+                    in->operand = (uint16_t)(g + 1);
+                    guarded_accesses++;
+                }
+            }
+        }
+
+        if (!(isa->flags & ISA_FLAG_WRITES_DST)) {
+            continue;
+        }
+
+        SymbolicValue result = {0, VERIFIER_NO_REGISTER, 0};
+        if (in->opcode == OPC_SET_CONST) {
+            result.known = 1;
+            result.offset = in->operand;
+        } else if (in->opcode == OPC_ADD || in->opcode == OPC_SUB) {
+            result = verifier_combine(in->opcode, values[in->field0], values[in->field1]);
+        }
+        values[in->field2] = result;
+        if (isa->flags & ISA_FLAG_WRITES_PAIR) {
+            values[(in->field2 + 1) & 0x0F].known = 0;
+        }
+        if (isa->flags & ISA_FLAG_GROUP) {
+            for (int k = 1; k < ISA_GROUP_SIZE; k++) {
+                values[(in->field2 + k) & 0x0F].known = 0;
+            }
+        }
+    }
+
+    block->guards = NULL;
+    block->guard_count = guard_count;
+    if (guard_count > 0) {
+        block->guards = (AddressGuard*)malloc(guard_count * sizeof(AddressGuard));
+        if (!block->guards) {
+            return VERIFIER_ERROR_NO_MEMORY;
+        }
+        memcpy(block->guards, guards, guard_count * sizeof(AddressGuard));
+    }
+    program->guarded_accesses += guarded_accesses;
+    return VERIFIER_SUCCESS;
+}
+
+// Счётный цикл участка, который заканчивается bnz на своё начало;
+// 0 - участок не подходит (см. verifierHeader.h)
+static int verifier_counted_loop(const VerifiedProgram* program, const VerifiedBlock* block, CountedLoop* loop) {
+    const DecodedInstruction* last = &program->instructions[block->end - 1];
+    if (last->opcode != OPC_BNZ || last->operand != block->first) {
+        return 0;
+    }
+
+    memset(loop, 0, sizeof(*loop));
+    loop->counter = last->field0;
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        loop->coefficients[r][r] = 1;
+    }
+
+    // Линейная форма каждого регистра после итерации
+    for (uint32_t i = block->first; i + 1 < block->end; i++) {
+        const DecodedInstruction* in = &program->instructions[i];
+        uint16_t row[ISA_REGISTER_COUNT];
+        uint16_t constant;
+
+        switch (in->opcode) {
+            case OPC_NOP:
+                continue;
+
+            case OPC_SET_CONST:
+                memset(row, 0, sizeof(row));
+                constant = in->operand;
+                break;
+
+            case OPC_ADD:
+            case OPC_SUB:
+                {
+                    uint16_t sign = in->opcode == OPC_ADD ? 1 : 0xFFFF;
+                    for (int j = 0; j < ISA_REGISTER_COUNT; j++) {
+                        row[j] = (uint16_t)(loop->coefficients[in->field0][j] +
+                                            sign * loop->coefficients[in->field1][j]);
+                    }
+                    constant = (uint16_t)(loop->constants[in->field0] + sign * loop->constants[in->field1]);
+                }
+                break;
+
+            default:
+                return 0;
+        }
+
+        memcpy(loop->coefficients[in->field2], row, sizeof(row));
+        loop->constants[in->field2] = constant;
+    }
+
+    // Инварианты: форма совпадает с самим регистром
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        int identity = loop->constants[r] == 0;
+        for (int j = 0; j < ISA_REGISTER_COUNT && identity; j++) {
+            identity = loop->coefficients[r][j] == (j == r);
+        }
+        loop->kind[r] = identity ? LOOP_REGISTER_INVARIANT : LOOP_REGISTER_ACCUMULATOR;
+    }
+
+    // Константы и индукции ссылаются только на инварианты, накопители - ещё на индукции
+    for (int pass = 0; pass < 2; pass++) {
+        for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+            if (loop->kind[r] == LOOP_REGISTER_INVARIANT || (pass == 1 && loop->kind[r] != LOOP_REGISTER_ACCUMULATOR)) {
+                continue;
+            }
+            if (loop->coefficients[r][r] > 1) {
+                return 0;
+            }
+
+            int references_induction = 0;
+            for (int j = 0; j < ISA_REGISTER_COUNT; j++) {
+                if (j == r || loop->coefficients[r][j] == 0 || loop->kind[j] == LOOP_REGISTER_INVARIANT) {
+                    continue;
+                }
+                if (pass == 1 && loop->kind[j] == LOOP_REGISTER_INDUCTION) {
+                    references_induction = 1;
+                    continue;
+                }
+                references_induction = -1;
+                break;
+            }
+
+            if (pass == 0 && references_induction == 0) {
+                loop->kind[r] = loop->coefficients[r][r] ? LOOP_REGISTER_INDUCTION : LOOP_REGISTER_CONSTANT;
+            } else if (pass == 1 && (references_induction != 1 || loop->coefficients[r][r] != 1)) {
+                return 0;
+            }
+        }
+    }
+
+    return loop->kind[loop->counter] == LOOP_REGISTER_INDUCTION;
+}
+
+#define VERIFIER_ALL_REGISTERS 0xFFFFu
+
+// Регистры, которые инструкция читает (uses) и пишет (defs); 1 - после
+// инструкции выполнение может остановиться, и все регистры видны
+static int verifier_register_effects(const DecodedInstruction* in, uint16_t* uses, uint16_t* defs) {
+    const IsaInstruction* isa = isa_lookup_opcode(in->opcode);
+
+    *uses = 0;
+    *defs = 0;
+    if (isa->read_fields & ISA_FIELD_0) {
+        *uses |= (uint16_t)(1u << in->field0);
+    }
+    if (isa->read_fields & ISA_FIELD_1) {
+        *uses |= (uint16_t)(1u << in->field1);
+    }
+    if (isa->read_fields & ISA_FIELD_2) {
+        *uses |= isa_field2_registers(isa, in->field2);
+    }
+    if (isa->flags & ISA_FLAG_WRITES_DST) {
+        *defs |= isa_field2_registers(isa, in->field2);
+    }
+    if ((isa->flags & ISA_FLAG_WRITES_PAIR) && !(in->opcode == OPC_MUL && in->operand)) {
+        *defs |= (uint16_t)(1u << ((in->field2 + 1) & 0x0F));
+    }
+
+    // Ошибки адреса и деления останавливают выполнение так же, как ready
+    return (isa->flags & (ISA_FLAG_READS_MEMORY | ISA_FLAG_WRITES_MEMORY | ISA_FLAG_HALT)) ||
+           in->opcode == OPC_DIV;
+}
+
+// Живые регистры перед инструкцией по живым после неё
+static uint16_t verifier_live_before(const DecodedInstruction* in, uint16_t live) {
+    uint16_t uses, defs;
+    if (verifier_register_effects(in, &uses, &defs)) {
+        return VERIFIER_ALL_REGISTERS;
+    }
+    return (uint16_t)((live & ~defs) | uses);
+}
+
+static uint16_t verifier_live_out(const VerifiedBlock* block) {
+    return (uint16_t)((block->taken ? block->taken->live_in : 0) |
+                      (block->next ? block->next->live_in : 0));
+}
+
+// Обратный анализ живости регистров всей программы по исходным инструкциям
+static void verifier_compute_liveness(VerifiedProgram* program) {
+    // Наименьшая неподвижная точка: участки в обратном порядке, пока меняется live_in
+    for (uint32_t b = 0; b < program->block_count; b++) {
+        program->blocks[b].live_in = 0;
+    }
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (uint32_t b = program->block_count; b-- > 0;) {
+            VerifiedBlock* block = &program->blocks[b];
+            uint16_t live = verifier_live_out(block);
+            for (uint32_t i = block->end; i-- > block->first;) {
+                DecodedInstruction in = verifier_decode(program->code, i);
+                live = verifier_live_before(&in, live);
+            }
+            if (live != block->live_in) {
+                block->live_in = live;
+                changed = 1;
+            }
+        }
+    }
+    program->liveness_ready = 1;
+}
+
+// Инструкции участка без побочных эффектов, чей результат не читается, удаляются
+static void verifier_eliminate_dead_writes(VerifiedProgram* program, const VerifiedBlock* block) {
+    uint16_t live = verifier_live_out(block);
+    for (uint32_t i = block->end; i-- > block->first;) {
+        DecodedInstruction* in = &program->instructions[i];
+        uint16_t uses, defs;
+        if (!verifier_register_effects(in, &uses, &defs) && defs) {
+            uint16_t high = (uint16_t)(1u << ((in->field2 + 1) & 0x0F));
+            if (!(defs & live)) {
+                memset(in, 0, sizeof(*in));
+                in->opcode = OPC_NOP;
+                program->eliminated_writes++;
+            } else if (in->opcode == OPC_MUL && (defs & high) && !(live & high)) {
+                in->operand = 1;
+                program->eliminated_writes++;
+            }
+        }
+        live = verifier_live_before(in, live);
+    }
+}
+
+// Разбиение на линейные участки и связывание преемников
+static int verifier_build_blocks(VerifiedProgram* program) {
+    uint32_t count = program->instruction_count;
+
+    program->block_index = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!program->block_index) {
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+
+    // Начала участков: вход, цели переходов и инструкции после bnz/ready
+    for (uint32_t i = 0; i < count; i++) {
+        program->block_index[i] = VERIFIER_NO_BLOCK;
+    }
+    program->block_index[0] = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t instruction = verifier_word(program->code, i);
+        uint8_t opcode = (uint8_t)(instruction >> 24);
+        if (opcode == OPC_BNZ || opcode == OPC_READY) {
+            if (opcode == OPC_BNZ) {
+                program->block_index[(instruction & 0xFFFF) / 4] = 0;
+            }
+            if (i + 1 < count) {
+                program->block_index[i + 1] = 0;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (program->block_index[i] != VERIFIER_NO_BLOCK) {
+            program->block_index[i] = program->block_count++;
+        }
+    }
+
+    program->blocks = (VerifiedBlock*)calloc(program->block_count, sizeof(VerifiedBlock));
+    if (!program->blocks) {
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+
+    uint32_t b = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (program->block_index[i] == VERIFIER_NO_BLOCK) {
+            continue;
+        }
+        VerifiedBlock* block = &program->blocks[b++];
+        block->first = i;
+        block->end = i + 1;
+        while (block->end < count && program->block_index[block->end] == VERIFIER_NO_BLOCK) {
+            block->end++;
+        }
+    }
+
+    // Преемники участков: цель bnz и проваливание
+    for (b = 0; b < program->block_count; b++) {
+        VerifiedBlock* block = &program->blocks[b];
+        DecodedInstruction last = verifier_decode(program->code, block->end - 1);
+        block->taken = last.opcode == OPC_BNZ
+                     ? &program->blocks[program->block_index[last.operand]] : NULL;
+        block->next = last.opcode != OPC_READY && block->end < count
+                    ? &program->blocks[program->block_index[block->end]] : NULL;
+    }
+
+    return VERIFIER_SUCCESS;
+}
+
+// Подготовка участка под блокировкой программы
+static int verifier_prepare_locked(VerifiedProgram* program, VerifiedBlock* block) {
+    if (atomic_load_explicit(&block->prepared, memory_order_relaxed)) {
+        return VERIFIER_SUCCESS;
+    }
+    if (!program->liveness_ready) {
+        verifier_compute_liveness(program);
+    }
+
+    for (uint32_t i = block->first; i < block->end; i++) {
+        program->instructions[i] = verifier_decode(program->code, i);
+    }
+
+    int result = verifier_block_guards(program, block);
+    if (result != VERIFIER_SUCCESS) {
+        return result;
+    }
+
+    CountedLoop loop;
+    if (verifier_counted_loop(program, block, &loop)) {
+        block->loop = (CountedLoop*)malloc(sizeof(CountedLoop));
+        if (!block->loop) {
+            free(block->guards);
+            block->guards = NULL;
+            return VERIFIER_ERROR_NO_MEMORY;
+        }
+        *block->loop = loop;
+        program->loop_count++;
+    }
+
+    // После проверок адресов и счётного цикла: им нужны исходные инструкции
+    verifier_eliminate_dead_writes(program, block);
+
+    program->prepared_blocks++;
+    atomic_store_explicit(&block->prepared, 1, memory_order_release);
+    return VERIFIER_SUCCESS;
+}
+
+int verifier_prepare_block(VerifiedProgram* program, uint32_t block) {
+    if (!program || !program->instructions || block >= program->block_count) {
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+    if (verified_block_is_prepared(&program->blocks[block])) {
+        return VERIFIER_SUCCESS;
+    }
+
+    pthread_mutex_lock(&program->lock);
+    int result = verifier_prepare_locked(program, &program->blocks[block]);
+    pthread_mutex_unlock(&program->lock);
+    return result;
+}
+
+int verifier_prepare_all(VerifiedProgram* program) {
+    if (!program || !program->instructions) {
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+
+    pthread_mutex_lock(&program->lock);
+    int result = VERIFIER_SUCCESS;
+    for (uint32_t b = 0; b < program->block_count && program->prepared_blocks < program->block_count; b++) {
+        result = verifier_prepare_locked(program, &program->blocks[b]);
+        if (result != VERIFIER_SUCCESS) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&program->lock);
+    return result;
+}
+
+// Шаг r' - r при значениях регистров на входе в итерацию
+static uint32_t counted_loop_step(const CountedLoop* loop, int r, const uint16_t* RF) {
+    uint32_t step = loop->constants[r];
+    for (int j = 0; j < ISA_REGISTER_COUNT; j++) {
+        if (j != r) {
+            step += (uint32_t)loop->coefficients[r][j] * RF[j];
+        }
+    }
+    return step & 0xFFFF;
+}
+
+uint32_t counted_loop_trip_count(const CountedLoop* loop, const uint16_t* RF) {
+    uint32_t value = RF[loop->counter];
+    uint32_t step = counted_loop_step(loop, loop->counter, RF);
+
+    // Первое n >= 1 с value + n * step = 0 (mod 2^16)
+    if (step == 0) {
+        return value == 0 ? 1 : 0;
+    }
+
+    uint32_t power = step & (0u - step);          // 2^k, младший единичный бит шага
+    uint32_t need = (0x10000 - value) & 0xFFFF;
+    if (need % power != 0) {
+        return 0;
+    }
+
+    // n = need / 2^k * (step / 2^k)^-1 (mod 2^16 / 2^k)
+    uint32_t modulus = 0x10000 / power;
+    uint32_t odd = step / power;
+    uint32_t inverse = odd;
+    for (int i = 0; i < 4; i++) {
+        inverse *= 2 - odd * inverse;
+    }
+    uint32_t trips = ((need / power) * inverse) & (modulus - 1);
+    return trips ? trips : modulus;
+}
+
+void counted_loop_fast_forward(const CountedLoop* loop, uint16_t* RF, uint32_t trips) {
+    uint16_t entry[ISA_REGISTER_COUNT];
+    uint32_t steps[ISA_REGISTER_COUNT];
+    memcpy(entry, RF, sizeof(entry));
+
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        steps[r] = loop->kind[r] == LOOP_REGISTER_INDUCTION ? counted_loop_step(loop, r, entry) : 0;
+    }
+
+    // Сумма номеров итераций 0..trips-1 для вклада индукций в накопители
+    uint32_t triangle = (uint32_t)((uint64_t)trips * (trips - 1) / 2);
+
+    for (int r = 0; r < ISA_REGISTER_COUNT; r++) {
+        switch (loop->kind[r]) {
+            case LOOP_REGISTER_CONSTANT:
+                RF[r] = (uint16_t)counted_loop_step(loop, r, entry);
+                break;
+
+            case LOOP_REGISTER_INDUCTION:
+                RF[r] = (uint16_t)(entry[r] + trips * steps[r]);
+                break;
+
+            case LOOP_REGISTER_ACCUMULATOR:
+                {
+                    uint32_t slope = 0;
+                    for (int j = 0; j < ISA_REGISTER_COUNT; j++) {
+                        slope += (uint32_t)loop->coefficients[r][j] * steps[j];
+                    }
+                    RF[r] = (uint16_t)(entry[r] + trips * counted_loop_step(loop, r, entry) +
+                                       triangle * slope);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+int verifier_check(const uint8_t* code, size_t size, VerifierDiagnostic* diagnostic) {
+    return verifier_scan(code, size, diagnostic);
+}
+
+int verifier_build(const uint8_t* code, size_t size, uint32_t generation, VerifiedProgram** program) {
+    if (!program) {
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+
+    VerifiedProgram* verified = (VerifiedProgram*)calloc(1, sizeof(VerifiedProgram));
+    if (!verified) {
+        *program = NULL;
+        return VERIFIER_ERROR_NO_MEMORY;
+    }
+    verified->generation = generation;
+    pthread_mutex_init(&verified->lock, NULL);
+
+    int result = verifier_scan(code, size, &verified->diagnostic);
+    if (result == VERIFIER_SUCCESS) {
+        // Копия кода: память инструкций может смениться, пока участки готовятся в другом потоке
+        verified->instruction_count = (uint32_t)(size / 4);
+        verified->code = (uint8_t*)malloc(size);
+        verified->instructions = (DecodedInstruction*)calloc(verified->instruction_count,
+                                                             sizeof(DecodedInstruction));
+        if (!verified->code || !verified->instructions) {
+            verified_program_free(verified);
+            *program = NULL;
+            return VERIFIER_ERROR_NO_MEMORY;
+        }
+        memcpy(verified->code, code, size);
+
+        if (verifier_build_blocks(verified) != VERIFIER_SUCCESS) {
+            verified_program_free(verified);
+            *program = NULL;
+            return VERIFIER_ERROR_NO_MEMORY;
+        }
+    }
+
+    *program = verified;
+    return result;
+}
+
+void verified_program_free(VerifiedProgram* program) {
+    if (!program) {
+        return;
+    }
+    if (program->blocks) {
+        for (uint32_t b = 0; b < program->block_count; b++) {
+            free(program->blocks[b].guards);
+            free(program->blocks[b].loop);
+        }
+    }
+    pthread_mutex_destroy(&program->lock);
+    free(program->code);
+    free(program->instructions);
+    free(program->blocks);
+    free(program->block_index);
+    free(program);
+}
+
+void verifier_print_summary(const VerifiedProgram* program, FILE* output) {
+    if (!program) {
+        return;
+    }
+
+    FILE* out = output ? output : stdout;
+
+    if (!program->instructions) {
+        fprintf(out, "Verification: not verified\n");
+        return;
+    }
+    fprintf(out, "Verification: %u instructions, %u blocks (%u prepared), %u guarded ld/st, "
+            "%u counted loops, %u dead writes eliminated\n",
+            program->instruction_count, program->block_count, program->prepared_blocks,
+            program->guarded_accesses, program->loop_count, program->eliminated_writes);
+}
+
+int verifier_format_diagnostic(const VerifierDiagnostic* diagnostic, char* buffer, size_t size) {
+    if (!diagnostic || !buffer || size == 0) {
+        return -1;
+    }
+
+    const char* message = diagnostic->error >= 0 && diagnostic->error < VERIFIER_ERROR_COUNT
+                        ? VerifierErrorMessages[diagnostic->error] : "Unknown error";
+
+    if (diagnostic->error == VERIFIER_SUCCESS || diagnostic->error == VERIFIER_ERROR_EMPTY ||
+        diagnostic->error == VERIFIER_ERROR_NO_MEMORY) {
+        return snprintf(buffer, size, "%s", message);
+    }
+    if (diagnostic->error == VERIFIER_ERROR_TRUNCATED) {
+        return snprintf(buffer, size, "%s at 0x%04X", message, diagnostic->address);
+    }
+
+    char text[32];
+    if (isa_disassemble(diagnostic->instruction, text, sizeof(text)) < 0) {
+        snprintf(text, sizeof(text), ".word 0x%08X", diagnostic->instruction);
+    }
+    return snprintf(buffer, size, "%s at 0x%04X (%s)", message, diagnostic->address, text);
+}
@@ -0,0 +1,36 @@
+; Метки после удаляемых инструкций: оптимизирующий проход (peepholeHeader.h)
+; удаляет nop, повторные set_const и взаимно уничтожающиеся пары, после чего
+; адреса меток loop и skip сдвигаются. Без оптимизации тест проверяет ту же
+; программу как есть. Результат: R3 = 15 (5 + 4 + 3 + 2 + 1), R10 = 60
+set_const 5, R1
+set_const 1, R2
+set_const 0, R3
+nop
+set_const 0, R3
+loop:
+nop
+add R3, R1, R3
+add R4, R2, R4
+sub R4, R2, R4
+sub R1, R2, R1
+bnz loop, R1
+nop
+bnz skip, R2
+nop
+set_const 99, R3
+skip:
+nop
+set_const 4, R9
+mul R3, R9, R10
+set_const 0, R11
+set_const 15, R7
+sub R3, R7, R8
+bnz fail, R8
+set_const 60, R7
+sub R10, R7, R8
+bnz fail, R8
+ready
+fail:
+set_const 65535, R5
+ld R5, R0, R6
+ready
@@ -0,0 +1,39 @@
+; Обращения к последним словам памяти данных (4KB): проверки границ ld/st
+; выносятся в начало участка, участки с обращением ровно к 4094 должны
+; выполняться без ошибки. Результат: R5 = 55, R11 = 19, R8 = 1
+set_const 4094, R1
+set_const 2, R2
+set_const 10, R3
+set_const 1, R4
+set_const 0, R5
+loop:
+st R3, R1, R0
+ld R1, R0, R6
+add R5, R6, R5
+sub R1, R2, R1
+sub R3, R4, R3
+bnz loop, R3
+; Два слова одного участка: 4092 (= 9) и 4094 (= 10)
+set_const 4092, R9
+set_const 2, R10
+ld R9, R0, R11
+ld R9, R10, R12
+add R11, R12, R11
+; Невыровненное слово в байтах 4093-4094
+set_const 4093, R7
+st R4, R7, R0
+ld R7, R0, R8
+set_const 55, R13
+sub R5, R13, R14
+bnz fail, R14
+set_const 19, R13
+sub R11, R13, R14
+bnz fail, R14
+set_const 1, R13
+sub R8, R13, R14
+bnz fail, R14
+ready
+fail:
+set_const 65535, R15
+ld R15, R0, R15
+ready
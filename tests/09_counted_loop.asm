@@ -0,0 +1,53 @@
+; Счётные циклы без обращений к памяти выполняются за один шаг (перемотка
+; по числу итераций). Внутренний цикл: 1000 итераций, R2 - индукция, R3 -
+; накопитель, R4 - константа; внешний цикл повторяет его 3 раза. Отдельный
+; цикл со счётчиком, уходящим через 0 с шагом 2: 32768 итераций.
+; Результат: R2 = 3000, R3 = 59708, R4 = 12, R6 = 9000, R12 = 32768
+set_const 3, R10
+set_const 1, R11
+set_const 0, R6
+outer:
+set_const 1000, R1
+set_const 0, R2
+set_const 0, R3
+set_const 5, R5
+inner:
+set_const 3, R7
+add R2, R7, R2
+add R3, R2, R3
+add R5, R7, R4
+add R4, R7, R4
+add R4, R11, R4
+sub R1, R11, R1
+bnz inner, R1
+add R6, R2, R6
+sub R10, R11, R10
+bnz outer, R10
+; Счётчик 0, 65534, ..., 2: цикл завершается через 32768 итераций
+set_const 0, R8
+set_const 2, R9
+set_const 0, R12
+wrap:
+sub R8, R9, R8
+add R12, R11, R12
+bnz wrap, R8
+set_const 3000, R13
+sub R2, R13, R14
+bnz fail, R14
+set_const 59708, R13
+sub R3, R13, R14
+bnz fail, R14
+set_const 12, R13
+sub R4, R13, R14
+bnz fail, R14
+set_const 9000, R13
+sub R6, R13, R14
+bnz fail, R14
+set_const 32768, R13
+sub R12, R13, R14
+bnz fail, R14
+ready
+fail:
+set_const 65535, R15
+ld R15, R0, R15
+ready
@@ -0,0 +1,52 @@
+; Удаление мёртвых записей и переходы между связанными участками: записи,
+; перезаписанные до чтения, удаляются, а регистр, читаемый только на одном
+; из путей, и старшая половина mul, читаемая после цикла, сохраняются.
+; Результат: R11 = 117, R4 = 53248, R5 = 2, R7 = 16
+set_const 1, R2
+set_const 0x3000, R3
+set_const 0, R11
+set_const 2, R12
+outer:
+set_const 5, R1
+set_const 0, R9
+inner:
+add R9, R1, R9
+; R4 - младшая, R5 - старшая половина (читается после циклов)
+mul R9, R3, R4
+; Мёртвые записи: R8 перезаписывается после цикла, R7 - следующей инструкцией
+xor R9, R1, R8
+set_const 77, R7
+add R9, R2, R7
+; R6 читается только на пути path_b
+add R7, R2, R6
+sub R1, R2, R1
+bnz inner, R1
+set_const 3, R8
+and R12, R2, R13
+bnz path_b, R13
+set_const 100, R6
+path_b:
+add R11, R6, R11
+sub R12, R2, R12
+bnz outer, R12
+; R11 = 100 + 17, R9 = 15, 15 * 0x3000 = 0x2D000
+set_const 117, R13
+sub R11, R13, R14
+bnz fail, R14
+set_const 53248, R13
+sub R4, R13, R14
+bnz fail, R14
+set_const 2, R13
+sub R5, R13, R14
+bnz fail, R14
+set_const 16, R13
+sub R7, R13, R14
+bnz fail, R14
+set_const 3, R13
+sub R8, R13, R14
+bnz fail, R14
+ready
+fail:
+set_const 65535, R15
+ld R15, R0, R15
+ready
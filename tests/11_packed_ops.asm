@@ -0,0 +1,54 @@
+; Упакованные операции над байтовыми дорожками (addsb, subsb, cmpgeb, minb,
+; maxb) на границах 0x00 и 0xFF: насыщение сверху и снизу в каждой дорожке
+; отдельно, сравнение равных дорожек. Результат: R7 = 0x0000, R8 = 0xFFFF,
+; R9 = 0x0201, R10 = 0x01FE, R11 = 0xFF00, R12 = 0xFFFF
+set_const 0xFF00, R1
+set_const 0x00FF, R2
+set_const 0xFF01, R3
+set_const 0x0101, R4
+set_const 0x01FE, R5
+set_const 0x02FF, R6
+; 0xFF + 0x00, 0x00 + 0xFF; 0xFF + 0x01 насыщается, 0x01 + 0x01
+addsb R1, R2, R7
+addsb R3, R4, R8
+; 0x00 - 0x01 насыщается, 0xFF - 0xFE; 0xFF - 0x00, 0x00 - 0xFF насыщается
+subsb R2, R5, R9
+subsb R1, R2, R10
+cmpgeb R1, R2, R11
+cmpgeb R0, R0, R12
+set_const 0xFFFF, R13
+sub R7, R13, R14
+bnz fail, R14
+set_const 0xFF02, R13
+sub R8, R13, R14
+bnz fail, R14
+set_const 0x0001, R13
+sub R9, R13, R14
+bnz fail, R14
+set_const 0xFF00, R13
+sub R10, R13, R14
+bnz fail, R14
+sub R11, R13, R14
+bnz fail, R14
+set_const 0xFFFF, R13
+sub R12, R13, R14
+bnz fail, R14
+; Дорожки min/max выбираются независимо
+minb R1, R2, R7
+maxb R1, R2, R8
+minb R3, R6, R9
+maxb R4, R5, R10
+bnz fail, R7
+sub R8, R13, R14
+bnz fail, R14
+set_const 0x0201, R13
+sub R9, R13, R14
+bnz fail, R14
+set_const 0x01FE, R13
+sub R10, R13, R14
+bnz fail, R14
+ready
+fail:
+set_const 65535, R15
+ld R15, R0, R15
+ready
@@ -0,0 +1,41 @@
+; Групповые обращения ldm/stm к последним 8 байтам памяти данных (4088-4095)
+; с переходом номера регистра группы через R15 (R14, R15, R0, R1) и
+; невыровненная запись группы, последний байт которой - 4094.
+; Результат: R14 = 0x1111, R15 = 0x2222, R0 = 0, R1 = 0x4321, R8 = 0x4321, R9 = 0x4343
+set_const 4088, R2
+set_const 0x1111, R14
+set_const 0x2222, R15
+set_const 0x4321, R1
+; Слова 4088, 4090, 4092 (R0 = 0), 4094
+stm R2, R0, R14
+set_const 0, R14
+set_const 0, R15
+set_const 0, R1
+ldm R2, R0, R5
+ldm R2, R0, R14
+set_const 0x1111, R13
+sub R14, R13, R12
+bnz fail, R12
+set_const 0x2222, R13
+sub R15, R13, R12
+bnz fail, R12
+bnz fail, R0
+set_const 0x4321, R13
+sub R1, R13, R12
+bnz fail, R12
+sub R8, R13, R12
+bnz fail, R12
+; Невыровненная группа в байтах 4087-4094: байт 4094 - старший байт R8,
+; байт 4095 остаётся от первой записи
+set_const 4087, R3
+stm R3, R0, R5
+set_const 6, R4
+ld R2, R4, R9
+set_const 0x4343, R13
+sub R9, R13, R12
+bnz fail, R12
+ready
+fail:
+set_const 65535, R15
+ld R15, R0, R15
+ready
@@ -0,0 +1,52 @@
+#!/bin/bash
+# Генерация большого исходного текста (> 2 * PARALLEL_PARSER_MIN_CHUNK_SIZE) для
+# проверки параллельного разбора: на многоядерной машине ассемблер делит текст
+# на фрагменты, а переходы между сегментами ссылаются на метки других фрагментов.
+# Объём набирается комментариями: программа укладывается в 256 инструкций.
+# Каждый сегмент k прибавляет к R1 значение 2^k и переходит к следующему
+# сегменту в порядке 7, 3, 5, 1, 6, 2, 4, 0; в конце R1 должен быть равен 255.
+
+ORDER=(7 3 5 1 6 2 4 0)
+PADDING_LINES=900
+
+# Строка-заполнитель комментария
+FILLER=$(printf '%0.s-' {1..100})
+PADDING=$(for ((i = 0; i < PADDING_LINES; i++)); do echo "; ${FILLER}"; done)
+
+next_segment() {
+    local k=$1
+    for ((i = 0; i < ${#ORDER[@]}; i++)); do
+        if [ "${ORDER[$i]}" -eq "$k" ]; then
+            if [ $((i + 1)) -lt ${#ORDER[@]} ]; then
+                echo "seg${ORDER[$((i + 1))]}"
+            else
+                echo "finish"
+            fi
+            return
+        fi
+    done
+}
+
+echo "; Сгенерировано generate_parallel_parse_test.sh"
+echo "set_const 1, R14"
+echo "set_const 0, R1"
+echo "bnz seg${ORDER[0]}, R14"
+
+for k in 0 1 2 3 4 5 6 7; do
+    echo "$PADDING"
+    echo "seg${k}:"
+    echo "set_const $((1 << k)), R2"
+    echo "add R1, R2, R1"
+    echo "bnz $(next_segment $k), R14"
+done
+
+echo "$PADDING"
+echo "finish:"
+echo "set_const 255, R3"
+echo "sub R1, R3, R4"
+echo "bnz fail, R4"
+echo "ready"
+echo "fail:"
+echo "set_const 65535, R5"
+echo "ld R5, R0, R6"
+echo "ready"
@@ -13,6 +13,9 @@ if [ ! -f ../assembler ] || [ ! -f ../emulator ]; then
     exit 1
 fi
 
+# Дополнительные проверки отдельных тестов
+source ./test_checks.sh
+
 echo -e "${YELLOW}Компиляция и запуск всех тестов CPU эмулятора с выводом регистров${NC}"
 echo "======================================================="
 
@@ -59,6 +62,11 @@ run_test() {
         cat "$LOG_FILE"
         rm "$LOG_FILE"
         return 1
+    elif ! CHECK_MESSAGE=$(run_test_checks "$test_name"); then
+        echo -e "${RED}ОШИБКА: ${CHECK_MESSAGE}${NC}"
+        cat "$LOG_FILE"
+        rm "$LOG_FILE"
+        return 1
     else
         echo -e "${GREEN}УСПЕХ${NC}"
         
@@ -78,6 +86,10 @@ run_test() {
     return 0
 }
 
+# Большой исходный текст для проверки параллельного разбора (удаляется после прогона)
+GENERATED_TEST="06_parallel_parse.asm"
+./generate_parallel_parse_test.sh > "$GENERATED_TEST"
+
 # Поиск всех тестов
 TEST_FILES=$(ls *.asm)
 TOTAL_TESTS=$(echo "$TEST_FILES" | wc -l)
@@ -110,4 +122,6 @@ else
     echo "Проверьте логи и устраните ошибки в непройденных тестах."
 fi
 
+rm -f "$GENERATED_TEST"
+
 exit 0
\ No newline at end of file
@@ -0,0 +1,92 @@
+#!/bin/bash
+# Дополнительные проверки отдельных тестов (подключается из test_all.sh и
+# test_all_with_registers.sh). Самопроверка теста не видит то, что зависит
+# от сборки и от эмулятора: число инструкций, итоги проверки при загрузке.
+# Проверка выводит причину ошибки и возвращает 1.
+
+# Значение регистра из вывода эмулятора: register_value <лог> R3 -> 0x000F
+register_value() {
+    grep -m1 "^$2 = " "$1" | sed 's/^.* = //'
+}
+
+# Сравнение регистров из лога с ожидаемыми: expect_registers <лог> R3=0x000F ...
+expect_registers() {
+    local log_file="$1"
+    shift
+    for expected in "$@"; do
+        local name="${expected%%=*}"
+        local value=$(register_value "$log_file" "$name")
+        if [ "$value" != "${expected#*=}" ]; then
+            echo "$name = ${value:-?}, ожидалось ${expected#*=}"
+            return 1
+        fi
+    done
+    return 0
+}
+
+# Строка в выводе эмулятора: expect_emulator_output <строка> <флаги и файл .bin>
+expect_emulator_output() {
+    local expected="$1"
+    shift
+    local output
+    output=$(timeout 5s ../emulator "$@" 2>&1)
+    if ! grep -qF "$expected" <<< "$output"; then
+        echo "в выводе ../emulator $* нет строки \"$expected\""
+        return 1
+    fi
+    return 0
+}
+
+# 07: после оптимизирующего прохода (-O) те же R3 и R10 и меньше инструкций
+check_peephole_labels() {
+    local asm_file="$1"
+    local bin_file="$2"
+    local optimized_file="${bin_file%.bin}_optimized.bin"
+    local log_file=$(mktemp)
+    local status=1
+
+    if ! ../assembler -O "$asm_file" "$optimized_file" > /dev/null; then
+        echo "не удалось собрать $asm_file с -O"
+    else
+        timeout 5s ../emulator -v "$optimized_file" > "$log_file" 2>&1
+        local exit_code=$?
+        # Инструкция занимает 4 байта
+        local plain=$(( $(wc -c < "$bin_file") / 4 ))
+        local optimized=$(( $(wc -c < "$optimized_file") / 4 ))
+
+        if [ $exit_code -ne 0 ] && [ $exit_code -ne 5 ]; then
+            echo "сборка с -O завершилась с кодом $exit_code"
+        elif expect_registers "$log_file" R3=0x000F R10=0x003C; then
+            if [ $optimized -ge $plain ]; then
+                echo "сборка с -O: $optimized инструкций, без -O: $plain"
+            else
+                status=0
+            fi
+        fi
+    fi
+
+    rm -f "$log_file" "$optimized_file"
+    return $status
+}
+
+# 09: перемотанные счётные циклы учитывают все инструкции, как пошаговое выполнение
+check_counted_loop() {
+    expect_emulator_output "Program execution completed: 122347 instructions retired" "$1"
+}
+
+# 10: подготовка участков удаляет ровно две мёртвые записи (с -d итоги по всей программе)
+check_dead_writes() {
+    expect_emulator_output ", 2 dead writes eliminated" -d "$1"
+}
+
+# Проверки по имени теста; тесты без дополнительных проверок проходят
+run_test_checks() {
+    local test_name="$1"
+
+    case "$test_name" in
+        07_peephole_labels) check_peephole_labels "${test_name}.asm" "${test_name}.bin" ;;
+        09_counted_loop) check_counted_loop "${test_name}.bin" ;;
+        10_dead_writes) check_dead_writes "${test_name}.bin" ;;
+        *) return 0 ;;
+    esac
+}